@@ -0,0 +1,351 @@
+#include <benchmark/benchmark.h>
+
+#include <components/detournavigator/generatenavmeshtile.hpp>
+#include <components/detournavigator/gettilespositions.hpp>
+#include <components/detournavigator/navigatorimpl.hpp>
+#include <components/detournavigator/navigatorutils.hpp>
+#include <components/detournavigator/preparednavmeshdata.hpp>
+#include <components/detournavigator/recastmeshbuilder.hpp>
+#include <components/detournavigator/recastmeshprovider.hpp>
+#include <components/detournavigator/settingsutils.hpp>
+#include <components/detournavigator/tilecachedrecastmeshmanager.hpp>
+#include <components/esm3/loadland.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/misc/rng.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace DetourNavigator;
+
+    const std::string worldspace = "sys::default";
+    const osg::Vec3f agentHalfExtents(29, 29, 66);
+    constexpr float stepSize = 28.333332061767578125f;
+    constexpr int cellsPerSide = 2;
+    constexpr int cellSize = ESM::Land::REAL_SIZE;
+
+    Settings makeSettings()
+    {
+        Settings result;
+        result.mRecast.mBorderSize = 16;
+        result.mRecast.mCellHeight = 0.2f;
+        result.mRecast.mCellSize = 0.2f;
+        result.mRecast.mDetailSampleDist = 6;
+        result.mRecast.mDetailSampleMaxError = 1;
+        result.mRecast.mMaxClimb = 34;
+        result.mRecast.mMaxSimplificationError = 1.3f;
+        result.mRecast.mMaxSlope = 49;
+        result.mRecast.mRecastScaleFactor = 0.029411764705882353f;
+        result.mRecast.mSwimHeightScale = 0.89999997615814208984375f;
+        result.mRecast.mMaxEdgeLen = 12;
+        result.mRecast.mMaxVertsPerPoly = 6;
+        result.mRecast.mRegionMergeArea = 400;
+        result.mRecast.mRegionMinArea = 64;
+        result.mRecast.mTileSize = 128;
+        result.mDetour.mMaxNavMeshQueryNodes = 2048;
+        result.mDetour.mMaxPolygonPathSize = 1024;
+        result.mDetour.mMaxSmoothPathSize = 1024;
+        result.mDetour.mMaxPolys = 4096;
+        result.mDetour.mPathRefinementTiles = 3;
+        result.mWaitUntilMinDistanceToPlayer = std::numeric_limits<int>::max();
+        result.mAsyncNavMeshUpdaterThreads = 1;
+        result.mAsyncPathFinderThreads = 1;
+        result.mMaxNavMeshTilesCacheSize = 0;
+        result.mMaxTilesNumber = 1024;
+        result.mMinUpdateInterval = std::chrono::milliseconds(0);
+        result.mNavMeshVersion = 1;
+        return result;
+    }
+
+    /// Smooth hills to make navmesh tiles have some slopes and holes but be mostly connected
+    float getHeight(float x, float y)
+    {
+        return 300 * std::sin(x / 1500) * std::cos(y / 1100) + 100 * std::sin((x + y) / 400);
+    }
+
+    struct Landscape
+    {
+        osg::Vec2i mCellPosition;
+        std::vector<float> mHeights;
+        HeightfieldSurface mSurface;
+    };
+
+    /// Synthetic worldspace made of a square of landscape cells starting from the origin
+    std::vector<std::unique_ptr<Landscape>> makeLandscapes()
+    {
+        constexpr int size = ESM::Land::LAND_SIZE;
+        constexpr float step = static_cast<float>(cellSize) / (size - 1);
+        std::vector<std::unique_ptr<Landscape>> result;
+        for (int cellX = 0; cellX < cellsPerSide; ++cellX)
+        {
+            for (int cellY = 0; cellY < cellsPerSide; ++cellY)
+            {
+                auto landscape = std::make_unique<Landscape>();
+                landscape->mCellPosition = osg::Vec2i(cellX, cellY);
+                landscape->mHeights.reserve(size * size);
+                for (int y = 0; y < size; ++y)
+                    for (int x = 0; x < size; ++x)
+                        landscape->mHeights.push_back(getHeight(cellX * cellSize + x * step,
+                                                                cellY * cellSize + y * step));
+                const auto [min, max] = std::minmax_element(landscape->mHeights.begin(), landscape->mHeights.end());
+                landscape->mSurface.mHeights = landscape->mHeights.data();
+                landscape->mSurface.mSize = static_cast<std::size_t>(size);
+                landscape->mSurface.mMinHeight = *min;
+                landscape->mSurface.mMaxHeight = *max;
+                result.push_back(std::move(landscape));
+            }
+        }
+        return result;
+    }
+
+    const std::vector<std::unique_ptr<Landscape>>& getLandscapes()
+    {
+        static const std::vector<std::unique_ptr<Landscape>> landscapes = makeLandscapes();
+        return landscapes;
+    }
+
+    osg::Vec3f getWorldCenter()
+    {
+        const float center = cellsPerSide * cellSize / 2.0f;
+        return osg::Vec3f(center, center, getHeight(center, center));
+    }
+
+    template <class Random>
+    osg::Vec3f generatePosition(float maxDistance, Random& random)
+    {
+        const osg::Vec3f center = getWorldCenter();
+        std::uniform_real_distribution<float> distribution(-maxDistance, maxDistance);
+        const float x = center.x() + distribution(random);
+        const float y = center.y() + distribution(random);
+        return osg::Vec3f(x, y, getHeight(x, y));
+    }
+
+    std::unique_ptr<Navigator> makeNavigator(const Settings& settings)
+    {
+        auto navigator = std::make_unique<NavigatorImpl>(settings, nullptr);
+        navigator->addAgent(agentHalfExtents);
+        for (const auto& landscape : getLandscapes())
+            navigator->addHeightfield(landscape->mCellPosition, cellSize, landscape->mSurface);
+        return navigator;
+    }
+
+    void updateAndWait(Navigator& navigator)
+    {
+        Loading::Listener listener;
+        navigator.update(getWorldCenter());
+        navigator.wait(listener, WaitConditionType::allJobsDone);
+    }
+
+    /// Navigator with navmesh for the whole synthetic worldspace shared by query benchmarks
+    const Navigator& getNavigator()
+    {
+        static const std::unique_ptr<Navigator> navigator = []
+        {
+            auto result = makeNavigator(makeSettings());
+            updateAndWait(*result);
+            return result;
+        } ();
+        return *navigator;
+    }
+
+    struct PathEnds
+    {
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+    };
+
+    template <class Random>
+    std::vector<PathEnds> generatePathEnds(float maxDistance, std::size_t count, Random& random)
+    {
+        std::vector<PathEnds> result;
+        std::generate_n(std::back_inserter(result), count,
+            [&] { return PathEnds {generatePosition(maxDistance, random), generatePosition(maxDistance, random)}; });
+        return result;
+    }
+
+    constexpr std::size_t queriesCount = 128;
+
+    template <int maxDistance>
+    void findPath(benchmark::State& state)
+    {
+        const Navigator& navigator = getNavigator();
+        AreaCosts areaCosts;
+        std::minstd_rand random;
+        const std::vector<PathEnds> ends = generatePathEnds(maxDistance, queriesCount, random);
+        std::deque<osg::Vec3f> path;
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            const PathEnds& v = ends[n++ % ends.size()];
+            path.clear();
+            auto out = std::back_inserter(path);
+            const Status status = DetourNavigator::findPath(navigator, agentHalfExtents, stepSize, v.mStart, v.mEnd,
+                Flag_walk, areaCosts, 0, true, out);
+            benchmark::DoNotOptimize(status);
+        }
+    }
+
+    constexpr auto findPath_1k = findPath<1000>;
+    constexpr auto findPath_4k = findPath<4000>;
+    constexpr auto findPath_8k = findPath<8000>;
+
+    template <int maxRadius>
+    void findRandomPointAroundCircle(benchmark::State& state)
+    {
+        const Navigator& navigator = getNavigator();
+        std::minstd_rand random;
+        std::vector<osg::Vec3f> positions;
+        std::generate_n(std::back_inserter(positions), queriesCount, [&] { return generatePosition(4000, random); });
+        Misc::Rng::init(42);
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            const auto result = DetourNavigator::findRandomPointAroundCircle(navigator, agentHalfExtents,
+                positions[n++ % positions.size()], maxRadius, Flag_walk);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    constexpr auto findRandomPointAroundCircle_500 = findRandomPointAroundCircle<500>;
+    constexpr auto findRandomPointAroundCircle_2k = findRandomPointAroundCircle<2000>;
+
+    template <int maxDistance>
+    void raycast(benchmark::State& state)
+    {
+        const Navigator& navigator = getNavigator();
+        std::minstd_rand random;
+        const std::vector<PathEnds> ends = generatePathEnds(maxDistance, queriesCount, random);
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            const PathEnds& v = ends[n++ % ends.size()];
+            const auto result = DetourNavigator::raycast(navigator, agentHalfExtents, v.mStart, v.mEnd, Flag_walk);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    constexpr auto raycast_1k = raycast<1000>;
+    constexpr auto raycast_4k = raycast<4000>;
+
+    std::vector<TilePosition> getWorldTilesPositions(const RecastSettings& settings)
+    {
+        std::vector<TilePosition> result;
+        const float size = static_cast<float>(cellsPerSide * cellSize);
+        getTilesPositions(makeTilesPositionsRange(osg::Vec2f(0, 0), osg::Vec2f(size, size), settings),
+            [&] (const TilePosition& v) { result.push_back(v); });
+        return result;
+    }
+
+    void buildRecastMesh(benchmark::State& state)
+    {
+        const Settings settings = makeSettings();
+        const std::vector<TilePosition> tiles = getWorldTilesPositions(settings.mRecast);
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            const TilePosition& tilePosition = tiles[n++ % tiles.size()];
+            RecastMeshBuilder builder(makeRealTileBoundsWithBorder(settings.mRecast, tilePosition));
+            for (const auto& landscape : getLandscapes())
+                builder.addHeightfield(landscape->mCellPosition, cellSize, landscape->mSurface.mHeights,
+                    landscape->mSurface.mSize, landscape->mSurface.mMinHeight, landscape->mSurface.mMaxHeight);
+            const std::shared_ptr<RecastMesh> result = std::move(builder).create(0, 0);
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    struct DiscardNavMeshTileConsumer final : NavMeshTileConsumer
+    {
+        std::int64_t resolveMeshSource(const MeshSource& /*source*/) override { return 0; }
+
+        std::optional<NavMeshTileInfo> find(const std::string& /*worldspace*/, const TilePosition& /*tilePosition*/,
+            const std::vector<std::byte>& /*input*/) override
+        {
+            return std::nullopt;
+        }
+
+        void ignore(const std::string& /*worldspace*/, const TilePosition& /*tilePosition*/) override {}
+
+        void identity(const std::string& /*worldspace*/, const TilePosition& /*tilePosition*/,
+            std::int64_t /*tileId*/) override {}
+
+        void insert(const std::string& /*worldspace*/, const TilePosition& /*tilePosition*/,
+            std::int64_t /*version*/, const std::vector<std::byte>& /*input*/, PreparedNavMeshData& data) override
+        {
+            benchmark::DoNotOptimize(data);
+        }
+
+        void update(const std::string& /*worldspace*/, const TilePosition& /*tilePosition*/,
+            std::int64_t /*tileId*/, std::int64_t /*version*/, PreparedNavMeshData& data) override
+        {
+            benchmark::DoNotOptimize(data);
+        }
+
+        void cancel(std::string_view /*reason*/) override {}
+    };
+
+    void generateNavMeshTile(benchmark::State& state)
+    {
+        const Settings settings = makeSettings();
+        TileCachedRecastMeshManager recastMeshManager(settings.mRecast);
+        recastMeshManager.setWorldspace(worldspace);
+        for (const auto& landscape : getLandscapes())
+            recastMeshManager.addHeightfield(landscape->mCellPosition, cellSize, landscape->mSurface);
+        const std::vector<TilePosition> tiles = getWorldTilesPositions(settings.mRecast);
+        const auto consumer = std::make_shared<DiscardNavMeshTileConsumer>();
+        std::size_t n = 0;
+
+        while (state.KeepRunning())
+        {
+            GenerateNavMeshTile item(worldspace, tiles[n++ % tiles.size()], RecastMeshProvider(recastMeshManager),
+                agentHalfExtents, settings, consumer);
+            item.doWork();
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+    }
+
+    void updateNavMesh(benchmark::State& state)
+    {
+        Settings settings = makeSettings();
+        settings.mAsyncNavMeshUpdaterThreads = static_cast<std::size_t>(state.range(0));
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            std::unique_ptr<Navigator> navigator = makeNavigator(settings);
+            state.ResumeTiming();
+            updateAndWait(*navigator);
+            // Stopping the updater threads is not a part of the update
+            state.PauseTiming();
+            navigator.reset();
+            state.ResumeTiming();
+        }
+    }
+} // namespace
+
+BENCHMARK(findPath_1k);
+BENCHMARK(findPath_4k);
+BENCHMARK(findPath_8k);
+BENCHMARK(findRandomPointAroundCircle_500);
+BENCHMARK(findRandomPointAroundCircle_2k);
+BENCHMARK(raycast_1k);
+BENCHMARK(raycast_4k);
+BENCHMARK(buildRecastMesh);
+BENCHMARK(generateNavMeshTile);
+BENCHMARK(updateNavMesh)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -21,6 +21,8 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <random>
@@ -39,6 +41,7 @@ namespace NavMeshTool
         using DetourNavigator::ShapeId;
         using DetourNavigator::TileId;
         using DetourNavigator::TilePosition;
+        using DetourNavigator::TilesPositionsRange;
         using DetourNavigator::TileVersion;
         using Sqlite3::Transaction;
 
@@ -62,8 +65,9 @@ namespace NavMeshTool
         public:
             std::atomic_size_t mExpected {0};
 
-            explicit NavMeshTileConsumer(NavMeshDb&& db)
-                : mDb(std::move(db))
+            explicit NavMeshTileConsumer(NavMeshDb&& db, bool removeUnusedTiles)
+                : mRemoveUnusedTiles(removeUnusedTiles)
+                , mDb(std::move(db))
                 , mTransaction(mDb.startTransaction())
                 , mNextTileId(mDb.getMaxTileId() + 1)
                 , mNextShapeId(mDb.getMaxShapeId() + 1)
@@ -75,6 +79,16 @@ namespace NavMeshTool
 
             std::size_t getUpdated() const { return mUpdated.load(); }
 
+            std::size_t getUnchanged() const { return mUnchanged.load(); }
+
+            std::size_t getFailed() const { return mFailed.load(); }
+
+            std::size_t getDeleted() const
+            {
+                const std::lock_guard lock(mMutex);
+                return mDeleted;
+            }
+
             std::int64_t resolveMeshSource(const MeshSource& source) override
             {
                 const std::lock_guard lock(mMutex);
@@ -96,32 +110,71 @@ namespace NavMeshTool
                 return result;
             }
 
-            void ignore() override { report(); }
+            void ignore(const std::string& worldspace, const TilePosition& tilePosition) override
+            {
+                if (mRemoveUnusedTiles)
+                {
+                    std::lock_guard lock(mMutex);
+                    mDeleted += static_cast<std::size_t>(mDb.deleteTilesAt(worldspace, tilePosition));
+                }
+                report();
+            }
+
+            void identity(const std::string& worldspace, const TilePosition& tilePosition,
+                std::int64_t tileId) override
+            {
+                if (mRemoveUnusedTiles)
+                {
+                    std::lock_guard lock(mMutex);
+                    mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId {tileId}));
+                }
+                ++mUnchanged;
+                report();
+            }
 
             void insert(const std::string& worldspace, const TilePosition& tilePosition, std::int64_t version,
                 const std::vector<std::byte>& input, PreparedNavMeshData& data) override
             {
-                data.mUserId = static_cast<unsigned>(mNextTileId);
                 {
                     std::lock_guard lock(mMutex);
-                    mDb.insertTile(mNextTileId, worldspace, tilePosition, TileVersion {version}, input, serialize(data));
+                    const TileId tileId = mNextTileId;
+                    data.mUserId = static_cast<unsigned>(tileId);
+                    mDb.insertTile(tileId, worldspace, tilePosition, TileVersion {version}, input, serialize(data));
                     ++mNextTileId.t;
+                    if (mRemoveUnusedTiles)
+                        mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, tileId));
                 }
                 ++mInserted;
                 report();
             }
 
-            void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) override
+            void update(const std::string& worldspace, const TilePosition& tilePosition,
+                std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) override
             {
                 data.mUserId = static_cast<unsigned>(tileId);
                 {
                     std::lock_guard lock(mMutex);
                     mDb.updateTile(TileId {tileId}, TileVersion {version}, serialize(data));
+                    if (mRemoveUnusedTiles)
+                        mDeleted += static_cast<std::size_t>(mDb.deleteTilesAtExcept(worldspace, tilePosition, TileId {tileId}));
                 }
                 ++mUpdated;
                 report();
             }
 
+            void cancel(std::string_view /*reason*/) override
+            {
+                // Stored tiles are kept because the failure can be transient.
+                ++mFailed;
+                report();
+            }
+
+            void deleteTilesOutsideRange(const std::string& worldspace, const TilesPositionsRange& range)
+            {
+                const std::lock_guard lock(mMutex);
+                mDeleted += static_cast<std::size_t>(mDb.deleteTilesOutsideRange(worldspace, range));
+            }
+
             void wait()
             {
                 constexpr std::size_t tilesPerTransaction = 3000;
@@ -144,7 +197,11 @@ namespace NavMeshTool
             std::atomic_size_t mProvided {0};
             std::atomic_size_t mInserted {0};
             std::atomic_size_t mUpdated {0};
-            std::mutex mMutex;
+            std::atomic_size_t mUnchanged {0};
+            std::atomic_size_t mFailed {0};
+            const bool mRemoveUnusedTiles;
+            std::size_t mDeleted = 0;
+            mutable std::mutex mMutex;
             NavMeshDb mDb;
             Transaction mTransaction;
             TileId mNextTileId;
@@ -162,28 +219,32 @@ namespace NavMeshTool
     }
 
     void generateAllNavMeshTiles(const osg::Vec3f& agentHalfExtents, const Settings& settings,
-        const std::size_t threadsNumber, WorldspaceData& data, NavMeshDb&& db)
+        const std::size_t threadsNumber, const bool removeUnusedTiles, WorldspaceData& data, NavMeshDb&& db)
     {
         Log(Debug::Info) << "Generating navmesh tiles by " << threadsNumber << " parallel workers...";
 
         SceneUtil::WorkQueue workQueue(threadsNumber);
-        auto navMeshTileConsumer = std::make_shared<NavMeshTileConsumer>(std::move(db));
+        auto navMeshTileConsumer = std::make_shared<NavMeshTileConsumer>(std::move(db), removeUnusedTiles);
         std::size_t tiles = 0;
         std::mt19937_64 random;
+        std::vector<std::pair<std::string, TilesPositionsRange>> ranges;
 
         for (const std::unique_ptr<WorldspaceNavMeshInput>& input : data.mNavMeshInputs)
         {
             std::vector<TilePosition> worldspaceTiles;
 
-            DetourNavigator::getTilesPositions(
-                DetourNavigator::makeTilesPositionsRange(
-                    Misc::Convert::toOsgXY(input->mAabb.m_min),
-                    Misc::Convert::toOsgXY(input->mAabb.m_max),
-                    settings.mRecast
-                ),
-                [&] (const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); }
+            const TilesPositionsRange range = DetourNavigator::makeTilesPositionsRange(
+                Misc::Convert::toOsgXY(input->mAabb.m_min),
+                Misc::Convert::toOsgXY(input->mAabb.m_max),
+                settings.mRecast
             );
 
+            DetourNavigator::getTilesPositions(range,
+                [&] (const TilePosition& tilePosition) { worldspaceTiles.push_back(tilePosition); });
+
+            if (removeUnusedTiles)
+                ranges.emplace_back(input->mWorldspace, range);
+
             tiles += worldspaceTiles.size();
 
             navMeshTileConsumer->mExpected = tiles;
@@ -202,10 +263,17 @@ namespace NavMeshTool
         }
 
         navMeshTileConsumer->wait();
+
+        for (const auto& [worldspace, range] : ranges)
+            navMeshTileConsumer->deleteTilesOutsideRange(worldspace, range);
+
         navMeshTileConsumer->commit();
 
         Log(Debug::Info) << "Generated navmesh for " << navMeshTileConsumer->getProvided() << " tiles, "
-            << navMeshTileConsumer->getInserted() << " are inserted and "
-            << navMeshTileConsumer->getUpdated() << " updated";
+            << navMeshTileConsumer->getInserted() << " are inserted, "
+            << navMeshTileConsumer->getUpdated() << " updated, "
+            << navMeshTileConsumer->getUnchanged() << " unchanged, "
+            << navMeshTileConsumer->getFailed() << " failed and "
+            << navMeshTileConsumer->getDeleted() << " deleted";
     }
 }
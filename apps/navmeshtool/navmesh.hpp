@@ -17,7 +17,8 @@ namespace NavMeshTool
     struct WorldspaceData;
 
     void generateAllNavMeshTiles(const osg::Vec3f& agentHalfExtents, const DetourNavigator::Settings& settings,
-        const std::size_t threadsNumber, WorldspaceData& cellsData, DetourNavigator::NavMeshDb&& db);
+        const std::size_t threadsNumber, bool removeUnusedTiles, WorldspaceData& cellsData,
+        DetourNavigator::NavMeshDb&& db);
 }
 
 #endif
@@ -0,0 +1,138 @@
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+
+namespace OMW
+{
+    namespace
+    {
+        std::string_view trim(std::string_view value)
+        {
+            const std::size_t begin = value.find_first_not_of(" \t\r");
+            if (begin == std::string_view::npos)
+                return {};
+            const std::size_t end = value.find_last_not_of(" \t\r");
+            return value.substr(begin, end - begin + 1);
+        }
+
+        void writeCsvValue(std::ostream& stream, std::string_view value)
+        {
+            if (value.find_first_of(",\"\n") == std::string_view::npos)
+            {
+                stream << value;
+                return;
+            }
+            stream << '"';
+            for (const char c : value)
+            {
+                if (c == '"')
+                    stream << '"';
+                stream << c;
+            }
+            stream << '"';
+        }
+    }
+
+    Benchmark Benchmark::parse(std::istream& stream)
+    {
+        Benchmark result;
+        std::optional<unsigned> endFrame;
+        std::string line;
+        for (std::size_t lineNumber = 1; std::getline(stream, line); ++lineNumber)
+        {
+            const std::string_view content = trim(line);
+            if (content.empty() || content.front() == '#')
+                continue;
+            const std::size_t frameEnd = content.find_first_of(" \t");
+            const std::string frameText(content.substr(0, frameEnd));
+            const std::string_view command = frameEnd == std::string_view::npos
+                ? std::string_view() : trim(content.substr(frameEnd));
+            if (frameText.find_first_not_of("0123456789") != std::string::npos || frameText.size() > 9)
+                throw std::runtime_error("Invalid frame number at benchmark line " + std::to_string(lineNumber));
+            if (command.empty())
+                throw std::runtime_error("Missing console command at benchmark line " + std::to_string(lineNumber));
+            const unsigned frame = static_cast<unsigned>(std::stoul(frameText));
+            if (command == "end")
+                endFrame = std::min(frame, endFrame.value_or(frame));
+            else
+                result.mCommands.push_back(Command {frame, std::string(command)});
+        }
+        std::stable_sort(result.mCommands.begin(), result.mCommands.end(),
+            [] (const Command& l, const Command& r) { return l.mFrame < r.mFrame; });
+        if (endFrame.has_value())
+            result.mEndFrame = *endFrame;
+        else if (!result.mCommands.empty())
+            result.mEndFrame = result.mCommands.back().mFrame + 1;
+        return result;
+    }
+
+    Benchmark Benchmark::load(const std::string& path)
+    {
+        std::ifstream stream(path);
+        if (!stream.is_open())
+            throw std::runtime_error("Failed to open benchmark file: " + path);
+        return parse(stream);
+    }
+
+    std::vector<std::string> Benchmark::getCommands(unsigned frame) const
+    {
+        const auto begin = std::lower_bound(mCommands.begin(), mCommands.end(), frame,
+            [] (const Command& command, unsigned value) { return command.mFrame < value; });
+        std::vector<std::string> result;
+        for (auto it = begin; it != mCommands.end() && it->mFrame == frame; ++it)
+            result.push_back(it->mText);
+        return result;
+    }
+
+    Benchmark::Frame& Benchmark::getFrame(unsigned frame)
+    {
+        if (frame >= mFrames.size())
+            mFrames.resize(frame + 1);
+        return mFrames[frame];
+    }
+
+    void Benchmark::setFrameDuration(unsigned frame, double duration)
+    {
+        getFrame(frame).mDuration = duration;
+    }
+
+    void Benchmark::setFrameAttributes(unsigned frame, const Attributes& attributes)
+    {
+        getFrame(frame).mAttributes = attributes;
+    }
+
+    void Benchmark::writeCsv(std::ostream& stream) const
+    {
+        std::set<std::string> names;
+        for (const Frame& frame : mFrames)
+            for (const auto& attribute : frame.mAttributes)
+                names.insert(attribute.first);
+
+        stream << "frame,duration";
+        for (const std::string& name : names)
+        {
+            stream << ',';
+            writeCsvValue(stream, name);
+        }
+        stream << '\n';
+
+        for (std::size_t i = 0; i < mFrames.size(); ++i)
+        {
+            const Frame& frame = mFrames[i];
+            stream << i << ',' << frame.mDuration;
+            for (const std::string& name : names)
+            {
+                stream << ',';
+                const auto it = frame.mAttributes.find(name);
+                if (it != frame.mAttributes.end())
+                    stream << it->second;
+            }
+            stream << '\n';
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef APPS_OPENMW_BENCHMARK_H
+#define APPS_OPENMW_BENCHMARK_H
+
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace OMW
+{
+    /// @brief Replays console commands at given frames and collects per frame stats.
+    /// Every line of a benchmark script that is not empty and not a comment starting with '#' has format
+    /// "<frame> <console command>". Command "end" finishes the benchmark at its frame, otherwise the benchmark
+    /// finishes after the frame of the last command.
+    class Benchmark
+    {
+    public:
+        using Attributes = std::map<std::string, double>;
+
+        struct Command
+        {
+            unsigned mFrame;
+            std::string mText;
+        };
+
+        /// Throws std::runtime_error on syntax error.
+        static Benchmark parse(std::istream& stream);
+
+        static Benchmark load(const std::string& path);
+
+        const std::vector<Command>& getCommands() const { return mCommands; }
+
+        /// Console commands to execute before the given frame, in the order of the script.
+        std::vector<std::string> getCommands(unsigned frame) const;
+
+        unsigned getEndFrame() const { return mEndFrame; }
+
+        bool isFinished(unsigned frame) const { return frame >= mEndFrame; }
+
+        /// @param duration real time spent on the frame in seconds.
+        void setFrameDuration(unsigned frame, double duration);
+
+        void setFrameAttributes(unsigned frame, const Attributes& attributes);
+
+        /// Writes a row per frame. Columns are the frame, its duration and all collected attributes ordered by
+        /// name. A cell is empty if the attribute is missing for the frame.
+        void writeCsv(std::ostream& stream) const;
+
+    private:
+        struct Frame
+        {
+            double mDuration = 0;
+            Attributes mAttributes;
+        };
+
+        Frame& getFrame(unsigned frame);
+
+        std::vector<Command> mCommands;  // ordered by frame
+        unsigned mEndFrame = 0;
+        std::vector<Frame> mFrames;
+    };
+}
+
+#endif
@@ -2,6 +2,9 @@
 
 #include <iomanip>
 #include <chrono>
+#include <deque>
+#include <fstream>
+#include <optional>
 #include <thread>
 
 #include <boost/filesystem/fstream.hpp>
@@ -15,8 +18,10 @@
 
 #include <components/debug/debuglog.hpp>
 #include <components/debug/gldebug.hpp>
+#include <components/debug/tracerecorder.hpp>
 
 #include <components/misc/rng.hpp>
+#include <components/misc/taskscheduler.hpp>
 
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
@@ -40,6 +45,7 @@
 
 #include <components/sceneutil/screencapture.hpp>
 #include <components/sceneutil/depth.hpp>
+#include <components/sceneutil/riggeometry.hpp>
 #include <components/sceneutil/util.hpp>
 
 #include "mwinput/inputmanagerimp.hpp"
@@ -69,6 +75,8 @@
 
 #include "mwstate/statemanagerimp.hpp"
 
+#include "benchmark.hpp"
+
 namespace
 {
     void checkSDLError(int ret)
@@ -174,7 +182,8 @@ namespace
     {
         public:
             ScopedProfile(osg::Timer_t frameStart, unsigned int frameNumber, const osg::Timer& timer, osg::Stats& stats)
-                : mScopeStart(timer.tick()),
+                : mZone("Engine", UserStatsValue<sType>::sValue.mLabel.c_str()),
+                  mScopeStart(timer.tick()),
                   mFrameStart(frameStart),
                   mFrameNumber(frameNumber),
                   mTimer(timer),
@@ -198,6 +207,7 @@ namespace
             }
 
         private:
+            const Debug::TraceZone mZone;
             const osg::Timer_t mScopeStart;
             const osg::Timer_t mFrameStart;
             const unsigned int mFrameNumber;
@@ -255,16 +265,7 @@ namespace
 
 void OMW::Engine::executeLocalScripts()
 {
-    MWWorld::LocalScripts& localScripts = mEnvironment.getWorld()->getLocalScripts();
-
-    localScripts.startIteration();
-    std::pair<std::string, MWWorld::Ptr> script;
-    while (localScripts.getNext(script))
-    {
-        MWScript::InterpreterContext interpreterContext (
-            &script.second.getRefData().getLocals(), script.second);
-        mEnvironment.getScriptManager()->run (script.first, interpreterContext);
-    }
+    mEnvironment.getScriptManager()->runLocalScripts(mEnvironment.getWorld()->getLocalScripts());
 }
 
 bool OMW::Engine::frame(float frametime)
@@ -400,6 +401,12 @@ bool OMW::Engine::frame(float frametime)
 
             mEnvironment.reportStats(frameNumber, *stats);
         }
+
+        if (Debug::TraceRecorder& recorder = Debug::TraceRecorder::instance(); recorder.isEnabled())
+        {
+            recorder.recordCounter("Engine", "WorkQueue", mWorkQueue->getNumItems());
+            recorder.recordCounter("Engine", "WorkThread", mWorkQueue->getNumActiveThreads());
+        }
     }
     catch (const std::exception& e)
     {
@@ -423,6 +430,8 @@ OMW::Engine::Engine(Files::ConfigurationManager& configurationManager)
   , mGrab(true)
   , mExportFonts(false)
   , mRandomSeed(0)
+  , mBenchmarkTimestep(1.f / 60.f)
+  , mHeadless(false)
   , mScriptContext (nullptr)
   , mLuaManager (nullptr)
   , mFSStrict (false)
@@ -453,12 +462,19 @@ OMW::Engine::~Engine()
     delete mScriptContext;
     mScriptContext = nullptr;
 
+    // Rigs and work items that are destroyed with the viewer and the resource system may be used by tasks.
+    // The scheduler is stopped explicitly, since its last owner may be released from one of its own tasks.
+    if (mTaskScheduler != nullptr)
+        mTaskScheduler->stop();
     mWorkQueue = nullptr;
 
     mViewer = nullptr;
 
     mResourceSystem.reset();
 
+    SceneUtil::RigGeometry::setTaskScheduler(nullptr);
+    mTaskScheduler = nullptr;
+
     delete mEncoder;
     mEncoder = nullptr;
 
@@ -537,7 +553,8 @@ void OMW::Engine::createWindow(Settings::Manager& settings)
         pos_y = SDL_WINDOWPOS_UNDEFINED_DISPLAY(screen);
     }
 
-    Uint32 flags = SDL_WINDOW_OPENGL|SDL_WINDOW_SHOWN|SDL_WINDOW_RESIZABLE;
+    Uint32 flags = SDL_WINDOW_OPENGL|SDL_WINDOW_RESIZABLE;
+    flags |= mHeadless ? SDL_WINDOW_HIDDEN : SDL_WINDOW_SHOWN;
     if(fullscreen)
         flags |= SDL_WINDOW_FULLSCREEN;
 
@@ -692,10 +709,24 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
         Settings::Manager::getInt("anisotropy", "General")
     );
 
-    int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
-    if (numThreads <= 0)
-        throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
-    mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    const int schedulerThreads = Settings::Manager::getInt("task scheduler threads", "General");
+    if (schedulerThreads != 0)
+    {
+        const std::size_t count = schedulerThreads > 0
+            ? static_cast<std::size_t>(schedulerThreads) : Misc::TaskScheduler::getDefaultThreadsCount();
+        Log(Debug::Info) << "Using shared task scheduler with " << count << " threads";
+        mTaskScheduler = std::make_shared<Misc::TaskScheduler>(count);
+        mWorkQueue = new SceneUtil::WorkQueue(mTaskScheduler);
+        if (Settings::Manager::getBool("parallel skinning", "General"))
+            SceneUtil::RigGeometry::setTaskScheduler(mTaskScheduler.get());
+    }
+    else
+    {
+        int numThreads = Settings::Manager::getInt("preload num threads", "Cells");
+        if (numThreads <= 0)
+            throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
+        mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    }
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(
         mWorkQueue,
@@ -712,7 +743,8 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
 
     mViewer->addEventHandler(mScreenCaptureHandler);
 
-    auto luaMgr = std::make_unique<MWLua::LuaManager>(mVFS.get(), (mResDir / "lua_libs").string());
+    auto luaMgr = std::make_unique<MWLua::LuaManager>(mVFS.get(), (mResDir / "lua_libs").string(),
+        (mCfgMgr.getLogPath() / "lua_profiler.txt").string());
     mLuaManager = luaMgr.get();
     mEnvironment.setLuaManager(std::move(luaMgr));
 
@@ -791,6 +823,7 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
                 mScriptConsoleMode, mTranslationDataStorage, mEncoding, mExportFonts,
                 Version::getOpenmwVersionDescription(mResDir.string()), mCfgMgr.getUserConfigPath().string(), shadersSupported);
     auto* windowMgrInternal = windowMgr.get();
+    windowMgrInternal->setHeadless(mHeadless);
     mEnvironment.setWindowManager (std::move(windowMgr));
 
     auto inputMgr = std::make_unique<MWInput::InputManager>(mWindow, mViewer, mScreenCaptureHandler, mScreenCaptureOperation, keybinderUser, keybinderUserExists, userGameControllerdb, gameControllerdb, mGrab);
@@ -826,8 +859,23 @@ void OMW::Engine::prepareEngine (Settings::Manager & settings)
     mScriptContext = new MWScript::CompilerContext (MWScript::CompilerContext::Type_Full);
     mScriptContext->setExtensions (&mExtensions);
 
+    std::unique_ptr<MWScript::BytecodeCache> bytecodeCache;
+    if (Settings::Manager::getBool("cache compiled scripts", "Game"))
+    {
+        std::vector<std::string> contentFilePaths;
+        for (const std::string& file : mContentFiles)
+        {
+            const Files::MultiDirCollection& collection
+                = mFileCollections.getCollection(boost::filesystem::path(file).extension().string());
+            contentFilePaths.push_back(collection.doesExist(file) ? collection.getPath(file).string() : file);
+        }
+        bytecodeCache = std::make_unique<MWScript::BytecodeCache>((mCfgMgr.getUserDataPath() / "mwscript.cache").string(),
+            contentFilePaths, mExtensions.getHash());
+        bytecodeCache->load();
+    }
+
     mEnvironment.setScriptManager (std::make_unique<MWScript::ScriptManager>(mEnvironment.getWorld()->getStore(), *mScriptContext, mWarningsMode,
-        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>()));
+        mScriptBlacklistUse ? mScriptBlacklist : std::vector<std::string>(), std::move(bytecodeCache)));
 
     // Create game mechanics system
     mEnvironment.setMechanicsManager (std::make_unique<MWMechanics::MechanicsManager>());
@@ -918,6 +966,7 @@ private:
 
     void threadBody()
     {
+        Debug::TraceRecorder::instance().setThreadName("Lua");
         while (true)
         {
             std::unique_lock<std::mutex> lk(mMutex);
@@ -957,6 +1006,24 @@ void OMW::Engine::go()
     Settings::Manager settings;
     std::string settingspath = settings.load(mCfgMgr);
 
+    if (!mBenchmarkFile.empty())
+    {
+        // Work of these threads overlaps with frames depending on timing, so a benchmark does it in the main thread
+        // to simulate the same frames on every run. The changed settings are not saved.
+        Log(Debug::Info) << "Benchmark disables async physics, Lua worker thread and cell preloading";
+        Settings::Manager::setInt("async num threads", "Physics", 0);
+        Settings::Manager::setInt("lua num threads", "Lua", 0);
+        Settings::Manager::setBool("preload enabled", "Cells", false);
+    }
+
+    Debug::TraceRecorder::instance().setThreadName("Main");
+    const int traceEvents = Settings::Manager::getInt("trace events per thread", "General");
+    if (traceEvents > 0)
+    {
+        Debug::TraceRecorder::instance().start(static_cast<std::size_t>(traceEvents), mCfgMgr.getUserDataPath().string());
+        Log(Debug::Info) << "Trace recording is enabled, use 'savetrace' console command to write it to a file";
+    }
+
     MWClass::registerClasses();
 
     // Create encoder
@@ -1022,6 +1089,29 @@ void OMW::Engine::go()
         mEnvironment.getWindowManager()->executeInConsole(mStartupScript);
     }
 
+    std::optional<Benchmark> benchmark;
+    if (!mBenchmarkFile.empty())
+    {
+        benchmark = Benchmark::load(mBenchmarkFile);
+        Resource::CollectStatistics(mViewer);
+        Log(Debug::Info) << "Running benchmark " << mBenchmarkFile << " for " << benchmark->getEndFrame()
+                         << " frames with timestep " << mBenchmarkTimestep;
+    }
+    unsigned benchmarkFrame = 0;
+    // Benchmark frames and their viewer frame numbers which stats are not complete yet. They differ when frames are
+    // skipped or when the loading screen renders its own frames.
+    std::deque<std::pair<unsigned, unsigned>> benchmarkPendingFrames;
+    const auto recordBenchmarkFrameAttributes = [&] (unsigned frame, unsigned frameNumber)
+    {
+        Benchmark::Attributes attributes = mViewer->getViewerStats()->getAttributeMap(frameNumber);
+        if (osg::Stats* cameraStats = mViewer->getCamera()->getStats())
+        {
+            const osg::Stats::AttributeMap& cameraAttributes = cameraStats->getAttributeMap(frameNumber);
+            attributes.insert(cameraAttributes.begin(), cameraAttributes.end());
+        }
+        benchmark->setFrameAttributes(frame, attributes);
+    };
+
     LuaWorker luaWorker(this);  // starts a separate lua thread if "lua num threads" > 0
 
     // Start the main rendering loop
@@ -1030,7 +1120,19 @@ void OMW::Engine::go()
     const std::chrono::steady_clock::duration maxSimulationInterval(std::chrono::milliseconds(200));
     while (!mViewer->done() && !mEnvironment.getStateManager()->hasQuitRequest())
     {
-        const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(std::min(
+        const Debug::TraceZone frameZone("Engine", "Frame");
+        const auto frameStart = std::chrono::steady_clock::now();
+
+        if (benchmark)
+        {
+            if (benchmark->isFinished(benchmarkFrame))
+                break;
+            for (const std::string& command : benchmark->getCommands(benchmarkFrame))
+                mEnvironment.getWindowManager()->executeCommandInConsole(command);
+        }
+
+        // A benchmark uses fixed timestep to simulate the same frames on every run.
+        const double dt = benchmark ? mBenchmarkTimestep : std::chrono::duration_cast<std::chrono::duration<double>>(std::min(
             frameRateLimiter.getLastFrameDuration(),
             maxSimulationInterval
         )).count();
@@ -1051,7 +1153,8 @@ void OMW::Engine::go()
 
             luaWorker.allowUpdate();  // if there is a separate Lua thread, it starts the update now
 
-            mViewer->renderingTraversals();
+            if (!mHeadless)
+                mViewer->renderingTraversals();
 
             luaWorker.finishUpdate();
 
@@ -1073,13 +1176,45 @@ void OMW::Engine::go()
             }
         }
 
-        frameRateLimiter.limit();
+        if (benchmark)
+        {
+            benchmark->setFrameDuration(benchmarkFrame, std::chrono::duration_cast<std::chrono::duration<double>>(
+                std::chrono::steady_clock::now() - frameStart).count());
+            // Stats of a frame are complete when the draw traversal of the next frames has started.
+            const auto frameNumber = mViewer->getFrameStamp()->getFrameNumber();
+            benchmarkPendingFrames.emplace_back(benchmarkFrame, frameNumber);
+            while (!benchmarkPendingFrames.empty() && benchmarkPendingFrames.front().second + 2 <= frameNumber)
+            {
+                recordBenchmarkFrameAttributes(benchmarkPendingFrames.front().first, benchmarkPendingFrames.front().second);
+                benchmarkPendingFrames.pop_front();
+            }
+            ++benchmarkFrame;
+        }
+        else
+            frameRateLimiter.limit();
     }
 
     luaWorker.join();
 
-    // Save user settings
-    settings.saveUser(settingspath);
+    if (benchmark)
+    {
+        // Stats of the last frames are complete when the draw threads are finished
+        mViewer->stopThreading();
+        for (const auto& [frame, frameNumber] : benchmarkPendingFrames)
+            recordBenchmarkFrameAttributes(frame, frameNumber);
+
+        const std::string output = mBenchmarkOutput.empty() ? "benchmark.csv" : mBenchmarkOutput;
+        std::ofstream file(output);
+        benchmark->writeCsv(file);
+        if (file)
+            Log(Debug::Info) << "Benchmark stats are written to " << output;
+        else
+            Log(Debug::Error) << "Failed to write benchmark stats to " << output;
+    }
+
+    // Save user settings, a benchmark doesn't change them but overrides some of them
+    if (!benchmark)
+        settings.saveUser(settingspath);
     mLuaManager->savePermanentStorage(mCfgMgr.getUserConfigPath().string());
 
     Log(Debug::Info) << "Quitting peacefully.";
@@ -1149,3 +1284,15 @@ void OMW::Engine::setRandomSeed(unsigned int seed)
 {
     mRandomSeed = seed;
 }
+
+void OMW::Engine::setBenchmark(const std::string& file, const std::string& output, float timestep)
+{
+    mBenchmarkFile = file;
+    mBenchmarkOutput = output;
+    mBenchmarkTimestep = timestep;
+}
+
+void OMW::Engine::setHeadless(bool headless)
+{
+    mHeadless = headless;
+}
@@ -18,6 +18,11 @@ namespace Resource
     class ResourceSystem;
 }
 
+namespace Misc
+{
+    class TaskScheduler;
+}
+
 namespace SceneUtil
 {
     class WorkQueue;
@@ -59,6 +64,7 @@ namespace OMW
             SDL_Window* mWindow;
             std::unique_ptr<VFS::Manager> mVFS;
             std::unique_ptr<Resource::ResourceSystem> mResourceSystem;
+            std::shared_ptr<Misc::TaskScheduler> mTaskScheduler;
             osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
             MWBase::Environment mEnvironment;
             ToUTF8::FromType mEncoding;
@@ -88,6 +94,11 @@ namespace OMW
             bool mExportFonts;
             unsigned int mRandomSeed;
 
+            std::string mBenchmarkFile;
+            std::string mBenchmarkOutput;
+            float mBenchmarkTimestep;
+            bool mHeadless;
+
             Compiler::Extensions mExtensions;
             Compiler::Context *mScriptContext;
 
@@ -191,6 +202,13 @@ namespace OMW
 
             void setRandomSeed(unsigned int seed);
 
+            /// Run the benchmark script from the file with the fixed timestep instead of the real time,
+            /// write per frame stats to the output file and quit. Empty file disables the benchmark.
+            void setBenchmark(const std::string& file, const std::string& output, float timestep);
+
+            /// Use a hidden window and skip rendering traversals.
+            void setHeadless(bool headless);
+
         private:
             Files::ConfigurationManager& mCfgMgr;
             class LuaWorker;
@@ -152,6 +152,10 @@ bool parseOptions (int argc, char** argv, OMW::Engine& engine, Files::Configurat
     engine.setActivationDistanceOverride (variables["activate-dist"].as<int>());
     engine.enableFontExport(variables["export-fonts"].as<bool>());
     engine.setRandomSeed(variables["random-seed"].as<unsigned int>());
+    engine.setBenchmark(variables["benchmark"].as<Files::MaybeQuotedPath>().string(),
+        variables["benchmark-output"].as<Files::MaybeQuotedPath>().string(),
+        variables["benchmark-timestep"].as<float>());
+    engine.setHeadless(variables["headless"].as<bool>());
 
     return true;
 }
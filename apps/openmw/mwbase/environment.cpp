@@ -193,4 +193,6 @@ void MWBase::Environment::reportStats(unsigned int frameNumber, osg::Stats& stat
 {
     mMechanicsManager->reportStats(frameNumber, stats);
     mWorld->reportStats(frameNumber, stats);
+    mScriptManager->reportStats(frameNumber, stats);
+    mLuaManager->reportStats(frameNumber, stats);
 }
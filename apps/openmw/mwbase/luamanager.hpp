@@ -1,9 +1,16 @@
 #ifndef GAME_MWBASE_LUAMANAGER_H
 #define GAME_MWBASE_LUAMANAGER_H
 
+#include <map>
+#include <string>
 #include <variant>
 #include <SDL_events.h>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     class Ptr;
@@ -81,6 +88,11 @@ namespace MWBase
 
         // Drops script cache and reloads all scripts. Calls `onSave` and `onLoad` for every script.
         virtual void reloadAllScripts() = 0;
+
+        // Writes memory usage and CPU time of every script to a file. Returns a message for the console.
+        virtual std::string dumpProfilerReport() const = 0;
+
+        virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
     };
 
 }
@@ -3,6 +3,11 @@
 
 #include <string>
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace Interpreter
 {
     class Context;
@@ -19,6 +24,11 @@ namespace MWScript
     class GlobalScripts;
 }
 
+namespace MWWorld
+{
+    class LocalScripts;
+}
+
 namespace MWBase
 {
     /// \brief Interface for script manager (implemented in MWScript)
@@ -41,6 +51,10 @@ namespace MWBase
             virtual bool run (const std::string& name, Interpreter::Context& interpreterContext) = 0;
             ///< Run the script with the given name (compile first, if not compiled yet)
 
+            virtual void runLocalScripts (MWWorld::LocalScripts& localScripts) = 0;
+            ///< Run all active local scripts. Scripts that do not depend on the frame duration or on
+            /// single frame events may be deferred to later frames when the frame budget is exceeded.
+
             virtual bool compile (const std::string& name) = 0;
             ///< Compile script with the given namen
             /// \return Success?
@@ -55,6 +69,11 @@ namespace MWBase
             virtual MWScript::GlobalScripts& getGlobalScripts() = 0;
 
             virtual const Compiler::Extensions& getExtensions() const = 0;
+
+            virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
+
+            virtual std::string dumpLocalScriptsProfile() const = 0;
+            ///< Return the slowest local script of the last frame and local scripts with the highest total time.
    };
 }
 
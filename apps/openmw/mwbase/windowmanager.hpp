@@ -257,6 +257,8 @@ namespace MWBase
 
             virtual void executeInConsole (const std::string& path) = 0;
 
+            virtual void executeCommandInConsole (const std::string& command) = 0;
+
             virtual void enableRest() = 0;
             virtual bool getRestEnabled() = 0;
             virtual bool getJournalAllowed() = 0; 
@@ -148,11 +148,10 @@ bool MWDialogue::Filter::testPlayer (const ESM::DialInfo& info) const
     return true;
 }
 
-bool MWDialogue::Filter::testSelectStructs (const ESM::DialInfo& info) const
+bool MWDialogue::Filter::testSelectStructs (const std::vector<SelectWrapper>& selects) const
 {
-    for (std::vector<ESM::DialInfo::SelectStruct>::const_iterator iter (info.mSelects.begin());
-        iter != info.mSelects.end(); ++iter)
-        if (!testSelectStruct (*iter))
+    for (const SelectWrapper& select : selects)
+        if (!testSelectStruct (select))
             return false;
 
     return true;
@@ -614,7 +613,18 @@ bool MWDialogue::Filter::hasFactionRankReputationRequirements (const MWWorld::Pt
 
 MWDialogue::Filter::Filter (const MWWorld::Ptr& actor, int choice, bool talkedToPlayer)
 : mActor (actor), mChoice (choice), mTalkedToPlayer (talkedToPlayer)
-{}
+{
+    mSpeaker.mId = Misc::StringUtils::lowerCase (mActor.getCellRef().getRefId());
+    mSpeaker.mIsCreature = (mActor.getType() != ESM::NPC::sRecordId);
+
+    if (!mSpeaker.mIsCreature)
+    {
+        const ESM::NPC* npc = mActor.get<ESM::NPC>()->mBase;
+        mSpeaker.mClass = Misc::StringUtils::lowerCase (npc->mClass);
+        mSpeaker.mRace = Misc::StringUtils::lowerCase (npc->mRace);
+        mSpeaker.mFaction = Misc::StringUtils::lowerCase (mActor.getClass().getPrimaryFaction (mActor));
+    }
+}
 
 const ESM::DialInfo* MWDialogue::Filter::search (const ESM::Dialogue& dialogue, const bool fallbackToInfoRefusal) const
 {
@@ -644,39 +654,42 @@ std::vector<const ESM::DialInfo *> MWDialogue::Filter::list (const ESM::Dialogue
 
     bool infoRefusal = false;
 
-    // Iterate over topic responses to find a matching one
-    for (ESM::Dialogue::InfoContainer::const_iterator iter = dialogue.mInfo.begin();
-        iter!=dialogue.mInfo.end(); ++iter)
+    const MWWorld::Store<ESM::Dialogue> &dialogues =
+        MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
+
+    // Iterate over topic responses which may be said by the actor to find a matching one
+    dialogues.getInfoIndex (dialogue).forEachCandidate (mSpeaker, [&] (const InfoIndex::Entry& entry)
     {
-        if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter))
+        if (testActor (*entry.mInfo) && testPlayer (*entry.mInfo) && testSelectStructs (entry.mSelects))
         {
-            if (testDisposition (*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+            if (testDisposition (*entry.mInfo, invertDisposition)) {
+                infos.push_back(entry.mInfo);
                 if (!searchAll)
-                    break;
+                    return false;
             }
             else
                 infoRefusal = true;
         }
-    }
+        return true;
+    });
 
     if (infos.empty() && infoRefusal && fallbackToInfoRefusal)
     {
         // No response is valid because of low NPC disposition,
         // search a response in the topic "Info Refusal"
 
-        const MWWorld::Store<ESM::Dialogue> &dialogues =
-            MWBase::Environment::get().getWorld()->getStore().get<ESM::Dialogue>();
-
         const ESM::Dialogue& infoRefusalDialogue = *dialogues.find ("Info Refusal");
 
-        for (ESM::Dialogue::InfoContainer::const_iterator iter = infoRefusalDialogue.mInfo.begin();
-            iter!=infoRefusalDialogue.mInfo.end(); ++iter)
-            if (testActor (*iter) && testPlayer (*iter) && testSelectStructs (*iter) && testDisposition(*iter, invertDisposition)) {
-                infos.push_back(&*iter);
+        dialogues.getInfoIndex (infoRefusalDialogue).forEachCandidate (mSpeaker, [&] (const InfoIndex::Entry& entry)
+        {
+            if (testActor (*entry.mInfo) && testPlayer (*entry.mInfo) && testSelectStructs (entry.mSelects)
+                && testDisposition (*entry.mInfo, invertDisposition)) {
+                infos.push_back(entry.mInfo);
                 if (!searchAll)
-                    break;
+                    return false;
             }
+            return true;
+        });
     }
 
     return infos;
@@ -5,6 +5,8 @@
 
 #include "../mwworld/ptr.hpp"
 
+#include "infoindex.hpp"
+
 namespace ESM
 {
     struct DialInfo;
@@ -13,13 +15,12 @@ namespace ESM
 
 namespace MWDialogue
 {
-    class SelectWrapper;
-
     class Filter
     {
             MWWorld::Ptr mActor;
             int mChoice;
             bool mTalkedToPlayer;
+            InfoIndex::Speaker mSpeaker;
 
             bool testActor (const ESM::DialInfo& info) const;
             ///< Is this the right actor for this \a info?
@@ -27,7 +28,7 @@ namespace MWDialogue
             bool testPlayer (const ESM::DialInfo& info) const;
             ///< Do the player and the cell the player is currently in match \a info?
 
-            bool testSelectStructs (const ESM::DialInfo& info) const;
+            bool testSelectStructs (const std::vector<SelectWrapper>& selects) const;
             ///< Are all select structs matching?
 
             bool testDisposition (const ESM::DialInfo& info, bool invert=false) const;
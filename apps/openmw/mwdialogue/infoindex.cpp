@@ -0,0 +1,44 @@
+#include "infoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+#include <components/misc/stringops.hpp>
+
+MWDialogue::InfoIndex::InfoIndex (const ESM::Dialogue& dialogue)
+{
+    mEntries.reserve (dialogue.mInfo.size());
+
+    for (const ESM::DialInfo& info : dialogue.mInfo)
+    {
+        const std::size_t index = mEntries.size();
+
+        Entry& entry = mEntries.emplace_back();
+        entry.mInfo = &info;
+        entry.mSelects.reserve (info.mSelects.size());
+        for (const ESM::DialInfo::SelectStruct& select : info.mSelects)
+            entry.mSelects.emplace_back (select);
+
+        // An info may only match a speaker having all its static properties, one of them is enough to pick a bucket
+        if (!info.mActor.empty())
+            mByActor[Misc::StringUtils::lowerCase (info.mActor)].push_back (index);
+        else if (!info.mClass.empty())
+            mByClass[Misc::StringUtils::lowerCase (info.mClass)].push_back (index);
+        else if (!info.mRace.empty())
+            mByRace[Misc::StringUtils::lowerCase (info.mRace)].push_back (index);
+        else if (!info.mFactionLess && !info.mFaction.empty())
+            mByFaction[Misc::StringUtils::lowerCase (info.mFaction)].push_back (index);
+        else
+            mAny.push_back (index);
+    }
+}
+
+const MWDialogue::InfoIndex::Bucket* MWDialogue::InfoIndex::find (const Buckets& buckets, const std::string& key)
+{
+    if (key.empty())
+        return nullptr;
+
+    const auto it = buckets.find (key);
+    if (it == buckets.end())
+        return nullptr;
+
+    return &it->second;
+}
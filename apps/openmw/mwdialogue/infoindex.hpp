@@ -0,0 +1,103 @@
+#ifndef GAME_MWDIALOGUE_INFOINDEX_H
+#define GAME_MWDIALOGUE_INFOINDEX_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "selectwrapper.hpp"
+
+namespace ESM
+{
+    struct Dialogue;
+}
+
+namespace MWDialogue
+{
+    /// @brief Infos of a dialogue with decoded select structs, grouped by the most selective static condition on
+    /// the speaker (actor id, class, race, faction), so only infos which may match a speaker are tested.
+    /// Points to the infos of the dialogue, it has to be rebuilt when the dialogue changes.
+    class InfoIndex
+    {
+        public:
+
+            struct Entry
+            {
+                const ESM::DialInfo* mInfo;
+                std::vector<SelectWrapper> mSelects;
+            };
+
+            /// Lower case static properties of the speaker, empty when not applicable.
+            struct Speaker
+            {
+                std::string mId;
+                std::string mClass;
+                std::string mRace;
+                std::string mFaction;
+                bool mIsCreature = false;
+            };
+
+            explicit InfoIndex (const ESM::Dialogue& dialogue);
+
+            /// Calls \a function for infos which may match \a speaker in the order of the dialogue until it returns
+            /// false. Other speaker conditions still have to be tested.
+            template <class Function>
+            void forEachCandidate (const Speaker& speaker, Function&& function) const;
+
+            std::size_t getSize() const { return mEntries.size(); }
+
+        private:
+
+            using Bucket = std::vector<std::size_t>;
+            using Buckets = std::unordered_map<std::string, Bucket>;
+
+            std::vector<Entry> mEntries;
+            Buckets mByActor;
+            Buckets mByClass;
+            Buckets mByRace;
+            Buckets mByFaction;
+            Bucket mAny;
+
+            static const Bucket* find (const Buckets& buckets, const std::string& key);
+    };
+
+    template <class Function>
+    void InfoIndex::forEachCandidate (const Speaker& speaker, Function&& function) const
+    {
+        // Buckets are disjoint and sorted, merge them to keep the order of the dialogue
+        std::array<std::pair<Bucket::const_iterator, Bucket::const_iterator>, 5> ranges;
+        std::size_t count = 0;
+        const auto add = [&] (const Bucket* bucket)
+        {
+            if (bucket != nullptr && !bucket->empty())
+                ranges[count++] = {bucket->begin(), bucket->end()};
+        };
+
+        add (find (mByActor, speaker.mId));
+        // Creatures must not have topics aside of those specific to their id
+        if (!speaker.mIsCreature)
+        {
+            add (find (mByClass, speaker.mClass));
+            add (find (mByRace, speaker.mRace));
+            add (find (mByFaction, speaker.mFaction));
+            add (&mAny);
+        }
+
+        while (true)
+        {
+            std::size_t next = count;
+            for (std::size_t i = 0; i < count; ++i)
+                if (ranges[i].first != ranges[i].second
+                    && (next == count || *ranges[i].first < *ranges[next].first))
+                    next = i;
+
+            if (next == count || !function (mEntries[*ranges[next].first++]))
+                return;
+        }
+    }
+}
+
+#endif
@@ -41,13 +41,18 @@ namespace
     }
 }
 
-MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::decodeFunction() const
+int MWDialogue::SelectWrapper::decodeIndex() const
 {
     int index = 0;
 
     std::istringstream (mSelect.mSelectRule.substr(2,2)) >> index;
 
-    switch (index)
+    return index;
+}
+
+MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::decodeIndexedFunction() const
+{
+    switch (decodeIndex())
     {
         case  0: return Function_RankLow;
         case  1: return Function_RankHigh;
@@ -94,15 +99,13 @@ MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::decodeFunction()
     return Function_False;
 }
 
-MWDialogue::SelectWrapper::SelectWrapper (const ESM::DialInfo::SelectStruct& select) : mSelect (select) {}
-
-MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::getFunction() const
+MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::decodeFunction() const
 {
     char type = mSelect.mSelectRule[1];
 
     switch (type)
     {
-        case '1': return decodeFunction();
+        case '1': return decodeIndexedFunction();
         case '2': return Function_Global;
         case '3': return Function_Local;
         case '4': return Function_Journal;
@@ -119,16 +122,12 @@ MWDialogue::SelectWrapper::Function MWDialogue::SelectWrapper::getFunction() con
     return Function_None;
 }
 
-int MWDialogue::SelectWrapper::getArgument() const
+int MWDialogue::SelectWrapper::decodeArgument() const
 {
     if (mSelect.mSelectRule[1]!='1')
         return 0;
 
-    int index = 0;
-
-    std::istringstream (mSelect.mSelectRule.substr(2,2)) >> index;
-
-    switch (index)
+    switch (decodeIndex())
     {
         // AI settings
         case 67: return 1;
@@ -184,7 +183,7 @@ int MWDialogue::SelectWrapper::getArgument() const
     return 0;
 }
 
-MWDialogue::SelectWrapper::Type MWDialogue::SelectWrapper::getType() const
+MWDialogue::SelectWrapper::Type MWDialogue::SelectWrapper::decodeType() const
 {
     static const Function integerFunctions[] =
     {
@@ -233,7 +232,7 @@ MWDialogue::SelectWrapper::Type MWDialogue::SelectWrapper::getType() const
         Function_None // end marker
     };
 
-    Function function = getFunction();
+    Function function = mFunction;
 
     for (int i=0; integerFunctions[i]!=Function_None; ++i)
         if (integerFunctions[i]==function)
@@ -254,7 +253,7 @@ MWDialogue::SelectWrapper::Type MWDialogue::SelectWrapper::getType() const
     return Type_None;
 }
 
-bool MWDialogue::SelectWrapper::isNpcOnly() const
+bool MWDialogue::SelectWrapper::decodeNpcOnly() const
 {
     static const Function functions[] =
     {
@@ -267,7 +266,7 @@ bool MWDialogue::SelectWrapper::isNpcOnly() const
         Function_None // end marker
     };
 
-    Function function = getFunction();
+    Function function = mFunction;
 
     for (int i=0; functions[i]!=Function_None; ++i)
         if (functions[i]==function)
@@ -276,6 +275,15 @@ bool MWDialogue::SelectWrapper::isNpcOnly() const
     return false;
 }
 
+MWDialogue::SelectWrapper::SelectWrapper (const ESM::DialInfo::SelectStruct& select)
+: mSelect (select)
+, mFunction (decodeFunction())
+, mArgument (decodeArgument())
+, mType (decodeType())
+, mNpcOnly (decodeNpcOnly())
+, mName (select.mSelectRule.size()>5 ? Misc::StringUtils::lowerCase (select.mSelectRule.substr (5)) : std::string())
+{}
+
 bool MWDialogue::SelectWrapper::selectCompare (int value) const
 {
     return selectCompareImp (mSelect, value);
@@ -290,8 +298,3 @@ bool MWDialogue::SelectWrapper::selectCompare (bool value) const
 {
     return selectCompareImp (mSelect, static_cast<int> (value));
 }
-
-std::string MWDialogue::SelectWrapper::getName() const
-{
-    return Misc::StringUtils::lowerCase (mSelect.mSelectRule.substr (5));
-}
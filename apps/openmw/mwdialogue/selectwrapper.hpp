@@ -1,14 +1,15 @@
 #ifndef GAME_MWDIALOGUE_SELECTWRAPPER_H
 #define GAME_MWDIALOGUE_SELECTWRAPPER_H
 
+#include <string>
+
 #include <components/esm3/loadinfo.hpp>
 
 namespace MWDialogue
 {
+    /// @brief Select struct of a dialogue info with its rule decoded once on construction.
     class SelectWrapper
     {
-            const ESM::DialInfo::SelectStruct& mSelect;
-
         public:
 
             enum Function
@@ -57,19 +58,36 @@ namespace MWDialogue
 
         private:
 
+            const ESM::DialInfo::SelectStruct& mSelect;
+            Function mFunction;
+            int mArgument;
+            Type mType;
+            bool mNpcOnly;
+            std::string mName;
+
+            int decodeIndex() const;
+
+            Function decodeIndexedFunction() const;
+
             Function decodeFunction() const;
 
+            int decodeArgument() const;
+
+            Type decodeType() const;
+
+            bool decodeNpcOnly() const;
+
         public:
 
             SelectWrapper (const ESM::DialInfo::SelectStruct& select);
 
-            Function getFunction() const;
+            Function getFunction() const { return mFunction; }
 
-            int getArgument() const;
+            int getArgument() const { return mArgument; }
 
-            Type getType() const;
+            Type getType() const { return mType; }
 
-            bool isNpcOnly() const;
+            bool isNpcOnly() const { return mNpcOnly; }
             ///< \attention Do not call any of the select functions for this select struct!
 
             bool selectCompare (int value) const;
@@ -78,7 +96,7 @@ namespace MWDialogue
 
             bool selectCompare (bool value) const;
 
-            std::string getName() const;
+            const std::string& getName() const { return mName; }
             ///< Return case-smashed name.
     };
 }
@@ -330,7 +330,7 @@ namespace MWGui
 
     void LoadingScreen::draw()
     {
-        if (mVisible && !needToDrawLoadingScreen())
+        if (mHeadless || (mVisible && !needToDrawLoadingScreen()))
             return;
 
         if (mShowWallpaper && mTimer.time_m() > mLastWallpaperChangeTime + 5000*1)
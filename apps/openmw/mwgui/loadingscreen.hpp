@@ -48,6 +48,9 @@ namespace MWGui
 
         double getTargetFrameRate() const;
 
+        /// Don't draw frames while loading, the progress is still tracked.
+        void setHeadless(bool headless) { mHeadless = headless; }
+
     private:
         void findSplashScreens();
         bool needToDrawLoadingScreen();
@@ -72,6 +75,7 @@ namespace MWGui
         size_t mProgress;
 
         bool mShowWallpaper;
+        bool mHeadless = false;
         float mOldIcoMin = 0.f;
         unsigned int mOldIcoMax = 0;
 
@@ -1380,6 +1380,11 @@ namespace MWGui
         mConsole->executeFile (path);
     }
 
+    void WindowManager::executeCommandInConsole (const std::string& command)
+    {
+        mConsole->execute (command);
+    }
+
     MWGui::InventoryWindow* WindowManager::getInventoryWindow() { return mInventoryWindow; }
     MWGui::CountDialog* WindowManager::getCountDialog() { return mCountDialog; }
     MWGui::ConfirmationDialog* WindowManager::getConfirmationDialog() { return mConfirmationDialog; }
@@ -1626,6 +1631,11 @@ namespace MWGui
         return mLoadingScreen;
     }
 
+    void WindowManager::setHeadless(bool headless)
+    {
+        mLoadingScreen->setHeadless(headless);
+    }
+
     bool WindowManager::getCursorVisible()
     {
         return mCursorVisible && mCursorActive;
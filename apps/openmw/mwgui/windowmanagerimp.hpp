@@ -146,6 +146,9 @@ namespace MWGui
 
     Loading::Listener* getLoadingScreen() override;
 
+    /// Skip frames the loading screen draws in the middle of the main loop frame.
+    void setHeadless(bool headless);
+
     /// @note This method will block until the video finishes playing
     /// (and will continually update the window while doing so)
     void playVideo(const std::string& name, bool allowSkipping) override;
@@ -298,6 +301,8 @@ namespace MWGui
 
     void executeInConsole (const std::string& path) override;
 
+    void executeCommandInConsole (const std::string& command) override;
+
     void enableRest() override { mRestAllowed = true; }
     bool getRestEnabled() override;
 
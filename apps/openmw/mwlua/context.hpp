@@ -1,6 +1,9 @@
 #ifndef MWLUA_CONTEXT_H
 #define MWLUA_CONTEXT_H
 
+#include <memory>
+#include <vector>
+
 #include "eventqueue.hpp"
 
 namespace LuaUtil
@@ -12,6 +15,7 @@ namespace LuaUtil
 
 namespace MWLua
 {
+    class Action;
     class LuaManager;
     class WorldView;
 
@@ -25,6 +29,7 @@ namespace MWLua
         WorldView* mWorldView;
         LocalEventQueue* mLocalEventQueue;
         GlobalEventQueue* mGlobalEventQueue;
+        std::vector<std::unique_ptr<Action>>* mActionQueue;
     };
 
 }
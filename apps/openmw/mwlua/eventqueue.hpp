@@ -16,7 +16,7 @@ namespace LuaUtil
 
 namespace sol
 {
-    class state;
+    class state_view;
 }
 
 namespace MWLua
@@ -35,7 +35,7 @@ namespace MWLua
     using GlobalEventQueue = std::vector<GlobalEvent>;
     using LocalEventQueue = std::vector<LocalEvent>;
 
-    void loadEvents(sol::state& lua, ESM::ESMReader& esm, GlobalEventQueue&, LocalEventQueue&,
+    void loadEvents(sol::state_view& lua, ESM::ESMReader& esm, GlobalEventQueue&, LocalEventQueue&,
                     const std::map<int, int>& contentFileMapping, const LuaUtil::UserdataSerializer* serializer);
     void saveEvents(ESM::ESMWriter& esm, const GlobalEventQueue&, const LocalEventQueue&);
 }
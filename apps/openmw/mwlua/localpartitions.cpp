@@ -0,0 +1,100 @@
+#include "localpartitions.hpp"
+
+namespace MWLua
+{
+
+    std::unique_lock<std::mutex> lockWorldAccess()
+    {
+        static std::mutex mutex;
+        return std::unique_lock<std::mutex>(mutex);
+    }
+
+    PartitionsRunner::PartitionsRunner(std::size_t partitionsCount, std::function<void(std::size_t)> update)
+        : mUpdate(std::move(update))
+        , mErrors(std::max<std::size_t>(partitionsCount, 1))
+    {
+        for (std::size_t i = 1; i < mErrors.size(); ++i)
+            mWorkers.emplace_back([this, i] { workerBody(i); });
+    }
+
+    PartitionsRunner::~PartitionsRunner()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+        }
+        mCV.notify_all();
+        for (std::thread& worker : mWorkers)
+            worker.join();
+    }
+
+    void PartitionsRunner::run()
+    {
+        if (mWorkers.empty())
+        {
+            mUpdate(0);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mGeneration;
+            mPending = mWorkers.size();
+        }
+        mCV.notify_all();
+
+        try
+        {
+            mUpdate(0);
+        }
+        catch (...)
+        {
+            mErrors[0] = std::current_exception();  // rethrown when the workers are finished
+        }
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCV.wait(lock, [&] { return mPending == 0; });
+        }
+
+        std::exception_ptr error;
+        for (std::exception_ptr& partitionError : mErrors)
+        {
+            if (error == nullptr)
+                error = partitionError;
+            partitionError = nullptr;
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    void PartitionsRunner::workerBody(std::size_t partitionIndex)
+    {
+        std::size_t generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCV.wait(lock, [&] { return mStop || mGeneration != generation; });
+                if (mStop)
+                    return;
+                generation = mGeneration;
+            }
+            try
+            {
+                mUpdate(partitionIndex);
+            }
+            catch (...)
+            {
+                mErrors[partitionIndex] = std::current_exception();
+            }
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                last = --mPending == 0;
+            }
+            if (last)
+                mCV.notify_all();
+        }
+    }
+
+}
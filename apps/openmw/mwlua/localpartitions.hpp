@@ -0,0 +1,105 @@
+#ifndef MWLUA_LOCALPARTITIONS_H
+#define MWLUA_LOCALPARTITIONS_H
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace MWLua
+{
+
+    // MWBase::World and physics are not thread safe, but local scripts of different partitions run at the same time.
+    // Every binding available to local scripts that calls them should hold this lock during the call.
+    std::unique_lock<std::mutex> lockWorldAccess();
+
+    // Calls `update(i)` for every partition i: partition 0 in the calling thread, the others in their own worker
+    // threads. `run` returns when all partitions are processed and rethrows the first exception (in the order of
+    // partitions) if there were any.
+    class PartitionsRunner
+    {
+    public:
+        PartitionsRunner(std::size_t partitionsCount, std::function<void(std::size_t)> update);
+        PartitionsRunner(const PartitionsRunner&) = delete;
+        ~PartitionsRunner();
+
+        std::size_t getPartitionsCount() const { return mErrors.size(); }
+
+        void run();
+
+    private:
+        void workerBody(std::size_t partitionIndex);
+
+        const std::function<void(std::size_t)> mUpdate;
+        std::vector<std::exception_ptr> mErrors;
+        std::vector<std::thread> mWorkers;
+        std::mutex mMutex;
+        std::condition_variable mCV;
+        std::size_t mGeneration = 0;
+        std::size_t mPending = 0;
+        bool mStop = false;
+    };
+
+    // Identifies a unit of work of local scripts (e.g. `onUpdate` of one object or one event) independently of
+    // the partition that processes it. Units are processed in the order of keys if there is only one partition.
+    using OutputKey = std::pair<unsigned, std::uint64_t>;  // (phase, ordinal)
+
+    // Output queues of a partition are split into segments, every segment is produced by one unit of work.
+    template <std::size_t queuesCount>
+    struct OutputSegment
+    {
+        OutputKey mKey;
+        std::size_t mPartition;
+        std::array<std::size_t, queuesCount> mBegin;
+        std::array<std::size_t, queuesCount> mEnd;
+    };
+
+    // Sorts segments of all partitions by key, so the merged output doesn't depend on the number of partitions
+    // and thread scheduling.
+    template <std::size_t queuesCount>
+    std::vector<const OutputSegment<queuesCount>*> sortOutputSegments(
+        const std::vector<const std::vector<OutputSegment<queuesCount>>*>& partitions)
+    {
+        std::vector<const OutputSegment<queuesCount>*> result;
+        for (const std::vector<OutputSegment<queuesCount>>* segments : partitions)
+            for (const OutputSegment<queuesCount>& segment : *segments)
+                result.push_back(&segment);
+        std::stable_sort(result.begin(), result.end(),
+            [] (const auto* lhs, const auto* rhs) { return lhs->mKey < rhs->mKey; });
+        return result;
+    }
+
+    // Moves elements produced by the sorted segments from `sources` (indexed by partition) to the end of `dst`.
+    // Segments of a partition may refer to `dst` itself, in this case they should start at `dstBase` or later.
+    // Every element of the sources (after `dstBase` for `dst`) should belong to a segment, other sources are cleared.
+    template <std::size_t queuesCount, class T>
+    void mergeOutput(const std::vector<const OutputSegment<queuesCount>*>& segments, std::size_t queueIndex,
+        const std::vector<std::vector<T>*>& sources, std::vector<T>& dst, std::size_t dstBase)
+    {
+        std::vector<T> dstTail(std::make_move_iterator(dst.begin() + dstBase), std::make_move_iterator(dst.end()));
+        dst.erase(dst.begin() + dstBase, dst.end());
+        for (const OutputSegment<queuesCount>* segment : segments)
+        {
+            std::vector<T>& source = *sources[segment->mPartition];
+            const std::size_t base = &source == &dst ? dstBase : 0;
+            std::vector<T>& from = &source == &dst ? dstTail : source;
+            std::move(from.begin() + (segment->mBegin[queueIndex] - base),
+                from.begin() + (segment->mEnd[queueIndex] - base), std::back_inserter(dst));
+        }
+        for (std::vector<T>* source : sources)
+        {
+            if (source != &dst)
+                source->clear();
+        }
+    }
+
+}
+
+#endif // MWLUA_LOCALPARTITIONS_H
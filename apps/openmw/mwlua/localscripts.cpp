@@ -66,7 +66,7 @@ namespace MWLua
                 else
                     eqp[slot] = value.as<std::string>();
             }
-            context.mLuaManager->addAction(std::make_unique<SetEquipmentAction>(context.mLua, obj.id(), std::move(eqp)));
+            context.mActionQueue->push_back(std::make_unique<SetEquipmentAction>(context.mLua, obj.id(), std::move(eqp)));
         };
 
         using AiPackage = MWMechanics::AiPackage;
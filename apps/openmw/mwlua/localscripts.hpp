@@ -23,6 +23,7 @@ namespace MWLua
         LocalScripts(LuaUtil::LuaState* lua, const LObject& obj, ESM::LuaScriptCfg::Flags autoStartMode);
 
         MWBase::LuaManager::ActorControls* getActorControls() { return &mData.mControls; }
+        ObjectId getObjectId() const { return mData.id(); }
 
         struct SelfObject : public LObject
         {
@@ -128,19 +128,7 @@ namespace MWLua
         api["activeActors"] = GObjectList{worldView->getActorsInScene()};
         api["selectObjects"] = [context](const Queries::Query& query)
         {
-            ObjectIdList list;
-            WorldView* worldView = context.mWorldView;
-            if (query.mQueryType == "activators")
-                list = worldView->getActivatorsInScene();
-            else if (query.mQueryType == "actors")
-                list = worldView->getActorsInScene();
-            else if (query.mQueryType == "containers")
-                list = worldView->getContainersInScene();
-            else if (query.mQueryType == "doors")
-                list = worldView->getDoorsInScene();
-            else if (query.mQueryType == "items")
-                list = worldView->getItemsInScene();
-            return GObjectList{selectObjectsFromList(query, list, context)};
+            return GObjectList{selectObjectsInScene(query, context)};
             // TODO: Use sqlite to search objects that are not in the scene
             // return GObjectList{worldView->selectObjects(query, false)};
         };
@@ -190,7 +178,10 @@ namespace MWLua
     sol::table initLocalStoragePackage(const Context& context, LuaUtil::LuaStorage* globalStorage)
     {
         sol::table res(context.mLua->sol(), sol::create);
-        res["globalSection"] = [globalStorage](std::string_view section) { return globalStorage->getReadOnlySection(section); };
+        res["globalSection"] = [globalStorage, L = context.mLua->sol().lua_state()](std::string_view section)
+        {
+            return globalStorage->getReadOnlySection(L, section);
+        };
         return LuaUtil::makeReadOnly(res);
     }
 
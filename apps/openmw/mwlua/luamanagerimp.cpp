@@ -1,6 +1,13 @@
 #include "luamanagerimp.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
 
@@ -26,11 +33,59 @@
 namespace MWLua
 {
 
-    LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& libsDir) : mLua(vfs, &mConfiguration), mI18n(vfs, &mLua)
+    namespace
+    {
+        LuaUtil::LuaStateSettings makeLuaStateSettings()
+        {
+            LuaUtil::LuaStateSettings result;
+            result.mProfiler = Settings::Manager::getBool("lua profiler", "Lua");
+            result.mScriptMemorySoftLimit = Settings::Manager::getInt64("script memory soft limit", "Lua");
+            result.mScriptMemoryHardLimit = Settings::Manager::getInt64("script memory hard limit", "Lua");
+            return result;
+        }
+
+        double toMilliseconds(std::chrono::steady_clock::duration value)
+        {
+            return std::chrono::duration<double, std::milli>(value).count();
+        }
+
+        std::size_t getLocalPartitionsCount()
+        {
+            return static_cast<std::size_t>(std::max(1, Settings::Manager::getInt("local scripts num threads", "Lua")));
+        }
+
+        // Depends only on RefNum, so the distribution of scripts between Lua states is the same in every session.
+        std::size_t getPartitionIndex(const MWWorld::Ptr& ptr, std::size_t partitionsCount)
+        {
+            const ObjectId& id = getId(ptr);
+            return (static_cast<std::size_t>(id.mIndex) * 31 + static_cast<std::size_t>(id.mContentFile))
+                % partitionsCount;
+        }
+    }
+
+    LuaManager::LocalState::LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf)
+        : mLua(vfs, conf, makeLuaStateSettings())
+        , mI18n(vfs, &mLua)
+    {
+    }
+
+    LuaManager::LuaManager(const VFS::Manager* vfs, const std::string& libsDir, const std::string& profilerReportPath)
+        : mProfilerReportPath(profilerReportPath)
+        , mLua(vfs, &mConfiguration, makeLuaStateSettings())
+        , mI18n(vfs, &mLua)
     {
         Log(Debug::Info) << "Lua version: " << LuaUtil::getLuaVersion();
         mLua.addInternalLibSearchPath(libsDir);
 
+        const std::size_t partitionsCount = getLocalPartitionsCount();
+        for (std::size_t i = 1; i < partitionsCount; ++i)
+        {
+            mLocalStates.push_back(std::make_unique<LocalState>(vfs, &mConfiguration));
+            mLocalStates.back()->mLua.addInternalLibSearchPath(libsDir);
+        }
+        if (partitionsCount > 1)
+            Log(Debug::Info) << "Local Lua scripts are distributed between " << partitionsCount << " Lua states";
+
         mGlobalSerializer = createUserdataSerializer(false, mWorldView.getObjectRegistry());
         mLocalSerializer = createUserdataSerializer(true, mWorldView.getObjectRegistry());
         mGlobalLoader = createUserdataSerializer(false, mWorldView.getObjectRegistry(), &mContentFileMapping);
@@ -39,6 +94,12 @@ namespace MWLua
         mGlobalScripts.setSerializer(mGlobalSerializer.get());
     }
 
+    LuaManager::~LuaManager()
+    {
+        // Stop the workers before destroying the partitions
+        mPartitionsRunner = nullptr;
+    }
+
     void LuaManager::initConfiguration()
     {
         mConfiguration.init(MWBase::Environment::get().getWorld()->getStore().getLuaScriptsCfg());
@@ -57,6 +118,7 @@ namespace MWLua
         context.mWorldView = &mWorldView;
         context.mLocalEventQueue = &mLocalEvents;
         context.mGlobalEventQueue = &mGlobalEvents;
+        context.mActionQueue = &mActionQueue;
         context.mSerializer = mGlobalSerializer.get();
 
         Context localContext = context;
@@ -85,16 +147,56 @@ namespace MWLua
         mCameraPackage = initCameraPackage(localContext);
         mUserInterfacePackage = initUserInterfacePackage(localContext);
         mInputPackage = initInputPackage(localContext);
-        mNearbyPackage = initNearbyPackage(localContext);
-        mLocalSettingsPackage = initGlobalSettingsPackage(localContext);
         mPlayerSettingsPackage = initPlayerSettingsPackage(localContext);
-        mLocalStoragePackage = initLocalStoragePackage(localContext, &mGlobalStorage);
         mPlayerStoragePackage = initPlayerStoragePackage(localContext, &mGlobalStorage, &mPlayerStorage);
 
+        mPartitions.resize(mLocalStates.size() + 1);
+        for (std::size_t i = 0; i < mPartitions.size(); ++i)
+        {
+            LocalPartition& partition = mPartitions[i];
+            partition.mState = i == 0 ? nullptr : mLocalStates[i - 1].get();
+            partition.mLua = i == 0 ? &mLua : &partition.mState->mLua;
+            initLocalPartition(partition, localContext);
+        }
+        mPartitionsRunner = std::make_unique<PartitionsRunner>(mPartitions.size(),
+            [this] (std::size_t i) { updatePartition(mPartitions[i]); });
+
         initConfiguration();
         mInitialized = true;
     }
 
+    void LuaManager::initLocalPartition(LocalPartition& partition, const Context& localContext)
+    {
+        Context context = localContext;
+        if (LocalState* state = partition.mState)
+        {
+            context.mLua = &state->mLua;
+            context.mI18n = &state->mI18n;
+            context.mLocalEventQueue = &state->mLocalEvents;
+            context.mGlobalEventQueue = &state->mGlobalEvents;
+            context.mActionQueue = &state->mActionQueue;
+
+            state->mI18n.init();
+            state->mI18n.setPreferredLanguages(mI18n.getPreferredLanguages());
+
+            initObjectBindingsForLocalScripts(context);
+            initCellBindingsForLocalScripts(context);
+            LocalScripts::initializeSelfPackage(context);
+            LuaUtil::LuaStorage::initLuaBindings(state->mLua.sol());
+
+            state->mLua.addCommonPackage("openmw.async", getAsyncPackageInitializer(context));
+            state->mLua.addCommonPackage("openmw.util", LuaUtil::initUtilPackage(state->mLua.sol()));
+            state->mLua.addCommonPackage("openmw.core", initCorePackage(context));
+            state->mLua.addCommonPackage("openmw.query", initQueryPackage(context));
+        }
+        partition.mNearbyPackage = initNearbyPackage(context);
+        partition.mLocalSettingsPackage = initGlobalSettingsPackage(context);
+        partition.mLocalStoragePackage = initLocalStoragePackage(context, &mGlobalStorage);
+        partition.mGlobalEvents = context.mGlobalEventQueue;
+        partition.mLocalEvents = context.mLocalEventQueue;
+        partition.mActionQueue = context.mActionQueue;
+    }
+
     void LuaManager::loadPermanentStorage(const std::string& userConfigPath)
     {
         auto globalPath = std::filesystem::path(userConfigPath) / "global_storage.bin";
@@ -118,6 +220,10 @@ namespace MWLua
         if (mPlayer.isEmpty())
             return;  // The game is not started yet.
 
+        mLua.resetFrameProfile();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            state->mLua.resetFrameProfile();
+
         float frameDuration = MWBase::Environment::get().getFrameDuration();
         ObjectRegistry* objectRegistry = mWorldView.getObjectRegistry();
 
@@ -137,39 +243,44 @@ namespace MWLua
         mGlobalEvents = std::vector<GlobalEvent>();
         mLocalEvents = std::vector<LocalEvent>();
 
+        mPartitionsUpdate.mProcessTimers = !mWorldView.isPaused();
+        mPartitionsUpdate.mFrameDuration = frameDuration;
         if (!mWorldView.isPaused())
         {  // Update time and process timers
             double simulationTime = mWorldView.getSimulationTime() + frameDuration;
             mWorldView.setSimulationTime(simulationTime);
             double gameTime = mWorldView.getGameTime();
+            mPartitionsUpdate.mSimulationTime = simulationTime;
+            mPartitionsUpdate.mGameTime = gameTime;
 
             mGlobalScripts.processTimers(simulationTime, gameTime);
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->processTimers(simulationTime, gameTime);
         }
 
         // Receive events
         for (GlobalEvent& e : globalEvents)
             mGlobalScripts.receiveEvent(e.mEventName, e.mEventData);
-        for (LocalEvent& e : localEvents)
+
+        // Run queued callbacks
+        for (CallbackWithData& c : mQueuedCallbacks)
+            c.mCallback(c.mArg);
+        mQueuedCallbacks.clear();
+
+        // Distribute local events and engine events between partitions.
+        // Every partition receives them in the original order.
+        for (std::size_t i = 0; i < localEvents.size(); ++i)
         {
+            LocalEvent& e = localEvents[i];
             LObject obj(e.mDest, objectRegistry);
             LocalScripts* scripts = obj.isValid() ? obj.ptr().getRefData().getLuaScripts() : nullptr;
             if (scripts)
-                scripts->receiveEvent(e.mEventName, e.mEventData);
+                getPartition(scripts).mEvents.emplace_back(scripts, std::move(e), i);
             else
                 Log(Debug::Debug) << "Ignored event " << e.mEventName << " to L" << idToString(e.mDest)
                                   << ". Object not found or has no attached scripts";
         }
-
-        // Run queued callbacks
-        for (CallbackWithData& c : mQueuedCallbacks)
-            c.mCallback(c.mArg);
-        mQueuedCallbacks.clear();
-
-        // Engine handlers in local scripts
-        for (const LocalEngineEvent& e : mLocalEngineEvents)
+        for (std::size_t i = 0; i < mLocalEngineEvents.size(); ++i)
         {
+            LocalEngineEvent& e = mLocalEngineEvents[i];
             LObject obj(e.mDest, objectRegistry);
             if (!obj.isValid())
             {
@@ -179,15 +290,12 @@ namespace MWLua
             }
             LocalScripts* scripts = obj.ptr().getRefData().getLuaScripts();
             if (scripts)
-                scripts->receiveEngineEvent(e.mEvent);
+                getPartition(scripts).mEngineEvents.emplace_back(scripts, std::move(e.mEvent), i);
         }
         mLocalEngineEvents.clear();
 
-        if (!mWorldView.isPaused())
-        {
-            for (LocalScripts* scripts : mActiveLocalScripts)
-                scripts->update(frameDuration);
-        }
+        // Timers, events, engine handlers, and `onUpdate` in local scripts
+        updatePartitions();
 
         // Engine handlers in global scripts
         if (mPlayerChanged)
@@ -215,6 +323,119 @@ namespace MWLua
             mGlobalScripts.update(frameDuration);
     }
 
+    template <class Function>
+    void LuaManager::recordOutput(LocalPartition& partition, OutputKey key, Function&& function)
+    {
+        const std::array<std::size_t, 3> begin {partition.mGlobalEvents->size(), partition.mLocalEvents->size(),
+            partition.mActionQueue->size()};
+        function();
+        const std::array<std::size_t, 3> end {partition.mGlobalEvents->size(), partition.mLocalEvents->size(),
+            partition.mActionQueue->size()};
+        if (begin != end)
+        {
+            const std::size_t partitionIndex = static_cast<std::size_t>(&partition - mPartitions.data());
+            partition.mOutputSegments.push_back({key, partitionIndex, begin, end});
+        }
+    }
+
+    void LuaManager::updatePartition(LocalPartition& partition)
+    {
+        // Output is split by object or by incoming event, so it can be merged in the same order as if
+        // all local scripts were processed by one thread.
+        enum Phase : unsigned
+        {
+            Phase_Timers,
+            Phase_Events,
+            Phase_EngineEvents,
+            Phase_Update,
+        };
+        const auto getObjectKey = [] (const LocalScripts* scripts)
+        {
+            const ObjectId id = scripts->getObjectId();
+            return static_cast<std::uint64_t>(static_cast<std::uint32_t>(id.mContentFile)) << 32 | id.mIndex;
+        };
+
+        const PartitionsUpdate& params = mPartitionsUpdate;
+        if (params.mProcessTimers)
+        {
+            for (LocalScripts* scripts : partition.mActiveScripts)
+                recordOutput(partition, {Phase_Timers, getObjectKey(scripts)},
+                    [&] { scripts->processTimers(params.mSimulationTime, params.mGameTime); });
+        }
+        for (auto& event : partition.mEvents)
+        {
+            LocalScripts* scripts = std::get<0>(event);
+            const LocalEvent& e = std::get<1>(event);
+            recordOutput(partition, {Phase_Events, std::get<2>(event)},
+                [&] { scripts->receiveEvent(e.mEventName, e.mEventData); });
+        }
+        partition.mEvents.clear();
+        for (auto& event : partition.mEngineEvents)
+        {
+            LocalScripts* scripts = std::get<0>(event);
+            const LocalScripts::EngineEvent& e = std::get<1>(event);
+            recordOutput(partition, {Phase_EngineEvents, std::get<2>(event)}, [&] { scripts->receiveEngineEvent(e); });
+        }
+        partition.mEngineEvents.clear();
+        if (params.mProcessTimers)
+        {
+            for (LocalScripts* scripts : partition.mActiveScripts)
+                recordOutput(partition, {Phase_Update, getObjectKey(scripts)},
+                    [&] { scripts->update(params.mFrameDuration); });
+        }
+    }
+
+    void LuaManager::updatePartitions()
+    {
+        // Output of local scripts produced outside of the update (e.g. by `onInit`) goes first
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            std::move(state->mGlobalEvents.begin(), state->mGlobalEvents.end(), std::back_inserter(mGlobalEvents));
+            std::move(state->mLocalEvents.begin(), state->mLocalEvents.end(), std::back_inserter(mLocalEvents));
+            std::move(state->mActionQueue.begin(), state->mActionQueue.end(), std::back_inserter(mActionQueue));
+            state->mGlobalEvents.clear();
+            state->mLocalEvents.clear();
+            state->mActionQueue.clear();
+        }
+
+        const std::size_t globalEventsBase = mGlobalEvents.size();
+        const std::size_t localEventsBase = mLocalEvents.size();
+        const std::size_t actionQueueBase = mActionQueue.size();
+
+        std::exception_ptr error;
+        try
+        {
+            mPartitionsRunner->run();
+        }
+        catch (...)
+        {
+            error = std::current_exception();  // rethrown when the output is merged
+        }
+
+        // Merge outputs in the order of keys, so the result doesn't depend on the number of partitions
+        // and thread scheduling.
+        std::vector<const std::vector<OutputSegment<3>>*> partitionsSegments;
+        std::vector<GlobalEventQueue*> globalEvents;
+        std::vector<LocalEventQueue*> localEvents;
+        std::vector<std::vector<std::unique_ptr<Action>>*> actionQueues;
+        for (const LocalPartition& partition : mPartitions)
+        {
+            partitionsSegments.push_back(&partition.mOutputSegments);
+            globalEvents.push_back(partition.mGlobalEvents);
+            localEvents.push_back(partition.mLocalEvents);
+            actionQueues.push_back(partition.mActionQueue);
+        }
+        const auto segments = sortOutputSegments(partitionsSegments);
+        mergeOutput(segments, 0, globalEvents, mGlobalEvents, globalEventsBase);
+        mergeOutput(segments, 1, localEvents, mLocalEvents, localEventsBase);
+        mergeOutput(segments, 2, actionQueues, mActionQueue, actionQueueBase);
+        for (LocalPartition& partition : mPartitions)
+            partition.mOutputSegments.clear();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
     void LuaManager::synchronizedUpdate()
     {
         if (mPlayer.isEmpty())
@@ -248,7 +469,12 @@ namespace MWLua
     void LuaManager::clear()
     {
         LuaUi::clearUserInterface();
-        mActiveLocalScripts.clear();
+        for (LocalPartition& partition : mPartitions)
+        {
+            partition.mActiveScripts.clear();
+            partition.mEvents.clear();
+            partition.mEngineEvents.clear();
+        }
         mLocalEvents.clear();
         mGlobalEvents.clear();
         mInputEvents.clear();
@@ -283,7 +509,7 @@ namespace MWLua
             localScripts = createLocalScripts(ptr, ESM::LuaScriptCfg::sPlayer);
             localScripts->addAutoStartedScripts();
         }
-        mActiveLocalScripts.insert(localScripts);
+        getPartition(localScripts).mActiveScripts.insert(localScripts);
         mLocalEngineEvents.push_back({getId(ptr), LocalScripts::OnActive{}});
         mPlayerChanged = true;
     }
@@ -319,7 +545,7 @@ namespace MWLua
         }
         if (localScripts)
         {
-            mActiveLocalScripts.insert(localScripts);
+            getPartition(localScripts).mActiveScripts.insert(localScripts);
             mLocalEngineEvents.push_back({getId(ptr), LocalScripts::OnActive{}});
         }
 
@@ -333,7 +559,7 @@ namespace MWLua
         LocalScripts* localScripts = ptr.getRefData().getLuaScripts();
         if (localScripts)
         {
-            mActiveLocalScripts.erase(localScripts);
+            getPartition(localScripts).mActiveScripts.erase(localScripts);
             if (!mWorldView.getObjectRegistry()->getPtr(getId(ptr), true).isEmpty())
                 mLocalEngineEvents.push_back({getId(ptr), LocalScripts::OnInactive{}});
         }
@@ -375,7 +601,7 @@ namespace MWLua
             localScripts = createLocalScripts(ptr, getLuaScriptFlag(ptr));
             localScripts->addAutoStartedScripts();
             if (ptr.isInCell() && MWBase::Environment::get().getWorld()->isCellActive(ptr.getCell()))
-                mActiveLocalScripts.insert(localScripts);
+                getPartition(localScripts).mActiveScripts.insert(localScripts);
         }
         localScripts->addCustomScript(scriptId);
     }
@@ -385,6 +611,7 @@ namespace MWLua
         assert(mInitialized);
         assert(flag != ESM::LuaScriptCfg::sGlobal);
         std::shared_ptr<LocalScripts> scripts;
+        LocalPartition* partition = &mPartitions[0];
         if (flag == ESM::LuaScriptCfg::sPlayer)
         {
             assert(ptr.getCellRef().getRefId() == "player");
@@ -397,11 +624,13 @@ namespace MWLua
         }
         else
         {
-            scripts = std::make_shared<LocalScripts>(&mLua, LObject(getId(ptr), mWorldView.getObjectRegistry()), flag);
-            scripts->addPackage("openmw.settings", mLocalSettingsPackage);
-            scripts->addPackage("openmw.storage", mLocalStoragePackage);
+            partition = &mPartitions[getPartitionIndex(ptr, mPartitions.size())];
+            scripts = std::make_shared<LocalScripts>(
+                partition->mLua, LObject(getId(ptr), mWorldView.getObjectRegistry()), flag);
+            scripts->addPackage("openmw.settings", partition->mLocalSettingsPackage);
+            scripts->addPackage("openmw.storage", partition->mLocalStoragePackage);
         }
-        scripts->addPackage("openmw.nearby", mNearbyPackage);
+        scripts->addPackage("openmw.nearby", partition->mNearbyPackage);
         scripts->setSerializer(mLocalSerializer.get());
 
         MWWorld::RefData& refData = ptr.getRefData();
@@ -409,6 +638,16 @@ namespace MWLua
         return refData.getLuaScripts();
     }
 
+    LuaManager::LocalPartition& LuaManager::getPartition(const LocalScripts* scripts)
+    {
+        for (LocalPartition& partition : mPartitions)
+        {
+            if (partition.mLua == scripts->getLuaState())
+                return partition;
+        }
+        throw std::logic_error("Local scripts use unknown Lua state");
+    }
+
     void LuaManager::write(ESM::ESMWriter& writer, Loading::Listener& progress)
     {
         writer.startRecord(ESM::REC_LUAM);
@@ -472,6 +711,8 @@ namespace MWLua
 
         LuaUi::clearUserInterface(); 
         mLua.dropScriptCache();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+            state->mLua.dropScriptCache();
         initConfiguration();
 
         {  // Reload global scripts
@@ -489,8 +730,98 @@ namespace MWLua
             scripts->save(data);
             scripts->load(data);
         }
-        for (LocalScripts* scripts : mActiveLocalScripts)
-            scripts->receiveEngineEvent(LocalScripts::OnActive());
+        for (const LocalPartition& partition : mPartitions)
+        {
+            for (LocalScripts* scripts : partition.mActiveScripts)
+                scripts->receiveEngineEvent(LocalScripts::OnActive());
+        }
+    }
+
+    std::vector<LuaUtil::ScriptProfile> LuaManager::getScriptsProfile() const
+    {
+        std::vector<LuaUtil::ScriptProfile> result = mLua.getScriptsProfile();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            const std::vector<LuaUtil::ScriptProfile>& profile = state->mLua.getScriptsProfile();
+            if (result.size() < profile.size())
+                result.resize(profile.size());
+            for (std::size_t i = 0; i < profile.size(); ++i)
+            {
+                LuaUtil::ScriptProfile& dst = result[i];
+                dst.mMemoryUsage += profile[i].mMemoryUsage;
+                dst.mFrameTime += profile[i].mFrameTime;
+                dst.mTotalTime += profile[i].mTotalTime;
+                for (const auto& [name, handler] : profile[i].mHandlers)
+                {
+                    LuaUtil::ScriptProfile::Handler& dstHandler = dst.mHandlers[name];
+                    dstHandler.mCalls += handler.mCalls;
+                    dstHandler.mTotalTime += handler.mTotalTime;
+                    dstHandler.mMaxTime = std::max(dstHandler.mMaxTime, handler.mMaxTime);
+                }
+            }
+        }
+        return result;
+    }
+
+    std::string LuaManager::dumpProfilerReport() const
+    {
+        if (!mLua.isProfilerEnabled())
+            return "Lua profiler is disabled; set 'lua profiler = true' in section [Lua] of settings.cfg";
+
+        const std::vector<LuaUtil::ScriptProfile> profile = getScriptsProfile();
+        std::vector<std::size_t> order;
+        for (std::size_t i = 0; i < profile.size(); ++i)
+            order.push_back(i);
+        std::sort(order.begin(), order.end(),
+            [&] (std::size_t lhs, std::size_t rhs) { return profile[lhs].mTotalTime > profile[rhs].mTotalTime; });
+
+        std::ofstream file(mProfilerReportPath);
+        if (!file)
+            return "Can't open " + mProfilerReportPath;
+        file << std::fixed << std::setprecision(3);
+        std::int64_t totalMemoryUsage = mLua.getTotalMemoryUsage();
+        std::int64_t smallAllocMemoryUsage = mLua.getSmallAllocMemoryUsage();
+        for (const std::unique_ptr<LocalState>& state : mLocalStates)
+        {
+            totalMemoryUsage += state->mLua.getTotalMemoryUsage();
+            smallAllocMemoryUsage += state->mLua.getSmallAllocMemoryUsage();
+        }
+        file << "Lua memory usage: " << totalMemoryUsage / 1024 << " KiB total, "
+             << smallAllocMemoryUsage / 1024 << " KiB in small allocations";
+        if (!mLocalStates.empty())
+            file << ", " << mLocalStates.size() + 1 << " Lua states";
+        file << "\n";
+        for (std::size_t scriptId : order)
+        {
+            const LuaUtil::ScriptProfile& script = profile[scriptId];
+            if (script.mHandlers.empty() && script.mMemoryUsage == 0)
+                continue;
+            const std::string& path = scriptId < mConfiguration.size() ? mConfiguration[scriptId].mScriptPath : "";
+            file << "\n#" << scriptId << " " << path << ": " << script.mMemoryUsage / 1024 << " KiB, "
+                 << toMilliseconds(script.mTotalTime) << " ms\n";
+            for (const auto& [name, handler] : script.mHandlers)
+                file << "    " << name << ": " << handler.mCalls << " calls, "
+                     << toMilliseconds(handler.mTotalTime) << " ms total, "
+                     << toMilliseconds(handler.mMaxTime) << " ms max\n";
+        }
+        return "Lua profiler report is written to " + mProfilerReportPath;
+    }
+
+    void LuaManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        if (mLua.hasCustomAllocator())
+        {
+            std::int64_t memoryUsage = mLua.getTotalMemoryUsage();
+            for (const std::unique_ptr<LocalState>& state : mLocalStates)
+                memoryUsage += state->mLua.getTotalMemoryUsage();
+            stats.setAttribute(frameNumber, "Lua Memory", static_cast<double>(memoryUsage / 1024));
+        }
+        if (!mLua.isProfilerEnabled())
+            return;
+        std::chrono::steady_clock::duration slowest{};
+        for (const LuaUtil::ScriptProfile& script : getScriptsProfile())
+            slowest = std::max(slowest, script.mFrameTime);
+        stats.setAttribute(frameNumber, "Lua Slowest", toMilliseconds(slowest));
     }
 
 }
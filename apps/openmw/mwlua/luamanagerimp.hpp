@@ -3,6 +3,7 @@
 
 #include <map>
 #include <set>
+#include <tuple>
 
 #include <components/lua/i18n.hpp>
 #include <components/lua/luastate.hpp>
@@ -14,6 +15,7 @@
 #include "object.hpp"
 #include "eventqueue.hpp"
 #include "globalscripts.hpp"
+#include "localpartitions.hpp"
 #include "localscripts.hpp"
 #include "playerscripts.hpp"
 #include "worldview.hpp"
@@ -24,7 +26,8 @@ namespace MWLua
     class LuaManager : public MWBase::LuaManager
     {
     public:
-        LuaManager(const VFS::Manager* vfs, const std::string& libsDir);
+        LuaManager(const VFS::Manager* vfs, const std::string& libsDir, const std::string& profilerReportPath);
+        ~LuaManager();
 
         // Called by engine.cpp when the environment is fully initialized.
         void init();
@@ -34,6 +37,8 @@ namespace MWLua
 
         // Called by engine.cpp every frame. For performance reasons it works in a separate
         // thread (in parallel with osg Cull). Can not use scene graph.
+        // If "local scripts num threads" > 1, local scripts of non-player objects are distributed
+        // between several Lua states and processed in parallel.
         void update();
 
         // Called by engine.cpp from the main thread. Can use scene graph.
@@ -58,7 +63,6 @@ namespace MWLua
 
         // Used only in Lua bindings
         void addCustomLocalScript(const MWWorld::Ptr&, int scriptId);
-        void addAction(std::unique_ptr<Action>&& action) { mActionQueue.push_back(std::move(action)); }
         void addTeleportPlayerAction(std::unique_ptr<TeleportAction>&& action) { mTeleportPlayerAction = std::move(action); }
         void addUIMessage(std::string_view message) { mUIMessages.emplace_back(message); }
 
@@ -74,6 +78,10 @@ namespace MWLua
         // Drops script cache and reloads all scripts. Calls `onSave` and `onLoad` for every script.
         void reloadAllScripts() override;
 
+        std::string dumpProfilerReport() const override;
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
         // Used to call Lua callbacks from C++
         void queueCallback(LuaUtil::Callback callback, sol::object arg)
         {
@@ -90,25 +98,67 @@ namespace MWLua
         }
 
     private:
+        // Additional Lua state for local scripts. Has its own queues, they are merged into
+        // the queues of LuaManager after every update.
+        struct LocalState
+        {
+            LocalState(const VFS::Manager* vfs, const LuaUtil::ScriptsConfiguration* conf);
+
+            LuaUtil::LuaState mLua;
+            LuaUtil::I18nManager mI18n;
+            GlobalEventQueue mGlobalEvents;
+            LocalEventQueue mLocalEvents;
+            std::vector<std::unique_ptr<Action>> mActionQueue;
+        };
+
+        // A group of local scripts that share a Lua state. Partition 0 uses `mLua` and contains the player.
+        struct LocalPartition
+        {
+            LuaUtil::LuaState* mLua;
+            LocalState* mState;  // nullptr for partition 0
+            sol::table mNearbyPackage;
+            sol::table mLocalSettingsPackage;
+            sol::table mLocalStoragePackage;
+            std::set<LocalScripts*> mActiveScripts;
+
+            // Filled by the main thread before processing the partition.
+            // The last element is the index of the event in the original queue.
+            std::vector<std::tuple<LocalScripts*, LocalEvent, std::size_t>> mEvents;
+            std::vector<std::tuple<LocalScripts*, LocalScripts::EngineEvent, std::size_t>> mEngineEvents;
+
+            // Output queues, for partition 0 they are the queues of LuaManager.
+            GlobalEventQueue* mGlobalEvents;
+            LocalEventQueue* mLocalEvents;
+            std::vector<std::unique_ptr<Action>>* mActionQueue;
+            std::vector<OutputSegment<3>> mOutputSegments;
+        };
+
         void initConfiguration();
+        void initLocalPartition(LocalPartition& partition, const Context& localContext);
         LocalScripts* createLocalScripts(const MWWorld::Ptr& ptr, ESM::LuaScriptCfg::Flags);
+        LocalPartition& getPartition(const LocalScripts* scripts);
+        template <class Function>
+        void recordOutput(LocalPartition& partition, OutputKey key, Function&& function);
+        void updatePartition(LocalPartition& partition);
+        void updatePartitions();
+        std::vector<LuaUtil::ScriptProfile> getScriptsProfile() const;  // summed over all Lua states
 
         bool mInitialized = false;
         bool mGlobalScriptsStarted = false;
+        std::string mProfilerReportPath;
         LuaUtil::ScriptsConfiguration mConfiguration;
         LuaUtil::LuaState mLua;
         LuaUtil::I18nManager mI18n;
-        sol::table mNearbyPackage;
         sol::table mUserInterfacePackage;
         sol::table mCameraPackage;
         sol::table mInputPackage;
-        sol::table mLocalSettingsPackage;
         sol::table mPlayerSettingsPackage;
-        sol::table mLocalStoragePackage;
         sol::table mPlayerStoragePackage;
 
+        std::vector<std::unique_ptr<LocalState>> mLocalStates;
+        std::vector<LocalPartition> mPartitions;
+
         GlobalScripts mGlobalScripts{&mLua};
-        std::set<LocalScripts*> mActiveLocalScripts;
         WorldView mWorldView;
 
         bool mPlayerChanged = false;
@@ -149,6 +199,18 @@ namespace MWLua
 
         LuaUtil::LuaStorage mGlobalStorage{mLua.sol()};
         LuaUtil::LuaStorage mPlayerStorage{mLua.sol()};
+
+        struct PartitionsUpdate
+        {
+            bool mProcessTimers = false;
+            double mSimulationTime = 0;
+            double mGameTime = 0;
+            float mFrameDuration = 0;
+        };
+        PartitionsUpdate mPartitionsUpdate;
+
+        // Worker threads process partitions 1..N-1, partition 0 is processed by the thread that calls `update`.
+        std::unique_ptr<PartitionsRunner> mPartitionsRunner;
     };
 
 }
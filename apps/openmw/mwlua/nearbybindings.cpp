@@ -7,6 +7,7 @@
 #include "../mwbase/world.hpp"
 #include "../mwphysics/raycasting.hpp"
 
+#include "localpartitions.hpp"
 #include "worldview.hpp"
 
 namespace sol
@@ -69,6 +70,7 @@ namespace MWLua
                 collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
                 radius = options->get<sol::optional<float>>("radius").value_or(0);
             }
+            const auto lock = lockWorldAccess();
             const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
             if (radius <= 0)
                 return rayCasting->castRay(from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
@@ -100,19 +102,7 @@ namespace MWLua
         api["items"] = LObjectList{worldView->getItemsInScene()};
         api["selectObjects"] = [context](const Queries::Query& query)
         {
-            ObjectIdList list;
-            WorldView* worldView = context.mWorldView;
-            if (query.mQueryType == "activators")
-                list = worldView->getActivatorsInScene();
-            else if (query.mQueryType == "actors")
-                list = worldView->getActorsInScene();
-            else if (query.mQueryType == "containers")
-                list = worldView->getContainersInScene();
-            else if (query.mQueryType == "doors")
-                list = worldView->getDoorsInScene();
-            else if (query.mQueryType == "items")
-                list = worldView->getItemsInScene();
-            return LObjectList{selectObjectsFromList(query, list, context)};
+            return LObjectList{selectObjectsInScene(query, context)};
             // TODO: Maybe use sqlite
             // return LObjectList{worldView->selectObjects(query, true)};
         };
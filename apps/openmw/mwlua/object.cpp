@@ -136,6 +136,7 @@ namespace MWLua
     MWWorld::Ptr ObjectRegistry::getPtr(ObjectId id, bool local)
     {
         MWWorld::Ptr ptr;
+        const std::lock_guard<std::mutex> lock(mMutex);
         auto it = mObjectMapping.find(id);
         if (it != mObjectMapping.end())
             ptr = it->second;
@@ -153,6 +154,7 @@ namespace MWLua
 
     ObjectId ObjectRegistry::registerPtr(const MWWorld::Ptr& ptr)
     {
+        const std::lock_guard<std::mutex> lock(mMutex);
         ObjectId id = ptr.getCellRef().getOrAssignRefNum(mLastAssignedId);
         mChanged = true;
         mObjectMapping[id] = ptr;
@@ -161,6 +163,7 @@ namespace MWLua
 
     ObjectId ObjectRegistry::deregisterPtr(const MWWorld::Ptr& ptr)
     {
+        const std::lock_guard<std::mutex> lock(mMutex);
         ObjectId id = getId(ptr);
         mChanged = true;
         mObjectMapping.erase(id);
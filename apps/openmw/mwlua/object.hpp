@@ -1,6 +1,7 @@
 #ifndef MWLUA_OBJECT_H
 #define MWLUA_OBJECT_H
 
+#include <mutex>
 #include <typeindex>
 
 #include <components/esm3/cellref.hpp>
@@ -54,6 +55,7 @@ namespace MWLua
     ESM::LuaScriptCfg::Flags getLuaScriptFlag(const MWWorld::Ptr& ptr);
 
     // Holds a mapping ObjectId -> MWWord::Ptr.
+    // registerPtr, deregisterPtr and getPtr are thread safe because local scripts can be processed in parallel.
     class ObjectRegistry
     {
     public:
@@ -78,6 +80,7 @@ namespace MWLua
         friend class Object;
         friend class LuaManager;
 
+        std::mutex mMutex;
         bool mChanged = false;
         int64_t mUpdateCounter = 0;
         std::map<ObjectId, MWWorld::Ptr> mObjectMapping;
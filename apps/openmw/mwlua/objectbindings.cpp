@@ -9,6 +9,7 @@
 #include "../mwworld/inventorystore.hpp"
 
 #include "eventqueue.hpp"
+#include "localpartitions.hpp"
 #include "luamanagerimp.hpp"
 
 namespace MWLua
@@ -59,7 +60,7 @@ namespace MWLua
     static void registerObjectList(const std::string& prefix, const Context& context)
     {
         using ListT = ObjectList<ObjectT>;
-        sol::state& lua = context.mLua->sol();
+        sol::state_view& lua = context.mLua->sol();
         ObjectRegistry* registry = context.mWorldView->getObjectRegistry();
         sol::usertype<ListT> listT = lua.new_usertype<ListT>(prefix + "ObjectList");
         listT[sol::meta_function::to_string] =
@@ -143,7 +144,7 @@ namespace MWLua
             if (esmRecordType != ESM::REC_CREA && esmRecordType != ESM::REC_NPC_)
                 throw std::runtime_error("The argument of `activateBy` must be an actor who activates the object. Got: " +
                                          ptrToString(actor.ptr()));
-            context.mLuaManager->addAction(std::make_unique<ActivateAction>(context.mLua, o.id(), actor.id()));
+            context.mActionQueue->push_back(std::make_unique<ActivateAction>(context.mLua, o.id(), actor.id()));
         };
 
         if constexpr (std::is_same_v<ObjectT, GObject>)
@@ -196,17 +197,19 @@ namespace MWLua
                 if (ptr == MWBase::Environment::get().getWorld()->getPlayerPtr())
                     context.mLuaManager->addTeleportPlayerAction(std::move(action));
                 else
-                    context.mLuaManager->addAction(std::move(action));
+                    context.mActionQueue->push_back(std::move(action));
             };
         }
         else
         {  // Only for local scripts
             objectT["isOnGround"] = [](const ObjectT& o)
             {
+                const auto lock = lockWorldAccess();
                 return MWBase::Environment::get().getWorld()->isOnGround(o.ptr());
             };
             objectT["isSwimming"] = [](const ObjectT& o)
             {
+                const auto lock = lockWorldAccess();
                 return MWBase::Environment::get().getWorld()->isSwimming(o.ptr());
             };
             objectT["isInWeaponStance"] = [](const ObjectT& o)
@@ -371,7 +374,7 @@ namespace MWLua
                         throw std::runtime_error(ptrToString(obj.ptr()) + " has no equipment slots");
                     return;
                 }
-                context.mLuaManager->addAction(std::make_unique<SetEquipmentAction>(
+                context.mActionQueue->push_back(std::make_unique<SetEquipmentAction>(
                     context.mLua, obj.id(), parseEquipmentTable(equipment)));
             };
 
@@ -1,56 +1,133 @@
 #include "query.hpp"
 
-#include <sol/sol.hpp>
+#include <array>
+#include <stdexcept>
 
-#include <components/lua/luastate.hpp>
+#include <components/esm3/loadcell.hpp>
 
 #include "../mwclass/container.hpp"
 #include "../mwworld/cellstore.hpp"
+#include "../mwworld/class.hpp"
 
 #include "worldview.hpp"
 
 namespace MWLua
 {
 
-    static std::vector<QueryFieldGroup> initBasicFieldGroups()
+    namespace
     {
-        auto createGroup = [](std::string name, const auto& arr) -> QueryFieldGroup
+        std::optional<Queries::FieldValue> getType(const MWWorld::Ptr& ptr, WorldView&)
         {
-            std::vector<const Queries::Field*> fieldPtrs;
-            fieldPtrs.reserve(arr.size());
-            for (const Queries::Field& field : arr)
-                fieldPtrs.push_back(&field);
-            return {std::move(name), std::move(fieldPtrs)};
-        };
-        static std::array objectFields = {
-            Queries::Field({"type"}, typeid(std::string)),
-            Queries::Field({"recordId"}, typeid(std::string)),
-            Queries::Field({"cell", "name"}, typeid(std::string)),
-            Queries::Field({"cell", "region"}, typeid(std::string)),
-            Queries::Field({"cell", "isExterior"}, typeid(bool)),
-            Queries::Field({"count"}, typeid(int32_t)),
+            return std::string(getLuaObjectTypeName(ptr));
+        }
+
+        std::optional<Queries::FieldValue> getRecordId(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            return ptr.getCellRef().getRefId();
+        }
+
+        std::optional<Queries::FieldValue> getCellName(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            if (!ptr.isInCell())
+                return std::nullopt;
+            return ptr.getCell()->getCell()->mName;
+        }
+
+        std::optional<Queries::FieldValue> getCellRegion(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            if (!ptr.isInCell())
+                return std::nullopt;
+            return ptr.getCell()->getCell()->mRegion;
+        }
+
+        std::optional<Queries::FieldValue> getCellIsExterior(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            if (!ptr.isInCell())
+                return std::nullopt;
+            return ptr.getCell()->isExterior();
+        }
+
+        std::optional<Queries::FieldValue> getCount(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            return static_cast<int32_t>(ptr.getRefData().getCount());
+        }
+
+        std::optional<Queries::FieldValue> getIsTeleport(const MWWorld::Ptr& ptr, WorldView&)
+        {
+            if (ptr.getType() != ESM::REC_DOOR)
+                return std::nullopt;
+            return ptr.getCellRef().getTeleport();
+        }
+
+        MWWorld::CellStore* getDestCell(const MWWorld::Ptr& ptr, WorldView& worldView)
+        {
+            if (ptr.getType() != ESM::REC_DOOR || !ptr.getCellRef().getTeleport())
+                return nullptr;
+            const MWWorld::CellRef& cellRef = ptr.getCellRef();
+            return worldView.findCell(cellRef.getDestCell(), cellRef.getDoorDest().asVec3());
+        }
+
+        std::optional<Queries::FieldValue> getDestCellName(const MWWorld::Ptr& ptr, WorldView& worldView)
+        {
+            MWWorld::CellStore* cell = getDestCell(ptr, worldView);
+            if (!cell)
+                return std::nullopt;
+            return cell->getCell()->mName;
+        }
+
+        std::optional<Queries::FieldValue> getDestCellRegion(const MWWorld::Ptr& ptr, WorldView& worldView)
+        {
+            MWWorld::CellStore* cell = getDestCell(ptr, worldView);
+            if (!cell)
+                return std::nullopt;
+            return cell->getCell()->mRegion;
+        }
+
+        std::optional<Queries::FieldValue> getDestCellIsExterior(const MWWorld::Ptr& ptr, WorldView& worldView)
+        {
+            MWWorld::CellStore* cell = getDestCell(ptr, worldView);
+            if (!cell)
+                return std::nullopt;
+            return cell->isExterior();
+        }
+
+        struct BasicField
+        {
+            Queries::Field mField;
+            QueryFieldGetter mGetter;
         };
-        static std::array doorFields = {
-            Queries::Field({"isTeleport"}, typeid(bool)),
-            Queries::Field({"destCell", "name"}, typeid(std::string)),
-            Queries::Field({"destCell", "region"}, typeid(std::string)),
-            Queries::Field({"destCell", "isExterior"}, typeid(bool)),
+
+        std::array<BasicField, 6> objectFields = {
+            BasicField{Queries::Field({"type"}, typeid(std::string)), &getType},
+            BasicField{Queries::Field({"recordId"}, typeid(std::string)), &getRecordId},
+            BasicField{Queries::Field({"cell", "name"}, typeid(std::string)), &getCellName},
+            BasicField{Queries::Field({"cell", "region"}, typeid(std::string)), &getCellRegion},
+            BasicField{Queries::Field({"cell", "isExterior"}, typeid(bool)), &getCellIsExterior},
+            BasicField{Queries::Field({"count"}, typeid(int32_t)), &getCount},
         };
-        return std::vector<QueryFieldGroup>{
-            createGroup("OBJECT", objectFields),
-            createGroup("DOOR", doorFields),
+
+        std::array<BasicField, 4> doorFields = {
+            BasicField{Queries::Field({"isTeleport"}, typeid(bool)), &getIsTeleport},
+            BasicField{Queries::Field({"destCell", "name"}, typeid(std::string)), &getDestCellName},
+            BasicField{Queries::Field({"destCell", "region"}, typeid(std::string)), &getDestCellRegion},
+            BasicField{Queries::Field({"destCell", "isExterior"}, typeid(bool)), &getDestCellIsExterior},
         };
-    }
 
-    const std::vector<QueryFieldGroup>& getBasicQueryFieldGroups()
-    {
-        static std::vector<QueryFieldGroup> fieldGroups = initBasicFieldGroups();
-        return fieldGroups;
-    }
+        const Queries::Field* const recordIdField = &objectFields[1].mField;
 
-    bool checkQueryConditions(const Queries::Query& query, const ObjectId& id, const Context& context)
-    {
-        auto compareFn = [](auto&& a, auto&& b, Queries::Condition::Type t)
+        QueryFieldGetter findGetter(const Queries::Field* field)
+        {
+            for (const BasicField& f : objectFields)
+                if (&f.mField == field)
+                    return f.mGetter;
+            for (const BasicField& f : doorFields)
+                if (&f.mField == field)
+                    return f.mGetter;
+            throw std::runtime_error("Query field " + field->toString() + " is not supported");
+        }
+
+        template <class T>
+        bool compare(const T& a, const T& b, Queries::Condition::Type t)
         {
             switch (t)
             {
@@ -63,25 +140,73 @@ namespace MWLua
                 default:
                     throw std::runtime_error("Unsupported condition type");
             }
-        };
-        sol::object obj;
-        MWWorld::Ptr ptr;
-        if (context.mIsGlobal)
+        }
+
+        bool checkCondition(const Queries::Condition& cond, const std::optional<Queries::FieldValue>& value)
         {
-            GObject g(id, context.mWorldView->getObjectRegistry());
-            if (!g.isValid())
+            if (!value.has_value())
                 return false;
-            ptr = g.ptr();
-            obj = sol::make_object(context.mLua->sol(), g);
+            return std::visit([&](const auto& v)
+            {
+                using T = std::decay_t<decltype(v)>;
+                return compare(v, std::get<T>(cond.mValue), cond.mType);
+            }, *value);
         }
-        else
+
+        // Returns true if the filter is a conjunction, i.e. every condition should be true for the result to be true.
+        bool isConjunction(const Queries::Filter& filter)
         {
-            LObject l(id, context.mWorldView->getObjectRegistry());
-            if (!l.isValid())
-                return false;
-            ptr = l.ptr();
-            obj = sol::make_object(context.mLua->sol(), l);
+            for (const Queries::Operation& op : filter.mOperations)
+                if (op.mType != Queries::Operation::PUSH && op.mType != Queries::Operation::AND)
+                    return false;
+            return true;
+        }
+
+        void checkSupported(const Queries::Query& query)
+        {
+            if (!query.mOrderBy.empty() || !query.mGroupBy.empty() || query.mOffset > 0)
+                throw std::runtime_error("OrderBy, GroupBy, and Offset are not supported");
         }
+    }
+
+    static std::vector<QueryFieldGroup> initBasicFieldGroups()
+    {
+        auto createGroup = [](std::string name, const auto& arr) -> QueryFieldGroup
+        {
+            std::vector<const Queries::Field*> fieldPtrs;
+            fieldPtrs.reserve(arr.size());
+            for (const BasicField& field : arr)
+                fieldPtrs.push_back(&field.mField);
+            return {std::move(name), std::move(fieldPtrs)};
+        };
+        return std::vector<QueryFieldGroup>{
+            createGroup("OBJECT", objectFields),
+            createGroup("DOOR", doorFields),
+        };
+    }
+
+    const std::vector<QueryFieldGroup>& getBasicQueryFieldGroups()
+    {
+        static std::vector<QueryFieldGroup> fieldGroups = initBasicFieldGroups();
+        return fieldGroups;
+    }
+
+    CompiledQuery::CompiledQuery(const Queries::Query& query, WorldView& worldView)
+        : mQuery(query)
+        , mWorldView(worldView)
+    {
+        const bool conjunction = isConjunction(query.mFilter);
+        mGetters.reserve(query.mFilter.mConditions.size());
+        for (const Queries::Condition& cond : query.mFilter.mConditions)
+        {
+            mGetters.push_back(findGetter(cond.mField));
+            if (conjunction && cond.mField == recordIdField && cond.mType == Queries::Condition::EQUAL)
+                mRequiredRecordId = &std::get<std::string>(cond.mValue);
+        }
+    }
+
+    bool CompiledQuery::matches(const MWWorld::Ptr& ptr) const
+    {
         if (ptr.getRefData().getCount() == 0)
             return false;
 
@@ -91,44 +216,24 @@ namespace MWLua
             return false;
 
         const MWWorld::Class& cls = ptr.getClass();
-        if (cls.isActivator() != (query.mQueryType == ObjectQueryTypes::ACTIVATORS))
+        if (cls.isActivator() != (mQuery.mQueryType == ObjectQueryTypes::ACTIVATORS))
             return false;
-        if (cls.isActor() != (query.mQueryType == ObjectQueryTypes::ACTORS))
+        if (cls.isActor() != (mQuery.mQueryType == ObjectQueryTypes::ACTORS))
             return false;
-        if (cls.isDoor() != (query.mQueryType == ObjectQueryTypes::DOORS))
+        if (cls.isDoor() != (mQuery.mQueryType == ObjectQueryTypes::DOORS))
             return false;
-        if ((typeid(cls) == typeid(MWClass::Container)) != (query.mQueryType == ObjectQueryTypes::CONTAINERS))
+        if ((typeid(cls) == typeid(MWClass::Container)) != (mQuery.mQueryType == ObjectQueryTypes::CONTAINERS))
             return false;
 
         std::vector<char> condStack;
-        for (const Queries::Operation& op : query.mFilter.mOperations)
+        for (const Queries::Operation& op : mQuery.mFilter.mOperations)
         {
             switch(op.mType)
             {
                 case Queries::Operation::PUSH:
                 {
-                    const Queries::Condition& cond = query.mFilter.mConditions[op.mConditionIndex];
-                    sol::object fieldObj = obj;
-                    for (const std::string& field : cond.mField->path())
-                        fieldObj = LuaUtil::getFieldOrNil(fieldObj, field);
-                    bool c;
-                    if (fieldObj == sol::nil)
-                        c = false;
-                    else if (cond.mField->type() == typeid(std::string))
-                        c = compareFn(fieldObj.as<std::string_view>(), std::get<std::string>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(float))
-                        c = compareFn(fieldObj.as<float>(), std::get<float>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(double))
-                        c = compareFn(fieldObj.as<double>(), std::get<double>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(bool))
-                        c = compareFn(fieldObj.as<bool>(), std::get<bool>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(int32_t))
-                        c = compareFn(fieldObj.as<int32_t>(), std::get<int32_t>(cond.mValue), cond.mType);
-                    else if (cond.mField->type() == typeid(int64_t))
-                        c = compareFn(fieldObj.as<int64_t>(), std::get<int64_t>(cond.mValue), cond.mType);
-                    else
-                        throw std::runtime_error("Unknown field type");
-                    condStack.push_back(c);
+                    const Queries::Condition& cond = mQuery.mFilter.mConditions[op.mConditionIndex];
+                    condStack.push_back(checkCondition(cond, mGetters[op.mConditionIndex](ptr, mWorldView)));
                     break;
                 }
                 case Queries::Operation::NOT:
@@ -153,39 +258,78 @@ namespace MWLua
         return condStack.empty() || condStack.back() != 0;
     }
 
-    ObjectIdList selectObjectsFromList(const Queries::Query& query, const ObjectIdList& list, const Context& context)
+    template <class ObjectT, class Container>
+    static void selectObjects(const CompiledQuery& query, const Container& ids, ObjectRegistry* registry,
+        std::vector<ObjectId>& res)
     {
-        if (!query.mOrderBy.empty() || !query.mGroupBy.empty() || query.mOffset > 0)
-            throw std::runtime_error("OrderBy, GroupBy, and Offset are not supported");
-
-        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
-        for (const ObjectId& id : *list)
+        for (const ObjectId& id : ids)
         {
-            if (static_cast<int64_t>(res->size()) == query.mLimit)
+            if (static_cast<int64_t>(res.size()) == query.getQuery().mLimit)
                 break;
-            if (checkQueryConditions(query, id, context))
-                res->push_back(id);
+            ObjectT obj(id, registry);
+            if (obj.isValid() && query.matches(obj.ptr()))
+                res.push_back(id);
         }
+    }
+
+    ObjectIdList selectObjectsFromList(const Queries::Query& query, const ObjectIdList& list, const Context& context)
+    {
+        checkSupported(query);
+        const CompiledQuery compiled(query, *context.mWorldView);
+        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
+        ObjectRegistry* registry = context.mWorldView->getObjectRegistry();
+        if (context.mIsGlobal)
+            selectObjects<GObject>(compiled, *list, registry, *res);
+        else
+            selectObjects<LObject>(compiled, *list, registry, *res);
         return res;
     }
 
     ObjectIdList selectObjectsFromCellStore(const Queries::Query& query, MWWorld::CellStore* store, const Context& context)
     {
-        if (!query.mOrderBy.empty() || !query.mGroupBy.empty() || query.mOffset > 0)
-            throw std::runtime_error("OrderBy, GroupBy, and Offset are not supported");
-
+        checkSupported(query);
+        const CompiledQuery compiled(query, *context.mWorldView);
         ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
         auto visitor = [&](const MWWorld::Ptr& ptr)
         {
             if (static_cast<int64_t>(res->size()) == query.mLimit)
                 return false;
-            context.mWorldView->getObjectRegistry()->registerPtr(ptr);
-            if (checkQueryConditions(query, getId(ptr), context))
-                res->push_back(getId(ptr));
+            if (compiled.getRequiredRecordId() != nullptr && ptr.getCellRef().getRefId() != *compiled.getRequiredRecordId())
+                return true;
+            if (compiled.matches(ptr))
+                res->push_back(context.mWorldView->getObjectRegistry()->registerPtr(ptr));
             return static_cast<int64_t>(res->size()) != query.mLimit;
         };
         store->forEach(std::move(visitor));  // TODO: maybe use store->forEachType<TYPE> depending on query.mType
         return res;
     }
 
+    ObjectIdList selectObjectsInScene(const Queries::Query& query, const Context& context)
+    {
+        checkSupported(query);
+        WorldView* worldView = context.mWorldView;
+        const CompiledQuery compiled(query, *worldView);
+        ObjectIdList res = std::make_shared<std::vector<ObjectId>>();
+        ObjectRegistry* registry = worldView->getObjectRegistry();
+        if (const std::string* recordId = compiled.getRequiredRecordId())
+        {
+            const std::set<ObjectId>* ids = worldView->getObjectsInSceneByRecordId(query.mQueryType, *recordId);
+            if (ids == nullptr)
+                return res;
+            if (context.mIsGlobal)
+                selectObjects<GObject>(compiled, *ids, registry, *res);
+            else
+                selectObjects<LObject>(compiled, *ids, registry, *res);
+            return res;
+        }
+        ObjectIdList list = worldView->getObjectsInScene(query.mQueryType);
+        if (!list)
+            return res;
+        if (context.mIsGlobal)
+            selectObjects<GObject>(compiled, *list, registry, *res);
+        else
+            selectObjects<LObject>(compiled, *list, registry, *res);
+        return res;
+    }
+
 }
@@ -1,7 +1,9 @@
 #ifndef MWLUA_QUERY_H
 #define MWLUA_QUERY_H
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <components/queries/query.hpp>
 
@@ -31,9 +33,35 @@ namespace MWLua
 
     // TODO: Implement custom fields. QueryFieldGroup registerCustomFields(...);
 
+    // Native getter of a query field. Returns std::nullopt if the field is nil for the object.
+    using QueryFieldGetter = std::optional<Queries::FieldValue> (*)(const MWWorld::Ptr&, WorldView&);
+
+    // Query with fields resolved to native getters. Checks objects without creating Lua values.
+    class CompiledQuery
+    {
+    public:
+        CompiledQuery(const Queries::Query& query, WorldView& worldView);
+
+        const Queries::Query& getQuery() const { return mQuery; }
+
+        // If not nullptr, then only objects with this record id can match the query.
+        const std::string* getRequiredRecordId() const { return mRequiredRecordId; }
+
+        bool matches(const MWWorld::Ptr& ptr) const;
+
+    private:
+        const Queries::Query& mQuery;
+        WorldView& mWorldView;
+        std::vector<QueryFieldGetter> mGetters;  // per condition
+        const std::string* mRequiredRecordId = nullptr;
+    };
+
     ObjectIdList selectObjectsFromList(const Queries::Query& query, const ObjectIdList& list, const Context&);
     ObjectIdList selectObjectsFromCellStore(const Queries::Query& query, MWWorld::CellStore* store, const Context&);
 
+    // Selects objects of `query.mQueryType` that are currently in the scene. Uses indices of WorldView.
+    ObjectIdList selectObjectsInScene(const Queries::Query& query, const Context&);
+
 }
 
 #endif // MWLUA_QUERY_H
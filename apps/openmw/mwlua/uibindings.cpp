@@ -183,14 +183,14 @@ namespace MWLua
             if (element->mDestroy || element->mUpdate)
                 return;
             element->mUpdate = true;
-            context.mLuaManager->addAction(std::make_unique<UiAction>(UiAction::UPDATE, element, context.mLua));
+            context.mActionQueue->push_back(std::make_unique<UiAction>(UiAction::UPDATE, element, context.mLua));
         };
         element["destroy"] = [context](const std::shared_ptr<LuaUi::Element>& element)
         {
             if (element->mDestroy)
                 return;
             element->mDestroy = true;
-            context.mLuaManager->addAction(std::make_unique<UiAction>(UiAction::DESTROY, element, context.mLua));
+            context.mActionQueue->push_back(std::make_unique<UiAction>(UiAction::DESTROY, element, context.mLua));
         };
 
         sol::table api = context.mLua->newTable();
@@ -205,7 +205,7 @@ namespace MWLua
         api["create"] = [context](const sol::table& layout)
         {
             auto element = LuaUi::Element::make(layout);
-            context.mLuaManager->addAction(std::make_unique<UiAction>(UiAction::CREATE, element, context.mLua));
+            context.mActionQueue->push_back(std::make_unique<UiAction>(UiAction::CREATE, element, context.mLua));
             return element;
         };
 
@@ -231,7 +231,7 @@ namespace MWLua
         {
             LuaUi::Layers::Options options;
             options.mInteractive = LuaUtil::getValueOrDefault(LuaUtil::getFieldOrNil(opt, "interactive"), true);
-            context.mLuaManager->addAction(std::make_unique<LayerAction>(name, afterName, options, context.mLua));
+            context.mActionQueue->push_back(std::make_unique<LayerAction>(name, afterName, options, context.mLua));
         };
         api["layers"] = LuaUtil::makeReadOnly(layers);
 
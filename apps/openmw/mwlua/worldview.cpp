@@ -11,6 +11,9 @@
 #include "../mwworld/class.hpp"
 #include "../mwworld/timestamp.hpp"
 
+#include "localpartitions.hpp"
+#include "query.hpp"
+
 namespace MWLua
 {
 
@@ -55,6 +58,40 @@ namespace MWLua
         return nullptr;
     }
 
+    const WorldView::ObjectGroup* WorldView::getGroupByQueryType(std::string_view queryType) const
+    {
+        if (queryType == ObjectQueryTypes::ACTIVATORS)
+            return &mActivatorsInScene;
+        if (queryType == ObjectQueryTypes::ACTORS)
+            return &mActorsInScene;
+        if (queryType == ObjectQueryTypes::CONTAINERS)
+            return &mContainersInScene;
+        if (queryType == ObjectQueryTypes::DOORS)
+            return &mDoorsInScene;
+        if (queryType == ObjectQueryTypes::ITEMS)
+            return &mItemsInScene;
+        return nullptr;
+    }
+
+    ObjectIdList WorldView::getObjectsInScene(std::string_view queryType) const
+    {
+        const ObjectGroup* group = getGroupByQueryType(queryType);
+        if (!group)
+            return nullptr;
+        return group->mList;
+    }
+
+    const std::set<ObjectId>* WorldView::getObjectsInSceneByRecordId(std::string_view queryType, std::string_view recordId) const
+    {
+        const ObjectGroup* group = getGroupByQueryType(queryType);
+        if (!group)
+            return nullptr;
+        auto it = group->mByRecordId.find(recordId);
+        if (it == group->mByRecordId.end())
+            return nullptr;
+        return &it->second;
+    }
+
     void WorldView::objectAddedToScene(const MWWorld::Ptr& ptr)
     {
         mObjectRegistry.registerPtr(ptr);
@@ -107,23 +144,33 @@ namespace MWLua
         mChanged = false;
         mList->clear();
         mSet.clear();
+        mByRecordId.clear();
     }
 
     void WorldView::addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
         group.mSet.insert(getId(ptr));
+        group.mByRecordId[ptr.getCellRef().getRefId()].insert(getId(ptr));
         group.mChanged = true;
     }
 
     void WorldView::removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr)
     {
         group.mSet.erase(getId(ptr));
+        auto it = group.mByRecordId.find(ptr.getCellRef().getRefId());
+        if (it != group.mByRecordId.end())
+        {
+            it->second.erase(getId(ptr));
+            if (it->second.empty())
+                group.mByRecordId.erase(it);
+        }
         group.mChanged = true;
     }
 
-    // TODO: If Lua scripts will use several threads at the same time, then `find*Cell` functions should have critical sections.
+    // `find*Cell` functions are called by local scripts from several threads, and World caches the cells it returns.
     MWWorld::CellStore* WorldView::findCell(const std::string& name, osg::Vec3f position)
     {
+        const auto lock = lockWorldAccess();
         MWBase::World* world = MWBase::Environment::get().getWorld();
         bool exterior = name.empty() || world->getExterior(name);
         if (exterior)
@@ -138,6 +185,7 @@ namespace MWLua
 
     MWWorld::CellStore* WorldView::findNamedCell(const std::string& name)
     {
+        const auto lock = lockWorldAccess();
         MWBase::World* world = MWBase::Environment::get().getWorld();
         const ESM::Cell* esmCell = world->getExterior(name);
         if (esmCell)
@@ -148,6 +196,7 @@ namespace MWLua
 
     MWWorld::CellStore* WorldView::findExteriorCell(int x, int y)
     {
+        const auto lock = lockWorldAccess();
         MWBase::World* world = MWBase::Environment::get().getWorld();
         return world->getExterior(x, y);
     }
@@ -1,6 +1,10 @@
 #ifndef MWLUA_WORLDVIEW_H
 #define MWLUA_WORLDVIEW_H
 
+#include <map>
+#include <set>
+#include <string_view>
+
 #include "object.hpp"
 
 namespace ESM
@@ -39,6 +43,12 @@ namespace MWLua
         ObjectIdList getDoorsInScene() const { return mDoorsInScene.mList; }
         ObjectIdList getItemsInScene() const { return mItemsInScene.mList; }
 
+        // Returns objects in the scene for a query type (see ObjectQueryTypes) or nullptr if the type is unknown.
+        ObjectIdList getObjectsInScene(std::string_view queryType) const;
+
+        // Index by record id. Returns nullptr if there are no such objects in the scene.
+        const std::set<ObjectId>* getObjectsInSceneByRecordId(std::string_view queryType, std::string_view recordId) const;
+
         ObjectRegistry* getObjectRegistry() { return &mObjectRegistry; }
 
         void objectUnloaded(const MWWorld::Ptr& ptr) { mObjectRegistry.deregisterPtr(ptr); }
@@ -66,9 +76,11 @@ namespace MWLua
             bool mChanged = false;
             ObjectIdList mList = std::make_shared<std::vector<ObjectId>>();
             std::set<ObjectId> mSet;
+            std::map<std::string, std::set<ObjectId>, std::less<>> mByRecordId;
         };
 
         ObjectGroup* chooseGroup(const MWWorld::Ptr& ptr);
+        const ObjectGroup* getGroupByQueryType(std::string_view queryType) const;
         void addToGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
         void removeFromGroup(ObjectGroup& group, const MWWorld::Ptr& ptr);
 
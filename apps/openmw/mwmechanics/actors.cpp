@@ -1,6 +1,11 @@
 #include "actors.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
@@ -218,6 +223,47 @@ void removeTemporaryEffects(const MWWorld::Ptr& ptr)
         return spell.getType() == ESM::ActiveSpells::Type_Consumable || spell.getType() == ESM::ActiveSpells::Type_Temporary;
     }, ptr);
 }
+
+struct ActorSnapshot
+{
+    MWWorld::Ptr mPtr;
+    osg::Vec3f mPosition;
+    osg::Vec3f mHalfExtents;
+};
+
+// Buckets actors by horizontal position so only actors from the neighbour cells have to be checked.
+class ActorsGrid
+{
+public:
+    explicit ActorsGrid(float cellSize) : mCellSize(cellSize) {}
+
+    void add(std::size_t index, const osg::Vec3f& position)
+    {
+        mCells[getCell(position)].push_back(index);
+    }
+
+    // Returns indices of all actors within cellSize from position (and some further ones) in ascending order.
+    void getNeighbours(const osg::Vec3f& position, std::vector<std::size_t>& out) const
+    {
+        out.clear();
+        const auto [x, y] = getCell(position);
+        for (int dx = -1; dx <= 1; ++dx)
+            for (int dy = -1; dy <= 1; ++dy)
+                if (const auto it = mCells.find({x + dx, y + dy}); it != mCells.end())
+                    out.insert(out.end(), it->second.begin(), it->second.end());
+        std::sort(out.begin(), out.end());
+    }
+
+private:
+    float mCellSize;
+    std::map<std::pair<int, int>, std::vector<std::size_t>> mCells;
+
+    std::pair<int, int> getCell(const osg::Vec3f& position) const
+    {
+        return {static_cast<int>(std::floor(position.x() / mCellSize)),
+                static_cast<int>(std::floor(position.y() / mCellSize))};
+    }
+};
 }
 
 namespace MWMechanics
@@ -1222,9 +1268,21 @@ namespace MWMechanics
 
         MWWorld::Ptr player = getPlayer();
         MWBase::World* world = MWBase::Environment::get().getWorld();
-        for(PtrActorMap::iterator iter(mActors.begin()); iter != mActors.end(); ++iter)
+
+        // Positions and half extents are not changed here, so collect them once instead of for each pair of actors.
+        std::vector<ActorSnapshot> actors;
+        actors.reserve(mActors.size());
+        ActorsGrid grid(maxDistForPartialAvoiding);
+        for (const auto& [ptr, actor] : mActors)
         {
-            const MWWorld::Ptr& ptr = iter->first;
+            actors.push_back(ActorSnapshot {ptr, ptr.getRefData().getPosition().asVec3(), world->getHalfExtents(ptr)});
+            grid.add(actors.size() - 1, actors.back().mPosition);
+        }
+
+        std::vector<std::size_t> neighbours;
+        for (const ActorSnapshot& base : actors)
+        {
+            const MWWorld::Ptr& ptr = base.mPtr;
             if (ptr == player)
                 continue; // Don't interfere with player controls.
 
@@ -1267,9 +1325,9 @@ namespace MWMechanics
                 continue;
 
             osg::Vec2f baseSpeed = origMovement * maxSpeed;
-            osg::Vec3f basePos = ptr.getRefData().getPosition().asVec3();
+            const osg::Vec3f& basePos = base.mPosition;
             float baseRotZ = ptr.getRefData().getPosition().rot[2];
-            const osg::Vec3f halfExtents = world->getHalfExtents(ptr);
+            const osg::Vec3f& halfExtents = base.mHalfExtents;
             float maxDistToCheck = isMoving ? maxDistForPartialAvoiding : maxDistForStrictAvoiding;
 
             float timeToCheck = maxTimeToCheck;
@@ -1280,15 +1338,17 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for(PtrActorMap::iterator otherIter(mActors.begin()); otherIter != mActors.end(); ++otherIter)
+            // Iterate through nearby actors and predict collisions.
+            grid.getNeighbours(basePos, neighbours);
+            for (const std::size_t index : neighbours)
             {
-                const MWWorld::Ptr& otherPtr = otherIter->first;
+                const ActorSnapshot& other = actors[index];
+                const MWWorld::Ptr& otherPtr = other.mPtr;
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
 
-                const osg::Vec3f otherHalfExtents = world->getHalfExtents(otherPtr);
-                osg::Vec3f deltaPos = otherPtr.getRefData().getPosition().asVec3() - basePos;
+                const osg::Vec3f& otherHalfExtents = other.mHalfExtents;
+                osg::Vec3f deltaPos = other.mPosition - basePos;
                 osg::Vec2f relPos = Misc::rotateVec2f(osg::Vec2f(deltaPos.x(), deltaPos.y()), baseRotZ);
                 float dist = deltaPos.length();
 
@@ -1554,6 +1614,9 @@ namespace MWMechanics
             if (avoidCollisions)
                 predictAndAvoidCollisions(duration);
 
+            static const float animationLodDistance = Settings::Manager::getFloat("animation lod distance", "Game");
+            static const int animationLodMaxInterval = std::max(1, Settings::Manager::getInt("animation lod max interval", "Game"));
+
             timerUpdateHeadTrack += duration;
             timerUpdateEquippedLight += duration;
             timerUpdateHello += duration;
@@ -1582,6 +1645,12 @@ namespace MWMechanics
                 CharacterController* ctrl = iter->second->getCharacterController();
                 ctrl->setActive(active);
 
+                // Distant actors update bones at a reduced rate, animation time and text keys still advance every frame.
+                int animationUpdateInterval = 1;
+                if (!isPlayer && animationLodDistance > 0)
+                    animationUpdateInterval = std::clamp(static_cast<int>(dist / animationLodDistance) + 1, 1, animationLodMaxInterval);
+                ctrl->setAnimationUpdateInterval(static_cast<unsigned int>(animationUpdateInterval));
+
                 if (!inRange)
                 {
                     iter->first.getRefData().getBaseNode()->setNodeMask(0);
@@ -115,6 +115,9 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
         return false;
     }
 
+    if (mPathFinder.isPathPending() && mPathFinder.applyPendingPath(actor, getPathGridGraph(actor.getCell())))
+        onPathBuilt(position, dest, mPendingPathDestInLOS);
+
     mLastDestinationTolerance = destTolerance;
 
     const float distToTarget = distance(position, dest);
@@ -135,25 +138,24 @@ bool MWMechanics::AiPackage::pathTo(const MWWorld::Ptr& actor, const osg::Vec3f&
 
         if (!mIsShortcutting)
         {
-            if (wasShortcutting || doesPathNeedRecalc(dest, actor)) // if need to rebuild path
+            // if need to rebuild path
+            if (wasShortcutting || (!mPathFinder.isPathPending() && doesPathNeedRecalc(dest, actor)))
             {
+                const bool asyncPathFinding = world->getNavigator()->getSettings().mAsyncPathFinderThreads > 0;
                 const auto pathfindingHalfExtents = world->getPathfindingHalfExtents(actor);
-                mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
-                    pathfindingHalfExtents, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
-                mRotateOnTheRunChecks = 3;
-
-                // give priority to go directly on target if there is minimal opportunity
-                if (destInLOS && mPathFinder.getPath().size() > 1)
+                if (asyncPathFinding)
+                {
+                    const float priority = distance(position, getPlayer().getRefData().getPosition().asVec3());
+                    mPathFinder.requestLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
+                        pathfindingHalfExtents, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType,
+                        priority);
+                    mPendingPathDestInLOS = destInLOS;
+                }
+                else
                 {
-                    // get point just before dest
-                    auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
-
-                    // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
-                    if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
-                    {
-                        mPathFinder.clearPath();
-                        mPathFinder.addPointToPath(dest);
-                    }
+                    mPathFinder.buildLimitedPath(actor, position, dest, actor.getCell(), getPathGridGraph(actor.getCell()),
+                        pathfindingHalfExtents, getNavigatorFlags(actor), getAreaCosts(actor), endTolerance, pathType);
+                    onPathBuilt(position, dest, destInLOS);
                 }
             }
 
@@ -375,6 +377,25 @@ bool MWMechanics::AiPackage::checkWayIsClearForActor(const osg::Vec3f& startPoin
     return false;
 }
 
+void MWMechanics::AiPackage::onPathBuilt(const osg::Vec3f& position, const osg::Vec3f& dest, bool destInLOS)
+{
+    mRotateOnTheRunChecks = 3;
+
+    // give priority to go directly on target if there is minimal opportunity
+    if (destInLOS && mPathFinder.getPath().size() > 1)
+    {
+        // get point just before dest
+        auto pPointBeforeDest = mPathFinder.getPath().rbegin() + 1;
+
+        // if start point is closer to the target then last point of path (excluding target itself) then go straight on the target
+        if (distance(position, dest) <= distance(dest, *pPointBeforeDest))
+        {
+            mPathFinder.clearPath();
+            mPathFinder.addPointToPath(dest);
+        }
+    }
+}
+
 bool MWMechanics::AiPackage::doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const
 {
     return mPathFinder.getPath().empty()
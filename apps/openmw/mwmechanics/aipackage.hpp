@@ -144,6 +144,9 @@ namespace MWMechanics
 
             bool doesPathNeedRecalc(const osg::Vec3f& newDest, const MWWorld::Ptr& actor) const;
 
+            /// Prefer going directly to the destination if it was in line of sight when path was requested
+            void onPathBuilt(const osg::Vec3f& position, const osg::Vec3f& dest, bool destInLOS);
+
             void evadeObstacles(const MWWorld::Ptr& actor);
 
             void openDoors(const MWWorld::Ptr& actor);
@@ -172,6 +175,7 @@ namespace MWMechanics
             bool mShortcutProhibited; // shortcutting may be prohibited after unsuccessful attempt
             osg::Vec3f mShortcutFailPos; // position of last shortcut fail
             float mLastDestinationTolerance = 0;
+            bool mPendingPathDestInLOS = false;
 
         private:
             bool isNearInactiveCell(osg::Vec3f position);
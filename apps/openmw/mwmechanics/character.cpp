@@ -2900,6 +2900,11 @@ void CharacterController::setActive(int active)
     mAnimation->setActive(active);
 }
 
+void CharacterController::setAnimationUpdateInterval(unsigned int interval)
+{
+    mAnimation->setUpdateInterval(interval);
+}
+
 void CharacterController::setHeadTrackTarget(const MWWorld::ConstPtr &target)
 {
     mHeadTrackTarget = target;
@@ -300,6 +300,9 @@ public:
     /// @see Animation::setActive
     void setActive(int active);
 
+    /// @see Animation::setUpdateInterval
+    void setAnimationUpdateInterval(unsigned int interval);
+
     /// Make this character turn its head towards \a target. To turn off head tracking, pass an empty Ptr.
     void setHeadTrackTarget(const MWWorld::ConstPtr& target);
 
@@ -81,6 +81,20 @@ namespace
         return 2 * std::max(realHalfExtents.x(), realHalfExtents.y());
     }
 
+    osg::Vec3f getLimitedPathEnd(const DetourNavigator::Navigator& navigator, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint)
+    {
+        const auto maxDistance = std::min(
+            navigator.getMaxNavmeshAreaRealRadius(),
+            static_cast<float>(Constants::CellSizeInUnits)
+        );
+        const auto startToEnd = endPoint - startPoint;
+        const auto distance = startToEnd.length();
+        if (distance <= maxDistance)
+            return endPoint;
+        return startPoint + startToEnd * maxDistance / distance;
+    }
+
     float getHeight(const MWWorld::ConstPtr& actor)
     {
         const auto world = MWBase::Environment::get().getWorld();
@@ -358,6 +372,7 @@ namespace MWMechanics
 
     void PathFinder::buildStraightPath(const osg::Vec3f& endPoint)
     {
+        mPendingPath.reset();
         mPath.clear();
         mPath.push_back(endPoint);
         mConstructed = true;
@@ -366,6 +381,7 @@ namespace MWMechanics
     void PathFinder::buildPathByPathgrid(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
         const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph)
     {
+        mPendingPath.reset();
         mPath.clear();
         mCell = cell;
 
@@ -378,11 +394,12 @@ namespace MWMechanics
         const osg::Vec3f& endPoint, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
         const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType)
     {
+        mPendingPath.reset();
         mPath.clear();
 
         // If it's not possible to build path over navmesh due to disabled navmesh generation fallback to straight path
         DetourNavigator::Status status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents, flags,
-            areaCosts, endTolerance, pathType, std::back_inserter(mPath));
+            areaCosts, endTolerance, pathType, false, std::back_inserter(mPath));
 
         if (status != DetourNavigator::Status::Success)
             mPath.clear();
@@ -398,6 +415,16 @@ namespace MWMechanics
         const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
         PathType pathType)
     {
+        buildPathImpl(actor, startPoint, endPoint, cell, pathgridGraph, halfExtents, flags, areaCosts, endTolerance,
+                      pathType, false);
+    }
+
+    void PathFinder::buildPathImpl(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+        const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts,
+        float endTolerance, PathType pathType, bool allowCoarsePath)
+    {
+        mPendingPath.reset();
         mPath.clear();
         mCell = cell;
 
@@ -406,15 +433,25 @@ namespace MWMechanics
         if (!actor.getClass().isPureWaterCreature(actor) && !actor.getClass().isPureFlyingCreature(actor))
         {
             status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents, flags, areaCosts,
-                                              endTolerance, pathType, std::back_inserter(mPath));
+                                              endTolerance, pathType, allowCoarsePath, std::back_inserter(mPath));
             if (status != DetourNavigator::Status::Success)
                 mPath.clear();
         }
 
+        buildPathFallback(status, actor, startPoint, endPoint, pathgridGraph, halfExtents, flags, areaCosts,
+                          endTolerance, pathType, allowCoarsePath);
+    }
+
+    void PathFinder::buildPathFallback(DetourNavigator::Status status, const MWWorld::ConstPtr& actor,
+        const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+        const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType, bool allowCoarsePath)
+    {
         if (status != DetourNavigator::Status::NavMeshNotFound && mPath.empty() && (flags & DetourNavigator::Flag_usePathgrid) == 0)
         {
             status = buildPathByNavigatorImpl(actor, startPoint, endPoint, halfExtents,
-                flags | DetourNavigator::Flag_usePathgrid, areaCosts, endTolerance, pathType, std::back_inserter(mPath));
+                flags | DetourNavigator::Flag_usePathgrid, areaCosts, endTolerance, pathType, allowCoarsePath,
+                std::back_inserter(mPath));
             if (status != DetourNavigator::Status::Success)
                 mPath.clear();
         }
@@ -430,14 +467,14 @@ namespace MWMechanics
 
     DetourNavigator::Status PathFinder::buildPathByNavigatorImpl(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
         const osg::Vec3f& endPoint, const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
-        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
+        const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType, bool allowCoarsePath,
         std::back_insert_iterator<std::deque<osg::Vec3f>> out)
     {
         const auto world = MWBase::Environment::get().getWorld();
         const auto stepSize = getPathStepSize(actor);
         const auto navigator = world->getNavigator();
         const auto status = DetourNavigator::findPath(*navigator, halfExtents, stepSize,
-            startPoint, endPoint, flags, areaCosts, endTolerance, out);
+            startPoint, endPoint, flags, areaCosts, endTolerance, allowCoarsePath, out);
 
         if (pathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
             return DetourNavigator::Status::Success;
@@ -499,16 +536,84 @@ namespace MWMechanics
         PathType pathType)
     {
         const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
-        const auto maxDistance = std::min(
-            navigator->getMaxNavmeshAreaRealRadius(),
-            static_cast<float>(Constants::CellSizeInUnits)
-        );
-        const auto startToEnd = endPoint - startPoint;
-        const auto distance = startToEnd.length();
-        if (distance <= maxDistance)
-            return buildPath(actor, startPoint, endPoint, cell, pathgridGraph, halfExtents, flags, areaCosts,
-                             endTolerance, pathType);
-        const auto end = startPoint + startToEnd * maxDistance / distance;
-        buildPath(actor, startPoint, end, cell, pathgridGraph, halfExtents, flags, areaCosts, endTolerance, pathType);
+        const auto end = getLimitedPathEnd(*navigator, startPoint, endPoint);
+        // Limited path is built again when actor approaches its end, so it may end on a route over tiles
+        buildPathImpl(actor, startPoint, end, cell, pathgridGraph, halfExtents, flags, areaCosts, endTolerance,
+                      pathType, true);
     }
+
+    void PathFinder::requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint,
+        const osg::Vec3f& endPoint, const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph,
+        const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts,
+        float endTolerance, PathType pathType, float priority)
+    {
+        if (actor.getClass().isPureWaterCreature(actor) || actor.getClass().isPureFlyingCreature(actor))
+            return buildLimitedPath(actor, startPoint, endPoint, cell, pathgridGraph, halfExtents, flags, areaCosts,
+                                    endTolerance, pathType);
+
+        const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+        const auto end = getLimitedPathEnd(*navigator, startPoint, endPoint);
+
+        DetourNavigator::PathQuery query;
+        query.mAgentHalfExtents = halfExtents;
+        query.mStepSize = getPathStepSize(actor);
+        query.mStart = startPoint;
+        query.mEnd = end;
+        query.mIncludeFlags = flags;
+        query.mAreaCosts = areaCosts;
+        query.mEndTolerance = endTolerance;
+        query.mAllowCoarsePath = true;
+
+        mPendingPath = PendingPath {navigator->findPathAsync(query, priority).share(), query, priority, cell, pathType};
+    }
+
+    bool PathFinder::applyPendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph)
+    {
+        if (!mPendingPath.has_value()
+            || mPendingPath->mResult.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return false;
+
+        PendingPath pending = std::move(*mPendingPath);
+        mPendingPath.reset();
+
+        const DetourNavigator::PathQueryResult& result = pending.mResult.get();
+        const DetourNavigator::PathQuery& query = pending.mQuery;
+        DetourNavigator::Status status = result.mStatus;
+        if (pending.mPathType == PathType::Partial && status == DetourNavigator::Status::PartialPath)
+            status = DetourNavigator::Status::Success;
+
+        if (status == DetourNavigator::Status::Success)
+        {
+            mPath.assign(result.mPath.begin(), result.mPath.end());
+            mCell = pending.mCell;
+            mConstructed = !mPath.empty();
+            return true;
+        }
+
+        Log(Debug::Debug) << "Build path by navigator error: \"" << DetourNavigator::getMessage(status)
+            << "\" for \"" << actor.getClass().getName(actor) << "\" (" << actor.getBase()
+            << ") from " << query.mStart << " to " << query.mEnd << " with flags ("
+            << DetourNavigator::WriteFlags {query.mIncludeFlags} << ")";
+
+        // Failed searches are the most expensive ones, don't repeat them on the main thread
+        if (status != DetourNavigator::Status::NavMeshNotFound
+            && (query.mIncludeFlags & DetourNavigator::Flag_usePathgrid) == 0)
+        {
+            pending.mQuery.mIncludeFlags = pending.mQuery.mIncludeFlags | DetourNavigator::Flag_usePathgrid;
+            const auto navigator = MWBase::Environment::get().getWorld()->getNavigator();
+            pending.mResult = navigator->findPathAsync(pending.mQuery, pending.mPriority).share();
+            mPendingPath = std::move(pending);
+            return false;
+        }
+
+        mPath.clear();
+        mCell = pending.mCell;
+
+        // Navigator is not used again because pathgrid is already allowed or there is no navmesh
+        buildPathFallback(status, actor, query.mStart, query.mEnd, pathgridGraph, query.mAgentHalfExtents,
+                          query.mIncludeFlags, query.mAreaCosts, query.mEndTolerance, pending.mPathType,
+                          query.mAllowCoarsePath);
+        return true;
+    }
+
 }
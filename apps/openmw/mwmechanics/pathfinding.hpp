@@ -3,8 +3,11 @@
 
 #include <deque>
 #include <cassert>
+#include <future>
 #include <iterator>
+#include <optional>
 
+#include <components/detournavigator/asyncpathfinder.hpp>
 #include <components/detournavigator/flags.hpp>
 #include <components/detournavigator/areatype.hpp>
 #include <components/detournavigator/status.hpp>
@@ -90,6 +93,7 @@ namespace MWMechanics
                 mConstructed = false;
                 mPath.clear();
                 mCell = nullptr;
+                mPendingPath.reset();
             }
 
             void buildStraightPath(const osg::Vec3f& endPoint);
@@ -114,6 +118,25 @@ namespace MWMechanics
                 const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
                 PathType pathType);
 
+            /// Same as buildLimitedPath but path over navmesh is searched by navigator worker threads. Current path
+            /// is kept until the result is applied by applyPendingPath.
+            /// \param priority paths with lower value are searched first
+            void requestLimitedPath(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
+                const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+                PathType pathType, float priority);
+
+            bool isPathPending() const
+            {
+                return mPendingPath.has_value();
+            }
+
+            /// Replace path by the result of requestLimitedPath if it's ready. When path over navmesh is not found
+            /// it's requested again with pathgrid allowed, like buildPath does, but by the worker threads. If that
+            /// fails too, the path is searched only over the pathgrid.
+            /// \return If path is replaced
+            bool applyPendingPath(const MWWorld::ConstPtr& actor, const PathgridGraph& pathgridGraph);
+
             /// Remove front point if exist and within tolerance
             void update(const osg::Vec3f& position, float pointTolerance, float destinationTolerance,
                         bool shortenIfAlmostStraight, bool canMoveByZ, const osg::Vec3f& halfExtents,
@@ -210,18 +233,40 @@ namespace MWMechanics
             }
 
         private:
+            struct PendingPath
+            {
+                std::shared_future<DetourNavigator::PathQueryResult> mResult;
+                DetourNavigator::PathQuery mQuery;
+                float mPriority;
+                const MWWorld::CellStore* mCell;
+                PathType mPathType;
+            };
+
             bool mConstructed;
             std::deque<osg::Vec3f> mPath;
 
             const MWWorld::CellStore* mCell;
 
+            std::optional<PendingPath> mPendingPath;
+
+            void buildPathImpl(const MWWorld::ConstPtr& actor, const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
+                const MWWorld::CellStore* cell, const PathgridGraph& pathgridGraph, const osg::Vec3f& halfExtents,
+                const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance,
+                PathType pathType, bool allowCoarsePath);
+
+            void buildPathFallback(DetourNavigator::Status status, const MWWorld::ConstPtr& actor,
+                const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const PathgridGraph& pathgridGraph,
+                const osg::Vec3f& halfExtents, const DetourNavigator::Flags flags,
+                const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
+                bool allowCoarsePath);
+
             void buildPathByPathgridImpl(const osg::Vec3f& startPoint, const osg::Vec3f& endPoint,
                 const PathgridGraph& pathgridGraph, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
 
             [[nodiscard]] DetourNavigator::Status buildPathByNavigatorImpl(const MWWorld::ConstPtr& actor,
                 const osg::Vec3f& startPoint, const osg::Vec3f& endPoint, const osg::Vec3f& halfExtents,
                 const DetourNavigator::Flags flags, const DetourNavigator::AreaCosts& areaCosts, float endTolerance, PathType pathType,
-                std::back_insert_iterator<std::deque<osg::Vec3f>> out);
+                bool allowCoarsePath, std::back_insert_iterator<std::deque<osg::Vec3f>> out);
     };
 }
 
@@ -6,6 +6,7 @@
 #include <osg/Stats>
 
 #include "components/debug/debuglog.hpp"
+#include "components/debug/tracerecorder.hpp"
 #include <components/misc/barrier.hpp>
 #include "components/misc/convert.hpp"
 #include "components/settings/settings.hpp"
@@ -627,6 +628,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::worker()
     {
+        Debug::TraceRecorder::instance().setThreadName("Physics");
         std::size_t lastFrame = 0;
         std::shared_lock lock(mSimulationMutex);
         while (!mQuit)
@@ -666,6 +668,7 @@ namespace MWPhysics
 
     void PhysicsTaskScheduler::doSimulation()
     {
+        const Debug::TraceZone zone("Physics", "Simulation");
         while (mRemainingSteps)
         {
             mPreStepBarrier->wait([this] { afterPreStep(); });
@@ -360,6 +360,10 @@ public:
     /// 0 = Inactive, 1 = Active in place, 2 = Active
     void setActive(int active);
 
+    /// Update the object skeleton, if one exists, only every \a interval frames.
+    /// @see SceneUtil::Skeleton::setUpdateInterval
+    void setUpdateInterval(unsigned int interval);
+
     osg::Group* getOrCreateObjectRoot();
 
     osg::Group* getObjectRoot();
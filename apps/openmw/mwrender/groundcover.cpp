@@ -111,12 +111,19 @@ namespace MWRender
         osg::BoundingBox mBox;
     };
 
-    inline bool isInChunkBorders(ESM::CellRef& ref, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    class GroundcoverCell : public osg::Object
     {
-        osg::Vec2f size = maxBound - minBound;
-        if (size.x() >=1 && size.y() >=1) return true;
+    public:
+        GroundcoverCell() {}
+        GroundcoverCell(const GroundcoverCell& copy, const osg::CopyOp&) : mInstances(copy.mInstances) {}
+        META_Object(MWRender, GroundcoverCell)
+        // Instances are grouped by model, so chunks copy contiguous ranges.
+        Groundcover::InstanceMap mInstances;
+    };
 
-        osg::Vec3f pos = ref.mPos.asVec3();
+    inline bool isInChunkBorders(const ESM::Position& position, osg::Vec2f& minBound, osg::Vec2f& maxBound)
+    {
+        osg::Vec3f pos = position.asVec3();
         osg::Vec3f cellPos = pos / ESM::Land::REAL_SIZE;
         if ((minBound.x() > std::floor(minBound.x()) && cellPos.x() < minBound.x()) || (minBound.y() > std::floor(minBound.y()) && cellPos.y() < minBound.y())
             || (maxBound.x() < std::ceil(maxBound.x()) && cellPos.x() >= maxBound.x()) || (maxBound.y() < std::ceil(maxBound.y()) && cellPos.y() >= maxBound.y()))
@@ -136,8 +143,12 @@ namespace MWRender
         else
         {
             InstanceMap instances;
-            collectInstances(instances, size, center);
+            std::vector<osg::ref_ptr<osg::Object>> cells;
+            collectInstances(instances, size, center, cells);
             osg::ref_ptr<osg::Node> node = createChunk(instances, center);
+            // Keep instances of used cells in cache while the chunk exists
+            for (const osg::ref_ptr<osg::Object>& cell : cells)
+                node->getOrCreateUserDataContainer()->addUserObject(cell);
             mCache->addEntryToObjectCache(id, node.get());
             return node;
         }
@@ -149,6 +160,7 @@ namespace MWRender
          , mDensity(density)
          , mStateset(new osg::StateSet)
          , mGroundcoverStore(store)
+         , mCellCache(new Resource::GenericObjectCache<std::pair<int, int>>)
     {
          setViewDistance(viewDistance);
          // MGE uses default alpha settings for groundcover, so we can not rely on alpha properties
@@ -169,53 +181,88 @@ namespace MWRender
     {
     }
 
-    void Groundcover::collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center)
+    void Groundcover::collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center, std::vector<osg::ref_ptr<osg::Object>>& cells)
     {
         if (mDensity <=0.f) return;
 
         osg::Vec2f minBound = (center - osg::Vec2f(size/2.f, size/2.f));
         osg::Vec2f maxBound = (center + osg::Vec2f(size/2.f, size/2.f));
-        DensityCalculator calculator(mDensity);
-        std::vector<ESM::ESMReader> esm;
+        const bool wholeCells = size >= 1;
         osg::Vec2i startCell = osg::Vec2i(std::floor(center.x() - size/2.f), std::floor(center.y() - size/2.f));
         for (int cellX = startCell.x(); cellX < startCell.x() + size; ++cellX)
         {
             for (int cellY = startCell.y(); cellY < startCell.y() + size; ++cellY)
             {
-                ESM::Cell cell;
-                mGroundcoverStore.initCell(cell, cellX, cellY);
-                if (cell.mContextList.empty()) continue;
+                osg::ref_ptr<osg::Object> cell = getCellInstances(cellX, cellY);
+                const InstanceMap& cellInstances = static_cast<const GroundcoverCell*>(cell.get())->mInstances;
+                if (cellInstances.empty()) continue;
+                cells.push_back(cell);
 
-                calculator.reset();
-                std::map<ESM::RefNum, ESM::CellRef> refs;
-                for (size_t i=0; i<cell.mContextList.size(); ++i)
+                for (const auto& pair : cellInstances)
                 {
-                    unsigned int index = cell.mContextList[i].index;
-                    if (esm.size() <= index)
-                        esm.resize(index+1);
-                    cell.restore(esm[index], i);
-                    ESM::CellRef ref;
-                    ref.mRefNum.unset();
-                    bool deleted = false;
-                    while(cell.getNextRef(esm[index], ref, deleted))
+                    std::vector<GroundcoverEntry>& modelInstances = instances[pair.first];
+                    if (wholeCells)
                     {
-                        if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled()) deleted = true;
-                        if (!deleted && !isInChunkBorders(ref, minBound, maxBound)) deleted = true;
-
-                        if (deleted) { refs.erase(ref.mRefNum); continue; }
-                        refs[ref.mRefNum] = std::move(ref);
+                        modelInstances.insert(modelInstances.end(), pair.second.begin(), pair.second.end());
+                        continue;
                     }
+                    for (const GroundcoverEntry& entry : pair.second)
+                        if (isInChunkBorders(entry.mPos, minBound, maxBound))
+                            modelInstances.push_back(entry);
                 }
+            }
+        }
+    }
 
-                for (auto& pair : refs)
-                {
-                    ESM::CellRef& ref = pair.second;
-                    const std::string& model = mGroundcoverStore.getGroundcoverModel(ref.mRefID);
-                    if (!model.empty())
-                        instances[model].emplace_back(std::move(ref));
-                }
+    osg::ref_ptr<osg::Object> Groundcover::getCellInstances(int cellX, int cellY)
+    {
+        const std::pair<int, int> id(cellX, cellY);
+        osg::ref_ptr<osg::Object> obj = mCellCache->getRefFromObjectCache(id);
+        if (obj)
+            return obj;
+        obj = loadCellInstances(cellX, cellY);
+        mCellCache->addEntryToObjectCache(id, obj.get());
+        return obj;
+    }
+
+    osg::ref_ptr<osg::Object> Groundcover::loadCellInstances(int cellX, int cellY) const
+    {
+        osg::ref_ptr<GroundcoverCell> result = new GroundcoverCell;
+
+        ESM::Cell cell;
+        mGroundcoverStore.initCell(cell, cellX, cellY);
+        if (cell.mContextList.empty())
+            return result;
+
+        DensityCalculator calculator(mDensity);
+        std::vector<ESM::ESMReader> esm;
+        std::map<ESM::RefNum, ESM::CellRef> refs;
+        for (size_t i=0; i<cell.mContextList.size(); ++i)
+        {
+            unsigned int index = cell.mContextList[i].index;
+            if (esm.size() <= index)
+                esm.resize(index+1);
+            cell.restore(esm[index], i);
+            ESM::CellRef ref;
+            ref.mRefNum.unset();
+            bool deleted = false;
+            while(cell.getNextRef(esm[index], ref, deleted))
+            {
+                if (!deleted && refs.find(ref.mRefNum) == refs.end() && !calculator.isInstanceEnabled()) deleted = true;
+
+                if (deleted) { refs.erase(ref.mRefNum); continue; }
+                refs[ref.mRefNum] = std::move(ref);
             }
         }
+
+        for (auto& pair : refs)
+        {
+            ESM::CellRef& ref = pair.second;
+            const std::string& model = mGroundcoverStore.getGroundcoverModel(ref.mRefID);
+            if (!model.empty())
+                result->mInstances[model].emplace_back(ref);
+        }
+        return result;
     }
 
     osg::ref_ptr<osg::Node> Groundcover::createChunk(InstanceMap& instances, const osg::Vec2f& center)
@@ -258,5 +305,19 @@ namespace MWRender
     void Groundcover::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Groundcover Chunk", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Groundcover Cell", mCellCache->getCacheSize());
+    }
+
+    void Groundcover::updateCache(double referenceTime)
+    {
+        GenericResourceManager<GroundcoverChunkId>::updateCache(referenceTime);
+        mCellCache->updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
+        mCellCache->removeExpiredObjectsInCache(referenceTime - mExpiryDelay);
+    }
+
+    void Groundcover::clearCache()
+    {
+        GenericResourceManager<GroundcoverChunkId>::clearCache();
+        mCellCache->clear();
     }
 }
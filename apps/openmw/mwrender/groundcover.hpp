@@ -30,6 +30,10 @@ namespace MWRender
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        void updateCache(double referenceTime) override;
+
+        void clearCache() override;
+
         struct GroundcoverEntry
         {
             ESM::Position mPos;
@@ -39,6 +43,8 @@ namespace MWRender
             {}
         };
 
+        typedef std::map<std::string, std::vector<GroundcoverEntry>> InstanceMap;
+
     private:
         Resource::SceneManager* mSceneManager;
         float mDensity;
@@ -46,9 +52,13 @@ namespace MWRender
         osg::ref_ptr<osg::Program> mProgramTemplate;
         const MWWorld::GroundcoverStore& mGroundcoverStore;
 
-        typedef std::map<std::string, std::vector<GroundcoverEntry>> InstanceMap;
+        // Instances of exterior cells after density filtering, so chunks don't need to read plugins again.
+        osg::ref_ptr<Resource::GenericObjectCache<std::pair<int, int>>> mCellCache;
+
         osg::ref_ptr<osg::Node> createChunk(InstanceMap& instances, const osg::Vec2f& center);
-        void collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center);
+        void collectInstances(InstanceMap& instances, float size, const osg::Vec2f& center, std::vector<osg::ref_ptr<osg::Object>>& cells);
+        osg::ref_ptr<osg::Object> getCellInstances(int cellX, int cellY);
+        osg::ref_ptr<osg::Object> loadCellInstances(int cellX, int cellY) const;
     };
 }
 
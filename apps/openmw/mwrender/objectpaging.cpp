@@ -379,9 +379,10 @@ namespace MWRender
         }
     };
 
-    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager)
+    ObjectPaging::ObjectPaging(Resource::SceneManager* sceneManager, std::shared_ptr<Misc::TaskScheduler> taskScheduler)
             : GenericResourceManager<ChunkId>(nullptr)
          , mSceneManager(sceneManager)
+         , mTaskScheduler(std::move(taskScheduler))
          , mRefTrackerLocked(false)
     {
         mActiveGrid = Settings::Manager::getBool("object paging active grid", "Terrain");
@@ -671,10 +672,17 @@ namespace MWRender
                 optimizer.setMergeAlphaBlending(true);
             }
             optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+            optimizer.setTaskScheduler(mTaskScheduler.get());
             unsigned int options = SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS|SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES|SceneUtil::Optimizer::MERGE_GEOMETRY;
 
             optimizer.optimize(mergeGroup, options);
 
+            {
+                std::lock_guard<std::mutex> lock(mPassTimesMutex);
+                for (const auto& [pass, time] : optimizer.getPassTimes())
+                    mPassTimes[pass] += time;
+            }
+
             group->addChild(mergeGroup);
 
             if (mDebugBatches)
@@ -842,6 +850,15 @@ namespace MWRender
     void ObjectPaging::reportStats(unsigned int frameNumber, osg::Stats *stats) const
     {
         stats->setAttribute(frameNumber, "Object Chunk", mCache->getCacheSize());
+
+        std::map<unsigned int, double> passTimes;
+        {
+            std::lock_guard<std::mutex> lock(mPassTimesMutex);
+            passTimes.swap(mPassTimes);
+        }
+        stats->setAttribute(frameNumber, "Object Chunk Flatten", passTimes[SceneUtil::Optimizer::FLATTEN_STATIC_TRANSFORMS] * 1000);
+        stats->setAttribute(frameNumber, "Object Chunk Nodes", passTimes[SceneUtil::Optimizer::REMOVE_REDUNDANT_NODES] * 1000);
+        stats->setAttribute(frameNumber, "Object Chunk Merge", passTimes[SceneUtil::Optimizer::MERGE_GEOMETRY] * 1000);
     }
 
 }
@@ -5,12 +5,18 @@
 #include <components/resource/resourcemanager.hpp>
 #include <components/esm3/loadcell.hpp>
 
+#include <map>
+#include <memory>
 #include <mutex>
 
 namespace Resource
 {
     class SceneManager;
 }
+namespace Misc
+{
+    class TaskScheduler;
+}
 namespace MWWorld
 {
     class ESMStore;
@@ -24,7 +30,7 @@ namespace MWRender
     class ObjectPaging : public Resource::GenericResourceManager<ChunkId>, public Terrain::QuadTreeWorld::ChunkManager
     {
     public:
-        ObjectPaging(Resource::SceneManager* sceneManager);
+        ObjectPaging(Resource::SceneManager* sceneManager, std::shared_ptr<Misc::TaskScheduler> taskScheduler);
         ~ObjectPaging() = default;
 
         osg::ref_ptr<osg::Node> getChunk(float size, const osg::Vec2f& center, unsigned char lod, unsigned int lodFlags, bool activeGrid, const osg::Vec3f& viewPoint, bool compile) override;
@@ -51,6 +57,7 @@ namespace MWRender
 
     private:
         Resource::SceneManager* mSceneManager;
+        std::shared_ptr<Misc::TaskScheduler> mTaskScheduler;
         bool mActiveGrid;
         bool mDebugBatches;
         float mMergeFactor;
@@ -75,6 +82,10 @@ namespace MWRender
         std::mutex mSizeCacheMutex;
         typedef std::map<ESM::RefNum, float> SizeCache;
         SizeCache mSizeCache;
+
+        // Time spent by optimizer passes of chunks created since the last reportStats call.
+        mutable std::mutex mPassTimesMutex;
+        mutable std::map<unsigned int, double> mPassTimes;
     };
 
     class RefnumMarker : public osg::Object
@@ -0,0 +1,203 @@
+#include "bytecodecache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <extern/smhasher/MurmurHash3.h>
+
+#include <components/debug/debuglog.hpp>
+#include <components/misc/endianness.hpp>
+
+namespace MWScript
+{
+    namespace
+    {
+        const std::uint32_t sMagic = 0x4243534f; // "OSCB"
+        const std::uint32_t sFormatVersion = 2;
+        const std::uint32_t sMaxCount = 1 << 24;
+        const char sLocalTypes[] = { 's', 'l', 'f' };
+
+        ScriptHash getHash (const std::string& data, const ScriptHash& seed)
+        {
+            ScriptHash hash {0, 0};
+            MurmurHash3_x64_128(data.data(), static_cast<int>(data.size()), seed.data(), hash.data());
+            return hash;
+        }
+
+        template <class T>
+        void write (std::ostream& stream, T value)
+        {
+            value = Misc::toLittleEndian(value);
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void write (std::ostream& stream, const std::string& value)
+        {
+            write(stream, static_cast<std::uint32_t>(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        void write (std::ostream& stream, const ScriptHash& value)
+        {
+            write(stream, value[0]);
+            write(stream, value[1]);
+        }
+
+        template <class T>
+        T read (std::istream& stream)
+        {
+            T value;
+            stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return Misc::fromLittleEndian(value);
+        }
+
+        std::uint32_t readCount (std::istream& stream)
+        {
+            const std::uint32_t count = read<std::uint32_t>(stream);
+            if (count > sMaxCount)
+                throw std::runtime_error("invalid element count " + std::to_string(count));
+            return count;
+        }
+
+        std::string readString (std::istream& stream)
+        {
+            std::string value(readCount(stream), '\0');
+            stream.read(value.data(), value.size());
+            return value;
+        }
+
+        ScriptHash readHash (std::istream& stream)
+        {
+            ScriptHash value;
+            value[0] = read<std::uint64_t>(stream);
+            value[1] = read<std::uint64_t>(stream);
+            return value;
+        }
+    }
+
+    ScriptHash getScriptHash (const std::string& text)
+    {
+        return getHash(text, ScriptHash {0, 0});
+    }
+
+    BytecodeCache::BytecodeCache (const std::string& path, const std::vector<std::string>& contentFilePaths,
+        const ScriptHash& extensionsHash)
+    : mPath (path), mChanged (false)
+    {
+        std::string environment = std::to_string(sFormatVersion) + '\n';
+        for (const std::string& file : contentFilePaths)
+        {
+            environment += file;
+            std::error_code ec;
+            const std::uintmax_t size = std::filesystem::file_size(file, ec);
+            if (!ec)
+                environment += ' ' + std::to_string(size);
+            const std::filesystem::file_time_type time = std::filesystem::last_write_time(file, ec);
+            if (!ec)
+                environment += ' ' + std::to_string(time.time_since_epoch().count());
+            environment += '\n';
+        }
+        mEnvironmentHash = getHash(environment, extensionsHash);
+    }
+
+    void BytecodeCache::load()
+    {
+        mEntries.clear();
+        mChanged = false;
+
+        std::ifstream stream (mPath, std::ios::binary);
+        if (!stream.is_open())
+            return;
+
+        try
+        {
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+
+            if (read<std::uint32_t>(stream) != sMagic || read<std::uint32_t>(stream) != sFormatVersion
+                || readHash(stream) != mEnvironmentHash)
+            {
+                Log(Debug::Info) << "Script bytecode cache \"" << mPath << "\" is out of date";
+                return;
+            }
+
+            const std::uint32_t count = readCount(stream);
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const std::string name = readString(stream);
+                Entry entry;
+                entry.mTextHash = readHash(stream);
+                entry.mByteCode.resize(readCount(stream));
+                for (Interpreter::Type_Code& code : entry.mByteCode)
+                    code = read<std::uint32_t>(stream);
+                for (char type : sLocalTypes)
+                {
+                    const std::uint32_t locals = readCount(stream);
+                    for (std::uint32_t j = 0; j < locals; ++j)
+                        entry.mLocals.declare(type, readString(stream));
+                }
+                mEntries.emplace(name, std::move(entry));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read script bytecode cache \"" << mPath << "\": " << e.what();
+            mEntries.clear();
+            return;
+        }
+
+        Log(Debug::Info) << "Loaded " << mEntries.size() << " compiled scripts from \"" << mPath << "\"";
+    }
+
+    void BytecodeCache::save()
+    {
+        if (!mChanged)
+            return;
+
+        try
+        {
+            std::ofstream stream (mPath, std::ios::binary | std::ios::trunc);
+            stream.exceptions(std::ios::failbit | std::ios::badbit);
+
+            write(stream, sMagic);
+            write(stream, sFormatVersion);
+            write(stream, mEnvironmentHash);
+            write(stream, static_cast<std::uint32_t>(mEntries.size()));
+            for (const auto& [name, entry] : mEntries)
+            {
+                write(stream, name);
+                write(stream, entry.mTextHash);
+                write(stream, static_cast<std::uint32_t>(entry.mByteCode.size()));
+                for (Interpreter::Type_Code code : entry.mByteCode)
+                    write(stream, static_cast<std::uint32_t>(code));
+                for (char type : sLocalTypes)
+                {
+                    const std::vector<std::string>& locals = entry.mLocals.get(type);
+                    write(stream, static_cast<std::uint32_t>(locals.size()));
+                    for (const std::string& local : locals)
+                        write(stream, local);
+                }
+            }
+            mChanged = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write script bytecode cache \"" << mPath << "\": " << e.what();
+        }
+    }
+
+    const BytecodeCache::Entry *BytecodeCache::find (const std::string& name, const ScriptHash& textHash) const
+    {
+        const auto it = mEntries.find(name);
+        if (it == mEntries.end() || it->second.mTextHash != textHash)
+            return nullptr;
+        return &it->second;
+    }
+
+    void BytecodeCache::insert (const std::string& name, const ScriptHash& textHash,
+        const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals)
+    {
+        mEntries[name] = Entry {textHash, code, locals};
+        mChanged = true;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef GAME_SCRIPT_BYTECODECACHE_H
+#define GAME_SCRIPT_BYTECODECACHE_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <components/compiler/locals.hpp>
+#include <components/interpreter/types.hpp>
+
+namespace MWScript
+{
+    typedef std::array<std::uint64_t, 2> ScriptHash;
+
+    ScriptHash getScriptHash (const std::string& text);
+
+    /// \brief Compiled scripts persisted across sessions
+    ///
+    /// Entries are keyed by script name and the hash of the script text. The whole cache is
+    /// discarded when the content file list, any content file or the compiler extensions change.
+    /// Compiled code depends on more than the script text: e.g. types of global variables and
+    /// locals of other scripts come from the content files, which are compared by size and
+    /// modification time.
+    class BytecodeCache
+    {
+        public:
+
+            struct Entry
+            {
+                ScriptHash mTextHash;
+                std::vector<Interpreter::Type_Code> mByteCode;
+                Compiler::Locals mLocals;
+            };
+
+            BytecodeCache (const std::string& path, const std::vector<std::string>& contentFilePaths,
+                const ScriptHash& extensionsHash);
+            ///< \param contentFilePaths Full paths of the content files in the load order.
+
+            void load();
+            ///< Read the cache file, ignoring it if it is missing, corrupted or out of date.
+
+            void save();
+            ///< Write the cache file if anything was added since loading.
+
+            const Entry *find (const std::string& name, const ScriptHash& textHash) const;
+
+            void insert (const std::string& name, const ScriptHash& textHash,
+                const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals);
+
+        private:
+
+            std::string mPath;
+            ScriptHash mEnvironmentHash;
+            std::map<std::string, Entry> mEntries;
+            bool mChanged;
+    };
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <components/compiler/locals.hpp>
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracerecorder.hpp>
 
 #include <components/interpreter/interpreter.hpp>
 #include <components/interpreter/runtime.hpp>
@@ -1614,6 +1615,49 @@ namespace MWScript
                 }
         };
 
+        class OpDumpLuaProfile : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(MWBase::Environment::get().getLuaManager()->dumpProfilerReport());
+                }
+        };
+
+        class OpDumpScriptProfile : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    runtime.getContext().report(MWBase::Environment::get().getScriptManager()->dumpLocalScriptsProfile());
+                }
+        };
+
+        class OpSaveTrace : public Interpreter::Opcode0
+        {
+            public:
+
+                void execute (Interpreter::Runtime& runtime) override
+                {
+                    const Debug::TraceRecorder& recorder = Debug::TraceRecorder::instance();
+                    if (!recorder.isEnabled())
+                    {
+                        runtime.getContext().report("Trace recording is disabled, see 'trace events per thread' setting");
+                        return;
+                    }
+                    try
+                    {
+                        runtime.getContext().report("Trace is saved to " + recorder.save().string());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        runtime.getContext().report(e.what());
+                    }
+                }
+        };
+
         void installOpcodes (Interpreter::Interpreter& interpreter)
         {
             interpreter.installSegment5<OpMenuMode>(Compiler::Misc::opcodeMenuMode);
@@ -1735,6 +1779,9 @@ namespace MWScript
             interpreter.installSegment5<OpToggleRecastMesh>(Compiler::Misc::opcodeToggleRecastMesh);
             interpreter.installSegment5<OpHelp>(Compiler::Misc::opcodeHelp);
             interpreter.installSegment5<OpReloadLua>(Compiler::Misc::opcodeReloadLua);
+            interpreter.installSegment5<OpDumpLuaProfile>(Compiler::Misc::opcodeDumpLuaProfile);
+            interpreter.installSegment5<OpDumpScriptProfile>(Compiler::Misc::opcodeDumpScriptProfile);
+            interpreter.installSegment5<OpSaveTrace>(Compiler::Misc::opcodeSaveTrace);
         }
     }
 }
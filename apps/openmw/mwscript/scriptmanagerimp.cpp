@@ -1,9 +1,13 @@
 #include "scriptmanagerimp.hpp"
 
 #include <cassert>
+#include <chrono>
 #include <sstream>
 #include <exception>
 #include <algorithm>
+#include <iomanip>
+
+#include <osg/Stats>
 
 #include <components/debug/debuglog.hpp>
 
@@ -11,24 +15,65 @@
 
 #include <components/misc/stringops.hpp>
 
+#include <components/settings/settings.hpp>
+
 #include <components/compiler/scanner.hpp>
 #include <components/compiler/context.hpp>
 #include <components/compiler/exception.hpp>
 #include <components/compiler/quickfileparser.hpp>
+#include <components/compiler/opcodes.hpp>
 
 #include "../mwworld/esmstore.hpp"
+#include "../mwworld/localscripts.hpp"
 
 #include "extensions.hpp"
 #include "interpretercontext.hpp"
 
 namespace MWScript
 {
+    namespace
+    {
+        bool dependsOnFrame (const std::vector<Interpreter::Type_Code>& code)
+        {
+            // Functions reading the frame duration or events that are only visible for one frame
+            static const std::set<int> opcodes {
+                Compiler::Misc::opcodeGetSecondsPassed,
+                Compiler::Misc::opcodeOnActivate, Compiler::Misc::opcodeOnActivateExplicit,
+                Compiler::Stats::opcodeOnDeath, Compiler::Stats::opcodeOnDeathExplicit,
+                Compiler::Stats::opcodeOnMurder, Compiler::Stats::opcodeOnMurderExplicit,
+                Compiler::Stats::opcodeOnKnockout, Compiler::Stats::opcodeOnKnockoutExplicit,
+                Compiler::Transformation::opcodeMove, Compiler::Transformation::opcodeMoveExplicit,
+                Compiler::Transformation::opcodeMoveWorld, Compiler::Transformation::opcodeMoveWorldExplicit,
+                Compiler::Transformation::opcodeRotate, Compiler::Transformation::opcodeRotateExplicit,
+                Compiler::Transformation::opcodeRotateWorld, Compiler::Transformation::opcodeRotateWorldExplicit,
+            };
+
+            if (code.size() < 4)
+                return false;
+
+            const std::size_t end = std::min<std::size_t> (code.size(), 4 + code[0]);
+            for (std::size_t i = 4; i < end; ++i)
+                if ((code[i] >> 26) == 0x32 && opcodes.count (code[i] & 0x3ffffff))
+                    return true;
+
+            return false;
+        }
+    }
+
+    ScriptManager::CompiledScript::CompiledScript(const std::vector<Interpreter::Type_Code>& code,
+        const Compiler::Locals& locals)
+    : mByteCode(code), mLocals(locals), mCanBeDeferred(!dependsOnFrame(code))
+    {}
+
     ScriptManager::ScriptManager (const MWWorld::ESMStore& store,
         Compiler::Context& compilerContext, int warningsMode,
-        const std::vector<std::string>& scriptBlacklist)
+        const std::vector<std::string>& scriptBlacklist, std::unique_ptr<BytecodeCache> bytecodeCache)
     : mErrorHandler(), mStore (store),
       mCompilerContext (compilerContext), mParser (mErrorHandler, mCompilerContext),
-      mOpcodesInstalled (false), mGlobalScripts (store)
+      mOpcodesInstalled (false), mGlobalScripts (store), mBytecodeCache (std::move(bytecodeCache)),
+      mLocalScriptsBudget (Settings::Manager::getFloat("local scripts budget", "Game") / 1000.0),
+      mMaxDeferredFrames (static_cast<unsigned int>(std::max(1, Settings::Manager::getInt("local scripts max deferred frames", "Game")))),
+      mLocalScriptsFrame (0)
     {
         mErrorHandler.setWarningsMode (warningsMode);
 
@@ -39,6 +84,12 @@ namespace MWScript
         std::sort (mScriptBlacklist.begin(), mScriptBlacklist.end());
     }
 
+    ScriptManager::~ScriptManager()
+    {
+        if (mBytecodeCache)
+            mBytecodeCache->save();
+    }
+
     bool ScriptManager::compile (const std::string& name)
     {
         mParser.reset();
@@ -46,6 +97,17 @@ namespace MWScript
 
         if (const ESM::Script *script = mStore.get<ESM::Script>().find (name))
         {
+            ScriptHash textHash {0, 0};
+            if (mBytecodeCache)
+            {
+                textHash = getScriptHash (script->mScriptText);
+                if (const BytecodeCache::Entry *cached = mBytecodeCache->find (name, textHash))
+                {
+                    mScripts.emplace(name, CompiledScript(cached->mByteCode, cached->mLocals));
+                    return true;
+                }
+            }
+
             mErrorHandler.setContext(name);
 
             bool Success = true;
@@ -82,6 +144,9 @@ namespace MWScript
                 mParser.getCode(code);
                 mScripts.emplace(name, CompiledScript(code, mParser.getLocals()));
 
+                if (mBytecodeCache)
+                    mBytecodeCache->insert (name, textHash, code, mParser.getLocals());
+
                 return true;
             }
         }
@@ -119,7 +184,12 @@ namespace MWScript
                     mOpcodesInstalled = true;
                 }
 
-                mInterpreter.run (&iter->second.mByteCode[0], iter->second.mByteCode.size(), interpreterContext);
+                CompiledScript& script = iter->second;
+
+                if (script.mProgram.empty())
+                    script.mProgram = mInterpreter.decode (script.mByteCode.data(), script.mByteCode.size());
+
+                mInterpreter.run (script.mProgram, script.mByteCode.data(), script.mByteCode.size(), interpreterContext);
                 return true;
             }
             catch (const MissingImplicitRefError& e)
@@ -135,6 +205,69 @@ namespace MWScript
         return false;
     }
 
+    bool ScriptManager::canBeDeferred (const std::string& name) const
+    {
+        const auto iter = mScripts.find (name);
+        return iter != mScripts.end() && iter->second.mCanBeDeferred;
+    }
+
+    void ScriptManager::runLocalScripts (MWWorld::LocalScripts& localScripts)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        ++mLocalScriptsFrame;
+        mLocalScriptsStats = LocalScriptsStats {};
+
+        const bool allowDeferring = mLocalScriptsBudget > 0 && mMaxDeferredFrames > 1;
+        const Clock::time_point start = Clock::now();
+        std::size_t index = 0;
+
+        localScripts.startIteration();
+        std::pair<std::string, MWWorld::Ptr> script;
+        while (localScripts.getNext(script))
+        {
+            // Once the budget is spent deferrable scripts run only every mMaxDeferredFrames frames,
+            // the index spreads them evenly across the frames.
+            const std::size_t scriptIndex = index++;
+            if (allowDeferring && (scriptIndex + mLocalScriptsFrame) % mMaxDeferredFrames != 0
+                && std::chrono::duration<double>(Clock::now() - start).count() > mLocalScriptsBudget
+                && canBeDeferred (script.first))
+            {
+                ++mLocalScriptsStats.mDeferred;
+                continue;
+            }
+
+            MWScript::InterpreterContext interpreterContext (
+                &script.second.getRefData().getLocals(), script.second);
+
+            const Clock::time_point scriptStart = Clock::now();
+            run (script.first, interpreterContext);
+            const double time = std::chrono::duration<double>(Clock::now() - scriptStart).count();
+
+            ++mLocalScriptsStats.mExecuted;
+
+            const auto iter = mScripts.find (script.first);
+            if (iter == mScripts.end())
+                continue;
+            // The same script may run for several objects
+            CompiledScript& compiled = iter->second;
+            if (compiled.mProfileFrame != mLocalScriptsFrame)
+            {
+                compiled.mProfileFrame = mLocalScriptsFrame;
+                compiled.mFrameTime = 0;
+            }
+            compiled.mFrameTime += time;
+            compiled.mMaxFrameTime = std::max(compiled.mMaxFrameTime, compiled.mFrameTime);
+            compiled.mTotalTime += time;
+            ++compiled.mRuns;
+            if (compiled.mFrameTime > mLocalScriptsStats.mSlowestTime)
+            {
+                mLocalScriptsStats.mSlowestTime = compiled.mFrameTime;
+                mLocalScriptsStats.mSlowest = &iter->first;
+            }
+        }
+    }
+
     void ScriptManager::clear()
     {
         for (auto& script : mScripts)
@@ -162,6 +295,9 @@ namespace MWScript
             }
         }
 
+        if (mBytecodeCache)
+            mBytecodeCache->save();
+
         return std::make_pair (count, success);
     }
 
@@ -224,4 +360,39 @@ namespace MWScript
     {
         return *mCompilerContext.getExtensions();
     }
+
+    void ScriptManager::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Script Local", mLocalScriptsStats.mExecuted);
+        stats.setAttribute(frameNumber, "Script Deferred", mLocalScriptsStats.mDeferred);
+        stats.setAttribute(frameNumber, "Script Slowest", mLocalScriptsStats.mSlowestTime * 1000);
+    }
+
+    std::string ScriptManager::dumpLocalScriptsProfile() const
+    {
+        constexpr std::size_t maxScripts = 20;
+
+        std::vector<ScriptCollection::const_iterator> scripts;
+        for (auto iter = mScripts.begin(); iter != mScripts.end(); ++iter)
+            if (iter->second.mRuns > 0)
+                scripts.push_back(iter);
+        const std::size_t count = std::min(scripts.size(), maxScripts);
+        std::partial_sort(scripts.begin(), scripts.begin() + count, scripts.end(),
+            [] (ScriptCollection::const_iterator lhs, ScriptCollection::const_iterator rhs)
+            { return lhs->second.mTotalTime > rhs->second.mTotalTime; });
+
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3);
+        if (mLocalScriptsStats.mSlowest != nullptr)
+            stream << "Slowest local script in the last frame: " << *mLocalScriptsStats.mSlowest
+                   << " " << mLocalScriptsStats.mSlowestTime * 1000 << " ms\n";
+        stream << "Local scripts by total time (total ms, runs, average ms, max per frame ms):";
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const CompiledScript& script = scripts[i]->second;
+            stream << "\n" << scripts[i]->first << ": " << script.mTotalTime * 1000 << ", " << script.mRuns
+                   << ", " << script.mTotalTime * 1000 / script.mRuns << ", " << script.mMaxFrameTime * 1000;
+        }
+        return stream.str();
+    }
 }
@@ -2,6 +2,7 @@
 #define GAME_SCRIPT_SCRIPTMANAGER_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -14,6 +15,7 @@
 #include "../mwbase/scriptmanager.hpp"
 
 #include "globalscripts.hpp"
+#include "bytecodecache.hpp"
 
 namespace MWWorld
 {
@@ -45,12 +47,27 @@ namespace MWScript
             struct CompiledScript
             {
                 std::vector<Interpreter::Type_Code> mByteCode;
+                Interpreter::Program mProgram; // decoded from mByteCode on first execution
                 Compiler::Locals mLocals;
                 std::set<std::string> mInactive;
+                bool mCanBeDeferred;
 
-                CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals):
-                    mByteCode(code), mLocals(locals)
-                {}
+                // Local script profile, mFrameTime is the time spent in frame mProfileFrame
+                unsigned int mProfileFrame = 0;
+                double mFrameTime = 0;
+                double mMaxFrameTime = 0;
+                double mTotalTime = 0;
+                std::size_t mRuns = 0;
+
+                CompiledScript(const std::vector<Interpreter::Type_Code>& code, const Compiler::Locals& locals);
+            };
+
+            struct LocalScriptsStats
+            {
+                std::size_t mExecuted = 0;
+                std::size_t mDeferred = 0;
+                double mSlowestTime = 0;
+                const std::string* mSlowest = nullptr;
             };
 
             typedef std::map<std::string, CompiledScript> ScriptCollection;
@@ -59,18 +76,33 @@ namespace MWScript
             GlobalScripts mGlobalScripts;
             std::map<std::string, Compiler::Locals> mOtherLocals;
             std::vector<std::string> mScriptBlacklist;
+            std::unique_ptr<BytecodeCache> mBytecodeCache;
+            const double mLocalScriptsBudget;
+            const unsigned int mMaxDeferredFrames;
+            unsigned int mLocalScriptsFrame;
+            LocalScriptsStats mLocalScriptsStats;
+
+            bool canBeDeferred (const std::string& name) const;
 
         public:
 
             ScriptManager (const MWWorld::ESMStore& store,
                 Compiler::Context& compilerContext, int warningsMode,
-                const std::vector<std::string>& scriptBlacklist);
+                const std::vector<std::string>& scriptBlacklist,
+                std::unique_ptr<BytecodeCache> bytecodeCache = nullptr);
+            ///< \param bytecodeCache Optional persistent cache for compiled scripts, saved on destruction.
+
+            ~ScriptManager() override;
 
             void clear() override;
 
             bool run (const std::string& name, Interpreter::Context& interpreterContext) override;
             ///< Run the script with the given name (compile first, if not compiled yet)
 
+            void runLocalScripts (MWWorld::LocalScripts& localScripts) override;
+            ///< Run all active local scripts. Scripts that do not depend on the frame duration or on
+            /// single frame events may be deferred to later frames when the frame budget is exceeded.
+
             bool compile (const std::string& name) override;
             ///< Compile script with the given namen
             /// \return Success?
@@ -85,6 +117,10 @@ namespace MWScript
             GlobalScripts& getGlobalScripts() override;
 
             const Compiler::Extensions& getExtensions() const override;
+
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
+
+            std::string dumpLocalScriptsProfile() const override;
     };
 }
 
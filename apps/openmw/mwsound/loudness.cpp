@@ -1,6 +1,9 @@
 #include "loudness.hpp"
 
+#include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <algorithm>
 
@@ -9,53 +12,87 @@
 namespace MWSound
 {
 
-void Sound_Loudness::analyzeLoudness(const std::vector< char >& data)
+namespace
 {
-    mQueue.insert( mQueue.end(), data.begin(), data.end() );
-    if (!mQueue.size())
-        return;
+    constexpr std::size_t sLanes = 8;
 
-    int samplesPerSegment = static_cast<int>(mSampleRate / mSamplesPerSec);
-    int numSamples = bytesToFrames(mQueue.size(), mChannelConfig, mSampleType);
-    int advance = framesToBytes(1, mChannelConfig, mSampleType);
-
-
-    int segment=0;
-    int sample=0;
-    while (segment < numSamples/samplesPerSegment)
+    // Sum of squared normalized samples. Independent partial sums break the dependency chain
+    // of a single accumulator so the compiler can keep several lanes in flight and vectorize the loop.
+    template <class T, class Normalize>
+    float sumOfSquares(const char* data, std::size_t count, std::size_t stride, Normalize&& normalize)
     {
-        float sum=0;
-        int samplesAdded = 0;
-        while (sample < numSamples && sample < (segment+1)*samplesPerSegment)
+        std::array<float, sLanes> partial {};
+        std::size_t i = 0;
+        for (; i + sLanes <= count; i += sLanes)
         {
-            // get sample on a scale from -1 to 1
-            float value = 0;
-            if (mSampleType == SampleType_UInt8)
-                value = ((char)(mQueue[sample*advance]^0x80))/128.f;
-            else if (mSampleType == SampleType_Int16)
-            {
-                value = *reinterpret_cast<const int16_t*>(&mQueue[sample*advance]);
-                value /= float(std::numeric_limits<int16_t>::max());
-            }
-            else if (mSampleType == SampleType_Float32)
+            for (std::size_t lane = 0; lane < sLanes; ++lane)
             {
-                value = *reinterpret_cast<const float*>(&mQueue[sample*advance]);
-                value = std::clamp(value, -1.f, 1.f); // Float samples *should* be scaled to [-1,1] already.
+                T sample;
+                std::memcpy(&sample, data + (i + lane) * stride, sizeof(T));
+                const float value = normalize(sample);
+                partial[lane] += value * value;
             }
+        }
+        float sum = 0;
+        for (; i < count; ++i)
+        {
+            T sample;
+            std::memcpy(&sample, data + i * stride, sizeof(T));
+            const float value = normalize(sample);
+            sum += value * value;
+        }
+        for (float value : partial)
+            sum += value;
+        return sum;
+    }
 
-            sum += value*value;
-            ++samplesAdded;
-            ++sample;
+    float sumOfSquares(SampleType type, const char* data, std::size_t count, std::size_t stride)
+    {
+        // get samples on a scale from -1 to 1
+        switch (type)
+        {
+            case SampleType_UInt8:
+                return sumOfSquares<std::uint8_t>(data, count, stride, [] (std::uint8_t v)
+                {
+                    return static_cast<std::int8_t>(v ^ 0x80) / 128.f;
+                });
+            case SampleType_Int16:
+                return sumOfSquares<std::int16_t>(data, count, stride, [] (std::int16_t v)
+                {
+                    return v / float(std::numeric_limits<std::int16_t>::max());
+                });
+            case SampleType_Float32:
+                return sumOfSquares<float>(data, count, stride, [] (float v)
+                {
+                    return std::clamp(v, -1.f, 1.f); // Float samples *should* be scaled to [-1,1] already.
+                });
         }
+        return 0;
+    }
+}
 
-        float rms = 0; // root mean square
-        if (samplesAdded > 0)
-            rms = std::sqrt(sum / samplesAdded);
-        mSamples.push_back(rms);
-        ++segment;
+void Sound_Loudness::analyzeLoudness(const std::vector< char >& data)
+{
+    mQueue.insert( mQueue.end(), data.begin(), data.end() );
+    if (mQueue.empty())
+        return;
+
+    const std::size_t samplesPerSegment = static_cast<std::size_t>(mSampleRate / mSamplesPerSec);
+    if (samplesPerSegment == 0)
+        return;
+    const std::size_t numSamples = bytesToFrames(mQueue.size(), mChannelConfig, mSampleType);
+    const std::size_t advance = framesToBytes(1, mChannelConfig, mSampleType);
+    const std::size_t numSegments = numSamples / samplesPerSegment;
+
+    mSamples.reserve(mSamples.size() + numSegments);
+    for (std::size_t segment = 0; segment < numSegments; ++segment)
+    {
+        const char* segmentData = mQueue.data() + segment * samplesPerSegment * advance;
+        const float sum = sumOfSquares(mSampleType, segmentData, samplesPerSegment, advance);
+        mSamples.push_back(std::sqrt(sum / samplesPerSegment)); // root mean square
     }
 
-    mQueue.erase(mQueue.begin(), mQueue.begin() + sample*advance);
+    mQueue.erase(mQueue.begin(), mQueue.begin() + numSegments * samplesPerSegment * advance);
 }
 
 
@@ -2,7 +2,6 @@
 #define GAME_SOUND_LOUDNESS_H
 
 #include <vector>
-#include <deque>
 
 #include "sound_decoder.hpp"
 
@@ -18,7 +17,7 @@ class Sound_Loudness {
     // Loudness sample info
     std::vector<float> mSamples;
 
-    std::deque<char> mQueue;
+    std::vector<char> mQueue;
 
 public:
     /**
@@ -34,6 +33,19 @@ public:
         , mSampleType(type)
     { }
 
+    /**
+     * Creates a loudness track from already computed values (see LoudnessCache), no analysis is needed.
+     * @param samplesPerSecond How many loudness values per second of audio were computed.
+     * @param samples the loudness values
+    */
+    Sound_Loudness(float samplesPerSecond, std::vector<float> samples)
+        : mSamplesPerSec(samplesPerSecond)
+        , mSampleRate(0)
+        , mChannelConfig(ChannelConfig_Mono)
+        , mSampleType(SampleType_Int16)
+        , mSamples(std::move(samples))
+    { }
+
     /**
      * Analyzes the energy (closely related to loudness) of a sound buffer.
      * The buffer will be divided into segments according to \a valuesPerSecond,
@@ -50,6 +62,8 @@ public:
      * Get loudness at a particular time. Before calling this, the stream has to be analyzed up to that point in time (see analyzeLoudness()).
      */
     float getLoudnessAtTime(float sec) const;
+
+    const std::vector<float>& getSamples() const { return mSamples; }
 };
 
 }
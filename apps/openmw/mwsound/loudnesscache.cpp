@@ -0,0 +1,52 @@
+#include "loudnesscache.hpp"
+
+namespace MWSound
+{
+    namespace
+    {
+        std::size_t getTrackSize(const std::vector<float>& samples)
+        {
+            return samples.size() * sizeof(float);
+        }
+    }
+
+    LoudnessCache::LoudnessCache(std::size_t maxSize)
+        : mMaxSize(maxSize)
+    {
+    }
+
+    std::optional<std::vector<float>> LoudnessCache::get(const std::string& name)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        const auto it = mIndex.find(name);
+        if (it == mIndex.end())
+            return std::nullopt;
+        mTracks.splice(mTracks.begin(), mTracks, it->second);
+        return it->second->second;
+    }
+
+    void LoudnessCache::insert(const std::string& name, const std::vector<float>& samples)
+    {
+        const std::size_t size = getTrackSize(samples);
+        if (size > mMaxSize)
+            return;
+        const std::lock_guard<std::mutex> lock(mMutex);
+        if (mIndex.find(name) != mIndex.end())
+            return;
+        while (!mTracks.empty() && mSize + size > mMaxSize)
+        {
+            mSize -= getTrackSize(mTracks.back().second);
+            mIndex.erase(mTracks.back().first);
+            mTracks.pop_back();
+        }
+        mTracks.emplace_front(name, samples);
+        mIndex.emplace(name, mTracks.begin());
+        mSize += size;
+    }
+
+    std::size_t LoudnessCache::getSize() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mSize;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef GAME_SOUND_LOUDNESSCACHE_H
+#define GAME_SOUND_LOUDNESSCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MWSound
+{
+    /// Loudness curves of fully analyzed voice files, keyed by file name. Filled lazily by the stream
+    /// thread when a voice line is played to the end, so repeated lines skip the analysis.
+    /// When the total size of the curves exceeds the limit, the least recently used ones are dropped.
+    class LoudnessCache
+    {
+        public:
+            explicit LoudnessCache(std::size_t maxSize = 1024 * 1024);
+            ///< \param maxSize Limit for the total size of the stored curves in bytes.
+
+            std::optional<std::vector<float>> get(const std::string& name);
+
+            void insert(const std::string& name, const std::vector<float>& samples);
+
+            std::size_t getSize() const;
+
+        private:
+            using Track = std::pair<std::string, std::vector<float>>;
+
+            const std::size_t mMaxSize;
+            mutable std::mutex mMutex;
+            std::list<Track> mTracks; // The most recently used first
+            std::unordered_map<std::string, std::list<Track>::iterator> mIndex;
+            std::size_t mSize = 0;
+    };
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include <condition_variable>
 #include <thread>
 #include <chrono>
+#include <optional>
 
 #include <cstdint>
 
@@ -277,6 +278,8 @@ private:
     DecoderPtr mDecoder;
 
     std::unique_ptr<Sound_Loudness> mLoudnessAnalyzer;
+    bool mAnalyzeLoudness;
+    LoudnessCache* mLoudnessCache;
 
     std::atomic<bool> mIsFinished;
 
@@ -291,7 +294,7 @@ public:
     OpenAL_SoundStream(ALuint src, DecoderPtr decoder);
     ~OpenAL_SoundStream();
 
-    bool init(bool getLoudnessData=false);
+    bool init(bool getLoudnessData=false, LoudnessCache* loudnessCache=nullptr);
 
     bool isPlaying();
     double getStreamDelay() const;
@@ -382,7 +385,7 @@ private:
 OpenAL_SoundStream::OpenAL_SoundStream(ALuint src, DecoderPtr decoder)
   : mSource(src), mCurrentBufIdx(0), mFormat(AL_NONE), mSampleRate(0)
   , mBufferSize(0), mFrameSize(0), mSilence(0), mDecoder(std::move(decoder))
-  , mLoudnessAnalyzer(nullptr), mIsFinished(true)
+  , mLoudnessAnalyzer(nullptr), mAnalyzeLoudness(false), mLoudnessCache(nullptr), mIsFinished(true)
 {
     mBuffers.fill(0);
 }
@@ -396,7 +399,7 @@ OpenAL_SoundStream::~OpenAL_SoundStream()
     mDecoder->close();
 }
 
-bool OpenAL_SoundStream::init(bool getLoudnessData)
+bool OpenAL_SoundStream::init(bool getLoudnessData, LoudnessCache* loudnessCache)
 {
     alGenBuffers(mBuffers.size(), mBuffers.data());
     ALenum err = getALError();
@@ -428,7 +431,19 @@ bool OpenAL_SoundStream::init(bool getLoudnessData)
     mBufferSize *= mFrameSize;
 
     if (getLoudnessData)
-        mLoudnessAnalyzer.reset(new Sound_Loudness(sLoudnessFPS, mSampleRate, chans, type));
+    {
+        std::optional<std::vector<float>> track;
+        if (loudnessCache != nullptr)
+            track = loudnessCache->get(mDecoder->getName());
+        if (track.has_value())
+            mLoudnessAnalyzer.reset(new Sound_Loudness(sLoudnessFPS, std::move(*track)));
+        else
+        {
+            mLoudnessAnalyzer.reset(new Sound_Loudness(sLoudnessFPS, mSampleRate, chans, type));
+            mAnalyzeLoudness = true;
+            mLoudnessCache = loudnessCache;
+        }
+    }
 
     mIsFinished = false;
     return true;
@@ -550,7 +565,7 @@ ALint OpenAL_SoundStream::refillQueue()
             }
             if(got > 0)
             {
-                if (mLoudnessAnalyzer.get())
+                if (mAnalyzeLoudness)
                     mLoudnessAnalyzer->analyzeLoudness(data);
 
                 ALuint bufid = mBuffers[mCurrentBufIdx];
@@ -559,6 +574,14 @@ ALint OpenAL_SoundStream::refillQueue()
                 mCurrentBufIdx = (mCurrentBufIdx+1) % mBuffers.size();
             }
         }
+
+        // The whole file is analyzed now, later playbacks can reuse the loudness track
+        if (mIsFinished && mAnalyzeLoudness)
+        {
+            mAnalyzeLoudness = false;
+            if (mLoudnessCache != nullptr)
+                mLoudnessCache->insert(mDecoder->getName(), mLoudnessAnalyzer->getSamples());
+        }
     }
 
     return queued;
@@ -1251,7 +1274,7 @@ bool OpenAL_Output::streamSound(DecoderPtr decoder, Stream *sound, bool getLoudn
         return false;
 
     OpenAL_SoundStream *stream = new OpenAL_SoundStream(source, std::move(decoder));
-    if(!stream->init(getLoudnessData))
+    if(!stream->init(getLoudnessData, &mLoudnessCache))
     {
         delete stream;
         return false;
@@ -1282,7 +1305,7 @@ bool OpenAL_Output::streamSound3D(DecoderPtr decoder, Stream *sound, bool getLou
         return false;
 
     OpenAL_SoundStream *stream = new OpenAL_SoundStream(source, std::move(decoder));
-    if(!stream->init(getLoudnessData))
+    if(!stream->init(getLoudnessData, &mLoudnessCache))
     {
         delete stream;
         return false;
@@ -11,6 +11,7 @@
 #include "alext.h"
 
 #include "sound_output.hpp"
+#include "loudnesscache.hpp"
 
 namespace MWSound
 {
@@ -50,6 +51,8 @@ namespace MWSound
         struct StreamThread;
         std::unique_ptr<StreamThread> mStreamThread;
 
+        LoudnessCache mLoudnessCache;
+
         void initCommon2D(ALuint source, const osg::Vec3f &pos, ALfloat gain, ALfloat pitch, bool loop, bool useenv);
         void initCommon3D(ALuint source, const osg::Vec3f &pos, ALfloat mindist, ALfloat maxdist, ALfloat gain, ALfloat pitch, bool loop, bool useenv);
 
@@ -303,7 +303,7 @@ namespace MWWorld
 
             if (oldestTimestamp + threshold < timestamp)
             {
-                oldestCell->second.mWorkItem->abort();
+                abortPreload(oldestCell->second);
                 mPreloadCells.erase(oldestCell);
             }
             else
@@ -321,25 +321,24 @@ namespace MWWorld
         PreloadMap::iterator found = mPreloadCells.find(cell);
         if (found != mPreloadCells.end())
         {
-            if (found->second.mWorkItem)
-            {
-                found->second.mWorkItem->abort();
-                found->second.mWorkItem = nullptr;
-            }
+            if (found->second.mWorkItem && found->second.mWorkItem->isDone())
+                ++mStats.mHits;
+            else
+                ++mStats.mMisses;
+
+            abortPreload(found->second);
 
             mPreloadCells.erase(found);
         }
+        else
+            ++mStats.mMisses;
     }
 
     void CellPreloader::clear()
     {
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
-            if (it->second.mWorkItem)
-            {
-                it->second.mWorkItem->abort();
-                it->second.mWorkItem = nullptr;
-            }
+            abortPreload(it->second);
 
             mPreloadCells.erase(it++);
         }
@@ -347,15 +346,15 @@ namespace MWWorld
 
     void CellPreloader::updateCache(double timestamp)
     {
+        const double staleDelay = 1.0; // seconds
         for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end();)
         {
-            if (mPreloadCells.size() >= mMinCacheSize && it->second.mTimeStamp < timestamp - mExpiryDelay)
+            // unlike a finished preload, an unfinished one is not worth keeping when it's no longer requested
+            const bool stale = it->second.mWorkItem && !it->second.mWorkItem->isDone()
+                && it->second.mTimeStamp < timestamp - staleDelay;
+            if (stale || (mPreloadCells.size() >= mMinCacheSize && it->second.mTimeStamp < timestamp - mExpiryDelay))
             {
-                if (it->second.mWorkItem)
-                {
-                    it->second.mWorkItem->abort();
-                    it->second.mWorkItem = nullptr;
-                }
+                abortPreload(it->second);
                 mPreloadCells.erase(it++);
             }
             else
@@ -377,6 +376,16 @@ namespace MWWorld
         }
     }
 
+    void CellPreloader::abortPreload(PreloadEntry& entry)
+    {
+        if (!entry.mWorkItem)
+            return;
+        if (!entry.mWorkItem->isDone())
+            ++mStats.mAborts;
+        entry.mWorkItem->abort();
+        entry.mWorkItem = nullptr;
+    }
+
     void CellPreloader::setExpiryDelay(double expiryDelay)
     {
         mExpiryDelay = expiryDelay;
@@ -37,6 +37,13 @@ namespace MWWorld
     class CellPreloader
     {
     public:
+        struct Stats
+        {
+            std::size_t mHits = 0; ///< Loaded cells which had finished preloading.
+            std::size_t mMisses = 0; ///< Loaded cells which were not preloaded or were still being preloaded.
+            std::size_t mAborts = 0; ///< Preloads aborted before finishing.
+        };
+
         CellPreloader(Resource::ResourceSystem* resourceSystem, Resource::BulletShapeManager* bulletShapeManager, Terrain::World* terrain, MWRender::LandManager* landManager);
         ~CellPreloader();
 
@@ -44,6 +51,7 @@ namespace MWWorld
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
         void preload(MWWorld::CellStore* cell, double timestamp);
 
+        /// Releases the preloaded resources of a cell which became active and counts a preload hit or miss.
         void notifyLoaded(MWWorld::CellStore* cell);
 
         void clear();
@@ -74,6 +82,9 @@ namespace MWWorld
         void abortTerrainPreloadExcept(const PositionCellGrid *exceptPos);
         bool isTerrainLoaded(const CellPreloader::PositionCellGrid &position, double referenceTime) const;
 
+        /// Counters accumulated since construction.
+        const Stats& getStats() const { return mStats; }
+
     private:
         Resource::ResourceSystem* mResourceSystem;
         Resource::BulletShapeManager* mBulletShapeManager;
@@ -104,6 +115,8 @@ namespace MWWorld
         };
         typedef std::map<const MWWorld::CellStore*, PreloadEntry> PreloadMap;
 
+        void abortPreload(PreloadEntry& entry);
+
         // Cells that are currently being preloaded, or have already finished preloading
         PreloadMap mPreloadCells;
 
@@ -114,6 +127,8 @@ namespace MWWorld
 
         std::vector<PositionCellGrid> mLoadedTerrainPositions;
         double mLoadedTerrainTimestamp;
+
+        Stats mStats;
     };
 
 }
@@ -0,0 +1,51 @@
+#include "preloadpredictor.hpp"
+
+#include <algorithm>
+
+namespace MWWorld
+{
+    PreloadPredictor::PreloadPredictor(float smoothingTime, float teleportDistance)
+        : mSmoothingTime(smoothingTime)
+        , mTeleportDistance(teleportDistance)
+    {
+    }
+
+    void PreloadPredictor::reset(const osg::Vec3f& position)
+    {
+        mHasPosition = true;
+        mPosition = position;
+        mVelocity = osg::Vec3f();
+    }
+
+    void PreloadPredictor::update(const osg::Vec3f& position, float duration)
+    {
+        if (!mHasPosition)
+        {
+            reset(position);
+            return;
+        }
+        if (duration <= 0)
+            return;
+
+        const osg::Vec3f moved = position - mPosition;
+        if (moved.length2() > mTeleportDistance * mTeleportDistance)
+        {
+            reset(position);
+            return;
+        }
+
+        mPosition = position;
+        const float weight = mSmoothingTime > 0 ? std::min(1.f, duration / mSmoothingTime) : 1.f;
+        mVelocity += (moved / duration - mVelocity) * weight;
+    }
+
+    osg::Vec3f PreloadPredictor::getNearestPathPoint(const osg::Vec3f& point, float time) const
+    {
+        const osg::Vec3f path = mVelocity * time;
+        const float length2 = path.length2();
+        if (length2 == 0)
+            return mPosition;
+        const float factor = std::clamp(((point - mPosition) * path) / length2, 0.f, 1.f);
+        return mPosition + path * factor;
+    }
+}
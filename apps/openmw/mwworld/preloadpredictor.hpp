@@ -0,0 +1,40 @@
+#ifndef GAME_MWWORLD_PRELOADPREDICTOR_H
+#define GAME_MWWORLD_PRELOADPREDICTOR_H
+
+#include <osg/Vec3f>
+
+namespace MWWorld
+{
+    /// @brief Predicts the path of the player to rank cells for preloading.
+    /// The velocity is averaged over recent frames, so a single irregular frame doesn't turn the prediction around.
+    class PreloadPredictor
+    {
+        public:
+            /// @param smoothingTime Time in seconds it takes for a change of velocity to be mostly taken into account.
+            /// @param teleportDistance Moving further than this during a single update resets the velocity.
+            PreloadPredictor(float smoothingTime, float teleportDistance);
+
+            /// Starts the prediction from a position without any velocity, e.g. after a teleport.
+            void reset(const osg::Vec3f& position);
+
+            void update(const osg::Vec3f& position, float duration);
+
+            const osg::Vec3f& getPosition() const { return mPosition; }
+
+            const osg::Vec3f& getVelocity() const { return mVelocity; }
+
+            osg::Vec3f getPredictedPosition(float time) const { return mPosition + mVelocity * time; }
+
+            /// Returns the point nearest to the given one on the path from the current to the predicted position.
+            osg::Vec3f getNearestPathPoint(const osg::Vec3f& point, float time) const;
+
+        private:
+            float mSmoothingTime;
+            float mTeleportDistance;
+            bool mHasPosition = false;
+            osg::Vec3f mPosition;
+            osg::Vec3f mVelocity;
+    };
+}
+
+#endif
@@ -1,12 +1,19 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <chrono>
 #include <atomic>
+#include <iomanip>
+#include <sstream>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracerecorder.hpp>
+#include <components/files/constrainedfilestream.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/settings/settings.hpp>
@@ -44,6 +51,33 @@
 namespace
 {
     using MWWorld::RotationOrder;
+    using MWWorld::CellTransitionStats;
+
+    /// Adds the time from construction to destruction to a phase of the cell transition if there is one.
+    class PhaseTimer
+    {
+    public:
+        PhaseTimer(CellTransitionStats* stats, double CellTransitionStats::* phase)
+            : mStats(stats)
+            , mPhase(phase)
+            , mStart(stats == nullptr ? std::chrono::steady_clock::time_point() : std::chrono::steady_clock::now())
+        {
+        }
+
+        PhaseTimer(const PhaseTimer&) = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+        ~PhaseTimer()
+        {
+            if (mStats != nullptr)
+                mStats->*mPhase += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mStart).count();
+        }
+
+    private:
+        CellTransitionStats* const mStats;
+        double CellTransitionStats::* const mPhase;
+        const std::chrono::steady_clock::time_point mStart;
+    };
 
     osg::Quat makeActorOsgQuat(const ESM::Position& position)
     {
@@ -98,7 +132,8 @@ namespace
     }
 
     void addObject(const MWWorld::Ptr& ptr, MWPhysics::PhysicsSystem& physics,
-                   MWRender::RenderingManager& rendering, std::set<ESM::RefNum>& pagedRefs)
+                   MWRender::RenderingManager& rendering, std::set<ESM::RefNum>& pagedRefs,
+                   CellTransitionStats* stats)
     {
         if (ptr.getRefData().getBaseNode() || physics.getActor(ptr))
         {
@@ -110,10 +145,13 @@ namespace
         const auto rotation = makeDirectNodeRotation(ptr);
 
         const ESM::RefNum& refnum = ptr.getCellRef().getRefNum();
-        if (!refnum.hasContentFile() || pagedRefs.find(refnum) == pagedRefs.end())
-            ptr.getClass().insertObjectRendering(ptr, model, rendering);
-        else
-            ptr.getRefData().setBaseNode(new SceneUtil::PositionAttitudeTransform); // FIXME remove this when physics code is fixed not to depend on basenode
+        {
+            const PhaseTimer timer(stats, &CellTransitionStats::mRendering);
+            if (!refnum.hasContentFile() || pagedRefs.find(refnum) == pagedRefs.end())
+                ptr.getClass().insertObjectRendering(ptr, model, rendering);
+            else
+                ptr.getRefData().setBaseNode(new SceneUtil::PositionAttitudeTransform); // FIXME remove this when physics code is fixed not to depend on basenode
+        }
         setNodeRotation(ptr, rendering, rotation);
 
         if (ptr.getClass().useAnim())
@@ -125,7 +163,10 @@ namespace
         // Restore effect particles
         MWBase::Environment::get().getWorld()->applyLoopingParticles(ptr);
 
-        ptr.getClass().insertObject (ptr, model, rotation, physics);
+        {
+            const PhaseTimer timer(stats, &CellTransitionStats::mPhysics);
+            ptr.getClass().insertObject (ptr, model, rotation, physics);
+        }
 
         MWBase::Environment::get().getLuaManager()->objectAddedToScene(ptr);
     }
@@ -307,6 +348,8 @@ namespace MWWorld
         if (mActiveCells.find(cell) == mActiveCells.end())
             return;
 
+        const Debug::TraceZone zone("Scene", "UnloadCell");
+
         Log(Debug::Info) << "Unloading cell " << cell->getCell()->getDescription();
 
         ListAndResetObjectsVisitor visitor;
@@ -367,6 +410,9 @@ namespace MWWorld
         assert(mActiveCells.find(cell) == mActiveCells.end());
         mActiveCells.insert(cell);
 
+        const Debug::TraceZone zone("Scene", "LoadCell");
+        ++mTransitionStats.mCells;
+
         Log(Debug::Info) << "Loading cell " << cell->getCell()->getDescription();
 
         const auto world = MWBase::Environment::get().getWorld();
@@ -382,15 +428,18 @@ namespace MWWorld
             const ESM::Land::LandData* data = land ? land->getData(ESM::Land::DATA_VHGT) : nullptr;
             const int verts = ESM::Land::LAND_SIZE;
             const int worldsize = ESM::Land::REAL_SIZE;
-            if (data)
-            {
-                mPhysics->addHeightField(data->mHeights, cellX, cellY, worldsize, verts, data->mMinHeight, data->mMaxHeight, land.get());
-            }
-            else
             {
-                static std::vector<float> defaultHeight;
-                defaultHeight.resize(verts*verts, ESM::Land::DEFAULT_HEIGHT);
-                mPhysics->addHeightField(defaultHeight.data(), cellX, cellY, worldsize, verts, ESM::Land::DEFAULT_HEIGHT, ESM::Land::DEFAULT_HEIGHT, land.get());
+                const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mPhysics);
+                if (data)
+                {
+                    mPhysics->addHeightField(data->mHeights, cellX, cellY, worldsize, verts, data->mMinHeight, data->mMaxHeight, land.get());
+                }
+                else
+                {
+                    static std::vector<float> defaultHeight;
+                    defaultHeight.resize(verts*verts, ESM::Land::DEFAULT_HEIGHT);
+                    mPhysics->addHeightField(defaultHeight.data(), cellX, cellY, worldsize, verts, ESM::Land::DEFAULT_HEIGHT, ESM::Land::DEFAULT_HEIGHT, land.get());
+                }
             }
             if (const auto heightField = mPhysics->getHeightField(cellX, cellY))
             {
@@ -413,12 +462,16 @@ namespace MWWorld
                         return heights;
                     }
                 } ();
+                const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavigator);
                 mNavigator.addHeightfield(cellPosition, ESM::Land::REAL_SIZE, shape);
             }
         }
 
         if (const auto pathgrid = world->getStore().get<ESM::Pathgrid>().search(*cell->getCell()))
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavigator);
             mNavigator.addPathgrid(*cell->getCell(), *pathgrid);
+        }
 
         // register local scripts
         // do this before insertCell, to make sure we don't add scripts from levelled creature spawning twice
@@ -429,7 +482,10 @@ namespace MWWorld
 
         insertCell(*cell, loadingListener);
 
-        mRendering.addCell(cell);
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mRendering);
+            mRendering.addCell(cell);
+        }
 
         MWBase::Environment::get().getWindowManager()->addCell(cell);
         bool waterEnabled = cell->getCell()->hasWater() || cell->isExterior();
@@ -461,7 +517,10 @@ namespace MWWorld
             mPhysics->traceDown(player, player.getRefData().getPosition().asVec3(), 10.f);
         }
 
-        mNavigator.update(position);
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavigator);
+            mNavigator.update(position);
+        }
 
         if (!cell->isExterior() && !(cell->getCell()->mData.mFlags & ESM::Cell::QuasiEx))
             mRendering.configureAmbient(cell->getCell());
@@ -520,18 +579,24 @@ namespace MWWorld
 
     void Scene::changeCellGrid (const osg::Vec3f &pos, int playerCellX, int playerCellY, bool changeEvent)
     {
-        for (auto iter = mActiveCells.begin(); iter != mActiveCells.end(); )
+        const Debug::TraceZone zone("Scene", "ChangeCellGrid");
+        beginTransition();
+
         {
-            auto* cell = *iter++;
-            if (cell->getCell()->isExterior())
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mUnload);
+            for (auto iter = mActiveCells.begin(); iter != mActiveCells.end(); )
             {
-                const auto dx = std::abs(playerCellX - cell->getCell()->getGridX());
-                const auto dy = std::abs(playerCellY - cell->getCell()->getGridY());
-                if (dx > mHalfGridSize || dy > mHalfGridSize)
-                    unloadCell(cell);
+                auto* cell = *iter++;
+                if (cell->getCell()->isExterior())
+                {
+                    const auto dx = std::abs(playerCellX - cell->getCell()->getGridX());
+                    const auto dy = std::abs(playerCellY - cell->getCell()->getGridY());
+                    if (dx > mHalfGridSize || dy > mHalfGridSize)
+                        unloadCell(cell);
+                }
+                else
+                    unloadCell (cell);
             }
-            else
-                unloadCell (cell);
         }
 
         mNavigator.updateBounds(pos);
@@ -543,7 +608,10 @@ namespace MWWorld
         if (mRendering.pagingUnlockCache())
             mPreloader->abortTerrainPreloadExcept(nullptr);
         if (!mPreloader->isTerrainLoaded(std::make_pair(pos, newGrid), mRendering.getReferenceTime()))
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mTerrain);
             preloadTerrain(pos, true);
+        }
         mPagedRefs.clear();
         mRendering.getPagedRefnums(newGrid, mPagedRefs);
 
@@ -565,24 +633,31 @@ namespace MWWorld
             return cellsPositionsToLoad;
         };
 
-        for(const auto& cell : mActiveCells)
         {
-            cell->forEach([&](const MWWorld::Ptr& ptr)
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mPhysics);
+            for(const auto& cell : mActiveCells)
             {
-                if(ptr.mRef->mData.mPhysicsPostponed)
+                cell->forEach([&](const MWWorld::Ptr& ptr)
                 {
-                    ptr.mRef->mData.mPhysicsPostponed = false;
-                    if(ptr.mRef->mData.isEnabled() && ptr.mRef->mData.getCount() > 0) {
-                        std::string model = getModel(ptr, MWBase::Environment::get().getResourceSystem()->getVFS());
-                        const auto rotation = makeNodeRotation(ptr, RotationOrder::direct);
-                        ptr.getClass().insertObjectPhysics(ptr, model, rotation, *mPhysics);
+                    if(ptr.mRef->mData.mPhysicsPostponed)
+                    {
+                        ptr.mRef->mData.mPhysicsPostponed = false;
+                        if(ptr.mRef->mData.isEnabled() && ptr.mRef->mData.getCount() > 0) {
+                            std::string model = getModel(ptr, MWBase::Environment::get().getResourceSystem()->getVFS());
+                            const auto rotation = makeNodeRotation(ptr, RotationOrder::direct);
+                            ptr.getClass().insertObjectPhysics(ptr, model, rotation, *mPhysics);
+                        }
                     }
-                }
-                return true;
-            });
+                    return true;
+                });
+            }
         }
 
-        auto cellsPositionsToLoad = cellsToLoad(mActiveCells,mHalfGridSize);
+        auto cellsPositionsToLoad = [&]
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mReferences);
+            return cellsToLoad(mActiveCells, mHalfGridSize);
+        } ();
 
         Loading::Listener* loadingListener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         Loading::ScopedLoad load(loadingListener);
@@ -620,7 +695,13 @@ namespace MWWorld
         if (changeEvent)
             mCellChanged = true;
 
-        mNavigator.wait(*loadingListener, DetourNavigator::WaitConditionType::requiredTilesPresent);
+        {
+            const Debug::TraceZone waitZone("Scene", "NavMeshWait");
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavMeshWait);
+            mNavigator.wait(*loadingListener, DetourNavigator::WaitConditionType::requiredTilesPresent);
+        }
+
+        endTransition();
     }
 
     void Scene::testExteriorCells()
@@ -743,7 +824,7 @@ namespace MWWorld
 
         world->adjustSky();
 
-        mLastPlayerPos = player.getRefData().getPosition().asVec3();
+        mPreloadPredictor.reset(player.getRefData().getPosition().asVec3());
     }
 
     Scene::Scene (MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem *physics,
@@ -756,6 +837,8 @@ namespace MWWorld
     , mPreloadDoors(Settings::Manager::getBool("preload doors", "Cells"))
     , mPreloadFastTravel(Settings::Manager::getBool("preload fast travel", "Cells"))
     , mPredictionTime(Settings::Manager::getFloat("prediction time", "Cells"))
+    // moving further than a cell within a frame is a teleport rather than a speed to extrapolate
+    , mPreloadPredictor(0.25f, Constants::CellSizeInUnits)
     {
         mPreloader.reset(new CellPreloader(rendering.getResourceSystem(), physics->getShapeManager(), rendering.getTerrain(), rendering.getLandManager()));
         mPreloader->setWorkQueue(mRendering.getWorkQueue());
@@ -789,7 +872,14 @@ namespace MWWorld
 
     void Scene::changeToInteriorCell (const std::string& cellName, const ESM::Position& position, bool adjustPlayerPos, bool changeEvent)
     {
-        CellStore *cell = MWBase::Environment::get().getWorld()->getInterior(cellName);
+        const Debug::TraceZone zone("Scene", "ChangeToInteriorCell");
+        beginTransition();
+
+        CellStore *cell = [&]
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mReferences);
+            return MWBase::Environment::get().getWorld()->getInterior(cellName);
+        } ();
         bool useFading = (mCurrentCell != nullptr);
         if (useFading)
             MWBase::Environment::get().getWindowManager()->fadeScreenOut(0.5);
@@ -814,10 +904,13 @@ namespace MWWorld
         Log(Debug::Info) << "Changing to interior";
 
         // unload
-        for (auto iter = mActiveCells.begin(); iter!=mActiveCells.end(); )
         {
-            auto* cellToUnload = *iter++;
-            unloadCell(cellToUnload);
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mUnload);
+            for (auto iter = mActiveCells.begin(); iter!=mActiveCells.end(); )
+            {
+                auto* cellToUnload = *iter++;
+                unloadCell(cellToUnload);
+            }
         }
         assert(mActiveCells.empty());
 
@@ -845,7 +938,13 @@ namespace MWWorld
 
         MWBase::Environment::get().getWindowManager()->changeCell(mCurrentCell);
 
-        mNavigator.wait(*loadingListener, DetourNavigator::WaitConditionType::requiredTilesPresent);
+        {
+            const Debug::TraceZone waitZone("Scene", "NavMeshWait");
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavMeshWait);
+            mNavigator.wait(*loadingListener, DetourNavigator::WaitConditionType::requiredTilesPresent);
+        }
+
+        endTransition();
     }
 
     void Scene::changeToExteriorCell (const ESM::Position& position, bool adjustPlayerPos, bool changeEvent)
@@ -881,15 +980,19 @@ namespace MWWorld
     {
         InsertVisitor insertVisitor(cell, loadingListener);
         cell.forEach (insertVisitor);
-        insertVisitor.insert([&] (const MWWorld::Ptr& ptr) { addObject(ptr, *mPhysics, mRendering, mPagedRefs); });
-        insertVisitor.insert([&] (const MWWorld::Ptr& ptr) { addObject(ptr, *mPhysics, mNavigator); });
+        insertVisitor.insert([&] (const MWWorld::Ptr& ptr) { addObject(ptr, *mPhysics, mRendering, mPagedRefs, &mTransitionStats); });
+        insertVisitor.insert([&] (const MWWorld::Ptr& ptr)
+        {
+            const PhaseTimer timer(&mTransitionStats, &CellTransitionStats::mNavigator);
+            addObject(ptr, *mPhysics, mNavigator);
+        });
     }
 
     void Scene::addObjectToScene (const Ptr& ptr)
     {
         try
         {
-            addObject(ptr, *mPhysics, mRendering, mPagedRefs);
+            addObject(ptr, *mPhysics, mRendering, mPagedRefs, nullptr);
             addObject(ptr, *mPhysics, mNavigator);
             MWBase::Environment::get().getWorld()->scaleObject(ptr, ptr.getCellRef().getScale());
             if (mCurrentCell != nullptr)
@@ -1006,29 +1109,64 @@ namespace MWWorld
         std::vector<PositionCellGrid> exteriorPositions;
 
         const MWWorld::ConstPtr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
-        osg::Vec3f playerPos = player.getRefData().getPosition().asVec3();
-        osg::Vec3f moved = playerPos - mLastPlayerPos;
-        osg::Vec3f predictedPos = playerPos + moved / dt * mPredictionTime;
+        mPreloadPredictor.update(player.getRefData().getPosition().asVec3(), dt);
+        const osg::Vec3f predictedPos = mPreloadPredictor.getPredictedPosition(mPredictionTime);
 
         if (mCurrentCell->isExterior())
             exteriorPositions.emplace_back(predictedPos, gridCenterToBounds(getNewGridCenter(predictedPos, &mCurrentGridCenter)));
 
-        mLastPlayerPos = playerPos;
-
         if (mPreloadEnabled)
         {
+            mPreloadCandidates.clear();
             if (mPreloadDoors)
-                preloadTeleportDoorDestinations(playerPos, predictedPos, exteriorPositions);
+                preloadTeleportDoorDestinations(exteriorPositions);
             if (mPreloadExteriorGrid)
-                preloadExteriorGrid(playerPos, predictedPos);
+                preloadExteriorGrid();
             if (mPreloadFastTravel)
-                preloadFastTravelDestinations(playerPos, predictedPos, exteriorPositions);
+            {
+                preloadFastTravelDestinations(exteriorPositions);
+                preloadMarkedPosition(exteriorPositions);
+            }
+            preloadCandidates();
         }
 
         mPreloader->setTerrainPreloadPositions(exteriorPositions);
     }
 
-    void Scene::preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions)
+    void Scene::addPreloadCandidate(CellStore* cell, float distance, bool preloadSurrounding)
+    {
+        // the cell itself goes first to be requested before its neighbours of the same distance
+        mPreloadCandidates.push_back(PreloadCandidate {distance, cell});
+        if (!preloadSurrounding || !cell->isExterior())
+            return;
+        const int x = cell->getCell()->getGridX();
+        const int y = cell->getCell()->getGridY();
+        for (int dx = -mHalfGridSize; dx <= mHalfGridSize; ++dx)
+            for (int dy = -mHalfGridSize; dy <= mHalfGridSize; ++dy)
+                if (dx != 0 || dy != 0)
+                    mPreloadCandidates.push_back(PreloadCandidate {distance, MWBase::Environment::get().getWorld()->getExterior(x+dx, y+dy)});
+    }
+
+    void Scene::preloadCandidates()
+    {
+        std::stable_sort(mPreloadCandidates.begin(), mPreloadCandidates.end(),
+            [] (const PreloadCandidate& lhs, const PreloadCandidate& rhs) { return lhs.mDistance < rhs.mDistance; });
+
+        // Candidates beyond the preloader capacity are not refreshed, so their preloading is cancelled once stale
+        // instead of taking a place of a more likely destination.
+        std::vector<const CellStore*> requested;
+        for (const PreloadCandidate& candidate : mPreloadCandidates)
+        {
+            if (requested.size() >= mPreloader->getMaxCacheSize())
+                break;
+            if (std::find(requested.begin(), requested.end(), candidate.mCell) != requested.end())
+                continue;
+            requested.push_back(candidate.mCell);
+            mPreloader->preload(candidate.mCell, mRendering.getReferenceTime());
+        }
+    }
+
+    void Scene::preloadTeleportDoorDestinations(std::vector<PositionCellGrid>& exteriorPositions)
     {
         std::vector<MWWorld::ConstPtr> teleportDoors;
         for (const MWWorld::CellStore* cellStore : mActiveCells)
@@ -1047,21 +1185,21 @@ namespace MWWorld
 
         for (const MWWorld::ConstPtr& door : teleportDoors)
         {
-            float sqrDistToPlayer = (playerPos - door.getRefData().getPosition().asVec3()).length2();
-            sqrDistToPlayer = std::min(sqrDistToPlayer, (predictedPos - door.getRefData().getPosition().asVec3()).length2());
+            const osg::Vec3f doorPos = door.getRefData().getPosition().asVec3();
+            const float distToPlayer = (mPreloadPredictor.getNearestPathPoint(doorPos, mPredictionTime) - doorPos).length();
 
-            if (sqrDistToPlayer < mPreloadDistance*mPreloadDistance)
+            if (distToPlayer < mPreloadDistance)
             {
                 try
                 {
                     if (!door.getCellRef().getDestCell().empty())
-                        preloadCell(MWBase::Environment::get().getWorld()->getInterior(door.getCellRef().getDestCell()));
+                        addPreloadCandidate(MWBase::Environment::get().getWorld()->getInterior(door.getCellRef().getDestCell()), distToPlayer);
                     else
                     {
                         osg::Vec3f pos = door.getCellRef().getDoorDest().asVec3();
                         int x,y;
                         MWBase::Environment::get().getWorld()->positionToIndex (pos.x(), pos.y(), x, y);
-                        preloadCell(MWBase::Environment::get().getWorld()->getExterior(x,y), true);
+                        addPreloadCandidate(MWBase::Environment::get().getWorld()->getExterior(x,y), distToPlayer, true);
                         exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos)));
                     }
                 }
@@ -1073,7 +1211,7 @@ namespace MWWorld
         }
     }
 
-    void Scene::preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos)
+    void Scene::preloadExteriorGrid()
     {
         if (!MWBase::Environment::get().getWorld()->isCellExterior())
             return;
@@ -1097,12 +1235,14 @@ namespace MWWorld
                 float thisCellCenterX, thisCellCenterY;
                 MWBase::Environment::get().getWorld()->indexToPosition(cellX+dx, cellY+dy, thisCellCenterX, thisCellCenterY, true);
 
-                float dist = std::max(std::abs(thisCellCenterX - playerPos.x()), std::abs(thisCellCenterY - playerPos.y()));
-                dist = std::min(dist,std::max(std::abs(thisCellCenterX - predictedPos.x()), std::abs(thisCellCenterY - predictedPos.y())));
+                const osg::Vec3f thisCellCenter(thisCellCenterX, thisCellCenterY, mPreloadPredictor.getPosition().z());
+                const osg::Vec3f nearest = mPreloadPredictor.getNearestPathPoint(thisCellCenter, mPredictionTime);
+                float dist = std::max(std::abs(thisCellCenterX - nearest.x()), std::abs(thisCellCenterY - nearest.y()));
                 float loadDist = Constants::CellSizeInUnits / 2 + Constants::CellSizeInUnits - mCellLoadingThreshold + mPreloadDistance;
 
+                // rank by the distance to the point where the cell will be loaded, as for other preload triggers
                 if (dist < loadDist)
-                    preloadCell(MWBase::Environment::get().getWorld()->getExterior(cellX+dx, cellY+dy));
+                    addPreloadCandidate(MWBase::Environment::get().getWorld()->getExterior(cellX+dx, cellY+dy), dist - loadDist + mPreloadDistance);
             }
         }
     }
@@ -1159,27 +1299,23 @@ namespace MWWorld
 
         bool operator()(const MWWorld::Ptr& ptr)
         {
-            if ((ptr.getRefData().getPosition().asVec3() - mPlayerPos).length2() > mPreloadDist * mPreloadDist)
+            const float distance = (ptr.getRefData().getPosition().asVec3() - mPlayerPos).length();
+            if (distance > mPreloadDist)
                 return true;
 
-            if (ptr.getClass().isNpc())
-            {
-                const std::vector<ESM::Transport::Dest>& transport = ptr.get<ESM::NPC>()->mBase->mTransport.mList;
-                mList.insert(mList.begin(), transport.begin(), transport.end());
-            }
-            else
-            {
-                const std::vector<ESM::Transport::Dest>& transport = ptr.get<ESM::Creature>()->mBase->mTransport.mList;
-                mList.insert(mList.begin(), transport.begin(), transport.end());
-            }
+            const std::vector<ESM::Transport::Dest>& transport = ptr.getClass().isNpc()
+                ? ptr.get<ESM::NPC>()->mBase->mTransport.mList
+                : ptr.get<ESM::Creature>()->mBase->mTransport.mList;
+            for (const ESM::Transport::Dest& dest : transport)
+                mList.emplace_back(distance, dest);
             return true;
         }
         float mPreloadDist;
         osg::Vec3f mPlayerPos;
-        std::vector<ESM::Transport::Dest> mList;
+        std::vector<std::pair<float, ESM::Transport::Dest>> mList; // with the distance to the travel service
     };
 
-    void Scene::preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& /*predictedPos*/, std::vector<PositionCellGrid>& exteriorPositions) // ignore predictedPos here since opening dialogue with travel service takes extra time
+    void Scene::preloadFastTravelDestinations(std::vector<PositionCellGrid>& exteriorPositions) // ignore the predicted path here since opening dialogue with travel service takes extra time
     {
         const MWWorld::ConstPtr player = MWBase::Environment::get().getWorld()->getPlayerPtr();
         ListFastTravelDestinationsVisitor listVisitor(mPreloadDistance, player.getRefData().getPosition().asVec3());
@@ -1190,18 +1326,85 @@ namespace MWWorld
             cellStore->forEachType<ESM::Creature>(listVisitor);
         }
 
-        for (ESM::Transport::Dest& dest : listVisitor.mList)
+        for (const auto& [distance, dest] : listVisitor.mList)
         {
             if (!dest.mCellName.empty())
-                preloadCell(MWBase::Environment::get().getWorld()->getInterior(dest.mCellName));
+                addPreloadCandidate(MWBase::Environment::get().getWorld()->getInterior(dest.mCellName), distance);
             else
             {
                 osg::Vec3f pos = dest.mPos.asVec3();
                 int x,y;
                 MWBase::Environment::get().getWorld()->positionToIndex( pos.x(), pos.y(), x, y);
-                preloadCell(MWBase::Environment::get().getWorld()->getExterior(x,y), true);
+                addPreloadCandidate(MWBase::Environment::get().getWorld()->getExterior(x,y), distance, true);
                 exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos)));
             }
         }
     }
+
+    void Scene::preloadMarkedPosition(std::vector<PositionCellGrid>& exteriorPositions)
+    {
+        CellStore* markedCell = nullptr;
+        ESM::Position markedPosition;
+        MWBase::Environment::get().getWorld()->getPlayer().getMarkedPosition(markedCell, markedPosition);
+        if (markedCell == nullptr || mActiveCells.count(markedCell) != 0)
+            return;
+
+        // Recall can be cast anywhere, so the destination is ranked after everything the player approaches.
+        addPreloadCandidate(markedCell, mPreloadDistance, true);
+        if (markedCell->isExterior())
+        {
+            const osg::Vec3f pos = markedPosition.asVec3();
+            exteriorPositions.emplace_back(pos, gridCenterToBounds(getNewGridCenter(pos)));
+        }
+    }
+
+    void Scene::beginTransition()
+    {
+        mTransitionStats = CellTransitionStats();
+        mTransitionStart = std::chrono::steady_clock::now();
+        mTransitionBytesRead = Files::getConstrainedFileStreamBytesRead();
+        mTransitionPreloadHits = mPreloader->getStats().mHits;
+        mTransitionPreloadMisses = mPreloader->getStats().mMisses;
+    }
+
+    void Scene::endTransition()
+    {
+        CellTransitionStats& stats = mTransitionStats;
+        stats.mTotal = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mTransitionStart).count();
+        stats.mBytesRead = Files::getConstrainedFileStreamBytesRead() - mTransitionBytesRead;
+        stats.mPreloadHits = mPreloader->getStats().mHits - mTransitionPreloadHits;
+        stats.mPreloadMisses = mPreloader->getStats().mMisses - mTransitionPreloadMisses;
+        mLastTransitionStats = stats;
+
+        const double other = stats.mTotal - stats.mUnload - stats.mTerrain - stats.mReferences - stats.mRendering
+            - stats.mPhysics - stats.mNavigator - stats.mNavMeshWait;
+        std::ostringstream message;
+        message << std::fixed << std::setprecision(1)
+                << "Cell transition: loaded " << stats.mCells << " cells in " << stats.mTotal << " ms"
+                << " (unload " << stats.mUnload << ", terrain " << stats.mTerrain
+                << ", references " << stats.mReferences << ", rendering " << stats.mRendering
+                << ", physics " << stats.mPhysics << ", navigator " << stats.mNavigator
+                << ", navmesh wait " << stats.mNavMeshWait << ", other " << other << ")"
+                << ", preload hits " << stats.mPreloadHits << ", misses " << stats.mPreloadMisses
+                << ", read " << stats.mBytesRead / 1024 << " KiB";
+        Log(Debug::Info) << message.str();
+    }
+
+    void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Cell Transition", mLastTransitionStats.mTotal);
+        stats.setAttribute(frameNumber, "Cell Unload", mLastTransitionStats.mUnload);
+        stats.setAttribute(frameNumber, "Cell Terrain", mLastTransitionStats.mTerrain);
+        stats.setAttribute(frameNumber, "Cell References", mLastTransitionStats.mReferences);
+        stats.setAttribute(frameNumber, "Cell Rendering", mLastTransitionStats.mRendering);
+        stats.setAttribute(frameNumber, "Cell Physics", mLastTransitionStats.mPhysics);
+        stats.setAttribute(frameNumber, "Cell Navigator", mLastTransitionStats.mNavigator);
+        stats.setAttribute(frameNumber, "Cell NavMesh Wait", mLastTransitionStats.mNavMeshWait);
+        stats.setAttribute(frameNumber, "Cell Read KiB", mLastTransitionStats.mBytesRead / 1024);
+
+        const CellPreloader::Stats& preloaderStats = mPreloader->getStats();
+        stats.setAttribute(frameNumber, "Preload Hits", preloaderStats.mHits);
+        stats.setAttribute(frameNumber, "Preload Misses", preloaderStats.mMisses);
+        stats.setAttribute(frameNumber, "Preload Aborts", preloaderStats.mAborts);
+    }
 }
@@ -7,7 +7,10 @@
 
 #include "ptr.hpp"
 #include "globals.hpp"
+#include "preloadpredictor.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <set>
 #include <memory>
 #include <unordered_map>
@@ -18,6 +21,7 @@
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace ESM
@@ -68,6 +72,23 @@ namespace MWWorld
         inverse
     };
 
+    /// Breakdown of a change of the active cells. Durations are in milliseconds.
+    struct CellTransitionStats
+    {
+        std::size_t mCells = 0;
+        double mTotal = 0;
+        double mUnload = 0;
+        double mTerrain = 0;
+        double mReferences = 0; ///< Loading cell references from content files.
+        double mRendering = 0; ///< Creating scene graph nodes including meshes loading.
+        double mPhysics = 0; ///< Creating heightfields and collision objects including shapes loading.
+        double mNavigator = 0;
+        double mNavMeshWait = 0;
+        std::size_t mPreloadHits = 0;
+        std::size_t mPreloadMisses = 0;
+        std::uint64_t mBytesRead = 0; ///< Read by all threads during the transition.
+    };
+
     class Scene
     {
         public:
@@ -93,12 +114,30 @@ namespace MWWorld
 
             static const int mHalfGridSize = Constants::CellGridRadius;
 
-            osg::Vec3f mLastPlayerPos;
+            PreloadPredictor mPreloadPredictor;
+
+            struct PreloadCandidate
+            {
+                float mDistance; // from the predicted path of the player, lower is requested first
+                CellStore* mCell;
+            };
+
+            std::vector<PreloadCandidate> mPreloadCandidates;
 
             std::set<ESM::RefNum> mPagedRefs;
 
             std::vector<osg::ref_ptr<SceneUtil::WorkItem>> mWorkItems;
 
+            CellTransitionStats mTransitionStats; // of the transition in progress
+            CellTransitionStats mLastTransitionStats;
+            std::chrono::steady_clock::time_point mTransitionStart;
+            std::uint64_t mTransitionBytesRead = 0;
+            std::size_t mTransitionPreloadHits = 0;
+            std::size_t mTransitionPreloadMisses = 0;
+
+            void beginTransition();
+            void endTransition();
+
             void insertCell(CellStore &cell, Loading::Listener* loadingListener);
             osg::Vec2i mCurrentGridCenter;
 
@@ -108,9 +147,13 @@ namespace MWWorld
             typedef std::pair<osg::Vec3f, osg::Vec4i> PositionCellGrid;
 
             void preloadCells(float dt);
-            void preloadTeleportDoorDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions);
-            void preloadExteriorGrid(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos);
-            void preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos, std::vector<PositionCellGrid>& exteriorPositions);
+            void preloadTeleportDoorDestinations(std::vector<PositionCellGrid>& exteriorPositions);
+            void preloadExteriorGrid();
+            void preloadFastTravelDestinations(std::vector<PositionCellGrid>& exteriorPositions);
+            void preloadMarkedPosition(std::vector<PositionCellGrid>& exteriorPositions);
+            void addPreloadCandidate(CellStore* cell, float distance, bool preloadSurrounding = false);
+            /// Requests the candidates nearest to the predicted path, as many as fit into the preloader.
+            void preloadCandidates();
 
             osg::Vec4i gridCenterToBounds(const osg::Vec2i &centerCell) const;
             osg::Vec2i getNewGridCenter(const osg::Vec3f &pos, const osg::Vec2i *currentGridCenter = nullptr) const;
@@ -175,6 +218,8 @@ namespace MWWorld
 
             void testExteriorCells();
             void testInteriorCells();
+
+            void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
     };
 }
 
@@ -983,6 +983,7 @@ namespace MWWorld
 
     Store<ESM::Dialogue>::Store()
         : mKeywordSearchModFlag(true)
+        , mInfoIndicesModFlag(true)
     {
     }
 
@@ -1002,6 +1003,16 @@ namespace MWWorld
         std::sort(mShared.begin(), mShared.end(), [](const ESM::Dialogue* l, const ESM::Dialogue* r) -> bool { return l->mId < r->mId; });
 
         mKeywordSearchModFlag = true;
+
+        // setUp is called again on every savegame load while dialogues only change on content files load
+        if (mInfoIndicesModFlag)
+        {
+            mInfoIndices.clear();
+            mInfoIndices.reserve(mStatic.size());
+            for (const auto & [_, dial] : mStatic)
+                mInfoIndices.emplace(&dial, MWDialogue::InfoIndex(dial));
+            mInfoIndicesModFlag = false;
+        }
     }
 
     const ESM::Dialogue *Store<ESM::Dialogue>::search(const std::string &id) const
@@ -1060,6 +1071,7 @@ namespace MWWorld
         }
         
         mKeywordSearchModFlag = true;
+        mInfoIndicesModFlag = true;
 
         return RecordId(dialogue.mId, isDeleted);
     }
@@ -1067,7 +1079,10 @@ namespace MWWorld
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
         if (mStatic.erase(id))
+        {
             mKeywordSearchModFlag = true;
+            mInfoIndicesModFlag = true;
+        }
 
         return true;
     }
@@ -1092,6 +1107,15 @@ namespace MWWorld
 
         return mKeywordSearch;
     }
+
+    const MWDialogue::InfoIndex& Store<ESM::Dialogue>::getInfoIndex(const ESM::Dialogue& dialogue) const
+    {
+        const auto it = mInfoIndices.find(&dialogue);
+        if (it == mInfoIndices.end() || mInfoIndicesModFlag)
+            throw std::runtime_error("Info index for " + std::string(ESM::Dialogue::getRecordType()) + " '"
+                + dialogue.mId + "' not found");
+        return it->second;
+    }
 }
 
 template class MWWorld::Store<ESM::Activator>;
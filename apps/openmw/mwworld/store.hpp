@@ -11,6 +11,7 @@
 #include <components/esm/records.hpp>
 #include <components/misc/stringops.hpp>
 
+#include "../mwdialogue/infoindex.hpp"
 #include "../mwdialogue/keywordsearch.hpp"
 
 namespace ESM
@@ -455,6 +456,9 @@ namespace MWWorld
         mutable bool mKeywordSearchModFlag;
         mutable MWDialogue::KeywordSearch<std::string, int /*unused*/> mKeywordSearch;
 
+        bool mInfoIndicesModFlag;
+        std::unordered_map<const ESM::Dialogue*, MWDialogue::InfoIndex> mInfoIndices;
+
     public:
         Store();
 
@@ -475,6 +479,10 @@ namespace MWWorld
         RecordId load(ESM::ESMReader &esm) override;
 
         const MWDialogue::KeywordSearch<std::string, int>& getDialogIdKeywordSearch() const;
+
+        /// Built by setUp() for every dialogue of the store once it has been modified.
+        /// Throws std::runtime_error if there is no index for the dialogue.
+        const MWDialogue::InfoIndex& getInfoIndex(const ESM::Dialogue& dialogue) const;
     };
 
 } //end namespace
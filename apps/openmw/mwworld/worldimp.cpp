@@ -3987,6 +3987,7 @@ namespace MWWorld
     {
         mNavigator->reportStats(frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
+        mWorldScene->reportStats(frameNumber, stats);
     }
 
     void World::updateSkyDate()
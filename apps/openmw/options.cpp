@@ -105,6 +105,20 @@ namespace OpenMW
             ("random-seed", bpo::value <unsigned int> ()
                 ->default_value(Misc::Rng::generateDefaultSeed()),
                 "seed value for random number generator")
+
+            ("benchmark", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+                "run a benchmark: execute console commands from the file at given frames with a fixed timestep "
+                "and write per frame stats, then quit. Async physics, Lua worker thread and cell preloading "
+                "are disabled to make runs repeatable")
+
+            ("benchmark-output", bpo::value<Files::MaybeQuotedPath>()->default_value(Files::MaybeQuotedPath(), ""),
+                "CSV file for benchmark stats (benchmark.csv in the current directory by default)")
+
+            ("benchmark-timestep", bpo::value<float>()->default_value(1.f / 60.f, "1/60"),
+                "simulated duration of a benchmark frame in seconds")
+
+            ("headless", bpo::value<bool>()->implicit_value(true)
+                ->default_value(false), "use a hidden window and skip rendering, including loading screens (an OpenGL context is still required, software rendering is enough)")
         ;
 
         return desc;
@@ -0,0 +1,135 @@
+#include <components/debug/tracerecorder.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Debug;
+
+    std::size_t countOccurrences(const std::string& text, const std::string& value)
+    {
+        std::size_t result = 0;
+        for (std::size_t pos = text.find(value); pos != std::string::npos; pos = text.find(value, pos + 1))
+            ++result;
+        return result;
+    }
+
+    // Every test records from a new thread to get a new ring buffer.
+    template <class F>
+    void runInThread(F&& f)
+    {
+        std::thread thread(std::forward<F>(f));
+        thread.join();
+    }
+
+    TEST(DebugTraceRecorderTest, zonesAndCountersShouldBeWrittenInChromeTraceFormat)
+    {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.start(16, ".");
+        runInThread([&]
+        {
+            recorder.setThreadName("test \"zones\"");
+            {
+                TraceZone zone("Test", "zoneShouldBeWritten");
+            }
+            recorder.recordCounter("Test", "counterShouldBeWritten", 42);
+        });
+        recorder.stop();
+        std::ostringstream stream;
+        recorder.writeChromeTrace(stream);
+        const std::string trace = stream.str();
+        EXPECT_NE(trace.find("\"args\":{\"name\":\"test \\\"zones\\\"\"}"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"name\":\"zoneShouldBeWritten\",\"cat\":\"Test\""), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"name\":\"counterShouldBeWritten\""), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"ph\":\"C\",\"args\":{\"value\":42.000}"), std::string::npos) << trace;
+    }
+
+    TEST(DebugTraceRecorderTest, ringBufferShouldKeepOnlyLastEvents)
+    {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.start(4, ".");
+        runInThread([&]
+        {
+            for (int i = 0; i < 10; ++i)
+                recorder.recordCounter("Test", "ringBufferCounter", i);
+        });
+        recorder.stop();
+        std::ostringstream stream;
+        recorder.writeChromeTrace(stream);
+        const std::string trace = stream.str();
+        EXPECT_EQ(countOccurrences(trace, "ringBufferCounter"), 4) << trace;
+        EXPECT_EQ(trace.find("\"value\":5.000"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"value\":6.000"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"value\":9.000"), std::string::npos) << trace;
+    }
+
+    TEST(DebugTraceRecorderTest, ringBufferOfRunningThreadShouldKeepLastEvents)
+    {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.start(4, ".");
+        std::promise<void> recorded;
+        std::promise<void> written;
+        std::thread thread([&]
+        {
+            for (int i = 0; i < 10; ++i)
+                recorder.recordCounter("Test", "runningRingBufferCounter", 100 + i);
+            recorded.set_value();
+            written.get_future().wait();
+        });
+        recorded.get_future().wait();
+        std::ostringstream stream;
+        recorder.writeChromeTrace(stream);
+        written.set_value();
+        thread.join();
+        recorder.stop();
+        const std::string trace = stream.str();
+        EXPECT_EQ(countOccurrences(trace, "runningRingBufferCounter"), 4) << trace;
+        EXPECT_EQ(trace.find("\"value\":105.000"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"value\":106.000"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"value\":109.000"), std::string::npos) << trace;
+    }
+
+    TEST(DebugTraceRecorderTest, bufferOfExitedThreadShouldBeReused)
+    {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.start(4, ".");
+        const auto writeTrace = [&]
+        {
+            std::ostringstream stream;
+            recorder.writeChromeTrace(stream);
+            return stream.str();
+        };
+        runInThread([&] { recorder.recordCounter("Test", "exitedThreadCounter", 1); });
+        const std::size_t buffersCount = countOccurrences(writeTrace(), "\"thread_name\"");
+        runInThread([&]
+        {
+            recorder.setThreadName("reusing thread");
+            recorder.recordCounter("Test", "reusingThreadCounter", 1);
+        });
+        recorder.stop();
+        const std::string trace = writeTrace();
+        EXPECT_EQ(countOccurrences(trace, "\"thread_name\""), buffersCount) << trace;
+        EXPECT_EQ(trace.find("exitedThreadCounter"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("reusingThreadCounter"), std::string::npos) << trace;
+        EXPECT_NE(trace.find("\"reusing thread\""), std::string::npos) << trace;
+    }
+
+    TEST(DebugTraceRecorderTest, nothingShouldBeRecordedWhenStopped)
+    {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        recorder.stop();
+        runInThread([&]
+        {
+            TraceZone zone("Test", "zoneShouldNotBeWritten");
+        });
+        std::ostringstream stream;
+        recorder.writeChromeTrace(stream);
+        EXPECT_EQ(stream.str().find("zoneShouldNotBeWritten"), std::string::npos);
+    }
+}
@@ -3,6 +3,7 @@
 
 #include <components/detournavigator/navigatorimpl.hpp>
 #include <components/detournavigator/exceptions.hpp>
+#include <components/detournavigator/findtilepath.hpp>
 #include <components/detournavigator/navigatorutils.hpp>
 #include <components/detournavigator/navmeshdb.hpp>
 #include <components/misc/rng.hpp>
@@ -133,6 +134,14 @@ namespace
                   Status::StartPolygonNotFound);
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, find_path_async_for_empty_should_return_empty)
+    {
+        const PathQuery query {mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance};
+        const PathQueryResult result = mNavigator->findPathAsync(query, 0).get();
+        EXPECT_EQ(result.mStatus, Status::NavMeshNotFound);
+        EXPECT_EQ(result.mPath, std::vector<osg::Vec3f>());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_agent_should_count_each_agent)
     {
         mNavigator->addAgent(mAgentHalfExtents);
@@ -188,6 +197,39 @@ namespace
         )) << mPath;
     }
 
+    TEST_F(DetourNavigatorNavigatorTest, update_then_find_path_async_should_return_same_path_as_find_path)
+    {
+        constexpr std::array<float, 5 * 5> heightfieldData {{
+            0,   0,    0,    0,    0,
+            0, -25,  -25,  -25,  -25,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+            0, -25, -100, -100, -100,
+        }};
+        const HeightfieldSurface surface = makeSquareHeightfieldSurface(heightfieldData);
+        const int cellSize = mHeightfieldTileSize * (surface.mSize - 1);
+
+        mNavigator->addAgent(mAgentHalfExtents);
+        mNavigator->addHeightfield(mCellPosition, cellSize, surface);
+        mNavigator->update(mPlayerPosition);
+        mNavigator->wait(mListener, WaitConditionType::requiredTilesPresent);
+
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance, mOut),
+                  Status::Success);
+
+        const PathQuery query {mAgentHalfExtents, mStepSize, mStart, mEnd, Flag_walk, mAreaCosts, mEndTolerance};
+        std::vector<std::future<PathQueryResult>> results;
+        for (int i = 0; i < 4; ++i)
+            results.push_back(mNavigator->findPathAsync(query, static_cast<float>(i)));
+
+        for (auto& result : results)
+        {
+            const PathQueryResult value = result.get();
+            EXPECT_EQ(value.mStatus, Status::Success);
+            EXPECT_THAT(value.mPath, ElementsAreArray(mPath));
+        }
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, add_object_should_change_navmesh)
     {
         const std::array<float, 5 * 5> heightfieldData {{
@@ -1045,6 +1087,71 @@ namespace
         )) << mPath;
     }
 
+    struct DetourNavigatorNavigatorFarDestinationTest : DetourNavigatorNavigatorTest
+    {
+        const osg::Vec3f mFarEnd {3500, 460, 1};
+
+        DetourNavigatorNavigatorFarDestinationTest()
+        {
+            mSettings.mDetour.mPathRefinementTiles = 1;
+            mNavigator.reset(new NavigatorImpl(mSettings, std::make_unique<NavMeshDb>(":memory:")));
+
+            const HeightfieldPlane plane {100};
+            const int cellSize = mHeightfieldTileSize * 32;
+
+            mNavigator->addAgent(mAgentHalfExtents);
+            mNavigator->addHeightfield(mCellPosition, cellSize, plane);
+            mNavigator->update(mPlayerPosition);
+            mNavigator->wait(mListener, WaitConditionType::allJobsDone);
+        }
+    };
+
+    TEST_F(DetourNavigatorNavigatorFarDestinationTest, find_path_with_allowed_coarse_path_should_refine_only_nearest_part_of_tiles_route)
+    {
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mFarEnd, Flag_walk, mAreaCosts,
+                           mEndTolerance, true, mOut),
+                  Status::Success);
+
+        ASSERT_FALSE(mPath.empty());
+        EXPECT_GT(mPath.back().x(), 500);
+        EXPECT_LT(mPath.back().x(), 2000);
+    }
+
+    TEST_F(DetourNavigatorNavigatorFarDestinationTest, find_path_should_build_complete_path_by_default)
+    {
+        EXPECT_EQ(findPath(*mNavigator, mAgentHalfExtents, mStepSize, mStart, mFarEnd, Flag_walk, mAreaCosts,
+                           mEndTolerance, mOut),
+                  Status::Success);
+
+        ASSERT_FALSE(mPath.empty());
+        EXPECT_NEAR(mPath.back().x(), mFarEnd.x(), 1);
+        EXPECT_NEAR(mPath.back().y(), mFarEnd.y(), 1);
+    }
+
+    TEST_F(DetourNavigatorNavigatorFarDestinationTest, find_coarse_path_target_should_give_nothing_when_tiles_route_search_exceeds_max_nodes)
+    {
+        const auto navMesh = mNavigator->getNavMesh(mAgentHalfExtents);
+        ASSERT_NE(navMesh, nullptr);
+        const auto locked = navMesh->lockConst();
+        const dtNavMesh& impl = locked->getImpl();
+
+        dtNavMeshQuery query;
+        ASSERT_TRUE(initNavMeshQuery(query, impl, mSettings.mDetour.mMaxNavMeshQueryNodes));
+        dtQueryFilter filter;
+        filter.setIncludeFlags(Flag_walk);
+        const osg::Vec3f halfExtents = toNavMeshCoordinates(mSettings.mRecast, mAgentHalfExtents) * 4;
+        const dtPolyRef startRef = findNearestPoly(query, filter, toNavMeshCoordinates(mSettings.mRecast, mStart),
+                                                   halfExtents);
+        const dtPolyRef endRef = findNearestPoly(query, filter, toNavMeshCoordinates(mSettings.mRecast, mFarEnd),
+                                                 halfExtents);
+        ASSERT_NE(startRef, 0);
+        ASSERT_NE(endRef, 0);
+
+        const int refinementTiles = mSettings.mDetour.mPathRefinementTiles;
+        EXPECT_TRUE(findCoarsePathTarget(impl, query, filter, startRef, endRef, refinementTiles, 1000).has_value());
+        EXPECT_FALSE(findCoarsePathTarget(impl, query, filter, startRef, endRef, refinementTiles, 1).has_value());
+    }
+
     TEST_F(DetourNavigatorNavigatorTest, for_not_reachable_destination_find_path_should_provide_partial_path)
     {
         const std::array<float, 5 * 5> heightfieldData {{
@@ -380,4 +380,45 @@ namespace
         EXPECT_FALSE(cache.set(mAgentHalfExtents, mTilePosition, anotherRecastMesh, std::move(anotherData)));
         EXPECT_TRUE(cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh));
     }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, compressed_set_should_leave_value_and_get_should_unpack_same_value)
+    {
+        const std::size_t maxSize = mRecastMeshSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize, true);
+        const auto copy = clone(*mPreparedNavMeshData);
+
+        ASSERT_TRUE(cache.set(mAgentHalfExtents, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData)));
+        EXPECT_NE(mPreparedNavMeshData, nullptr);
+        const auto result = cache.get(mAgentHalfExtents, mTilePosition, mRecastMesh);
+        ASSERT_TRUE(result);
+        std::unique_ptr<PreparedNavMeshData> buffer;
+        const PreparedNavMeshData* const unpacked = result.get(buffer);
+        ASSERT_NE(unpacked, nullptr);
+        EXPECT_EQ(unpacked, buffer.get());
+        EXPECT_EQ(*unpacked, *copy);
+    }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, stats_should_report_raw_size_for_compressed_cache)
+    {
+        const std::size_t maxSize = mRecastMeshSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize, true);
+
+        ASSERT_TRUE(cache.set(mAgentHalfExtents, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData)));
+        const NavMeshTilesCache::Stats stats = cache.getStats();
+        EXPECT_EQ(stats.mNavMeshCacheRawSize, maxSize);
+        EXPECT_GT(stats.mNavMeshCacheSize, mRecastMeshSize);
+    }
+
+    TEST_F(DetourNavigatorNavMeshTilesCacheTest, get_with_buffer_for_not_compressed_cache_should_not_use_buffer)
+    {
+        const std::size_t maxSize = mRecastMeshSize + mPreparedNavMeshDataSize;
+        NavMeshTilesCache cache(maxSize);
+
+        const auto result = cache.set(mAgentHalfExtents, mTilePosition, mRecastMesh, std::move(mPreparedNavMeshData));
+        ASSERT_TRUE(result);
+        std::unique_ptr<PreparedNavMeshData> buffer;
+        EXPECT_EQ(result.get(buffer), &result.get());
+        EXPECT_EQ(buffer, nullptr);
+        EXPECT_EQ(cache.getStats().mNavMeshCacheRawSize, cache.getStats().mNavMeshCacheSize);
+    }
 }
@@ -66,7 +66,7 @@ return {}
     {
         internal::CaptureStdout();
         LuaUtil::LuaState lua{mVFS.get(), &mCfg};
-        sol::state& l = lua.sol();
+        sol::state_view& l = lua.sol();
         LuaUtil::I18nManager i18n(mVFS.get(), &lua);
         lua.addInternalLibSearchPath(mLibsPath);
         i18n.init();
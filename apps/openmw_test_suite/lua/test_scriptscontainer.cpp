@@ -28,6 +28,28 @@ return {
         Print = function() print('print') end
     }
 }
+)X");
+
+    TestFile profiledScript(R"X(
+local data = {}
+return {
+    engineHandlers = {
+        onUpdate = function()
+            for i = 1, 100 do data[i] = string.rep('x', 4000 + i) end
+        end,
+    },
+}
+)X");
+
+    TestFile smallObjectsScript(R"X(
+local data = {}
+return {
+    engineHandlers = {
+        onUpdate = function()
+            for i = 1, 10000 do data[i] = {i} end
+        end,
+    },
+}
 )X");
 
     TestFile stopEventScript(R"X(
@@ -126,6 +148,8 @@ return {
             {"testInterface.lua", &interfaceScript},
             {"overrideInterface.lua", &overrideInterfaceScript},
             {"useInterface.lua", &useInterfaceScript},
+            {"profiled.lua", &profiledScript},
+            {"smallObjects.lua", &smallObjectsScript},
         });
 
         LuaUtil::ScriptsConfiguration mCfg;
@@ -145,6 +169,8 @@ return {
             cfg.mScripts.push_back({"testInterface.lua", "", ESM::LuaScriptCfg::sCustom | ESM::LuaScriptCfg::sPlayer});
             cfg.mScripts.push_back({"overrideInterface.lua", "", ESM::LuaScriptCfg::sCustom | ESM::LuaScriptCfg::sPlayer});
             cfg.mScripts.push_back({"useInterface.lua", "", ESM::LuaScriptCfg::sCustom | ESM::LuaScriptCfg::sPlayer});
+            cfg.mScripts.push_back({"profiled.lua", "", ESM::LuaScriptCfg::sCustom});
+            cfg.mScripts.push_back({"smallObjects.lua", "", ESM::LuaScriptCfg::sCustom});
             mCfg.init(std::move(cfg));
         }
     };
@@ -460,4 +486,70 @@ return {
         EXPECT_EQ(internal::GetCapturedStdout(), "Ignored callback to the removed script some_script.lua\n");
     }
 
+    TEST_F(LuaScriptsContainerTest, Profiler)
+    {
+        LuaUtil::LuaStateSettings settings;
+        settings.mProfiler = true;
+        LuaUtil::LuaState lua(mVFS.get(), &mCfg, settings);
+        if (!lua.isProfilerEnabled())
+            GTEST_SKIP() << "Custom Lua allocator is not supported";
+
+        const int scriptId = *mCfg.findId("profiled.lua");
+        {
+            LuaUtil::ScriptsContainer scripts(&lua, "Test");
+            EXPECT_TRUE(scripts.addCustomScript(scriptId));
+            scripts.update(1.5f);
+            scripts.update(1.5f);
+
+            ASSERT_GT(lua.getScriptsProfile().size(), static_cast<std::size_t>(scriptId));
+            const LuaUtil::ScriptProfile& profile = lua.getScriptsProfile()[scriptId];
+            EXPECT_GT(profile.mMemoryUsage, 100 * 4000);
+            EXPECT_GT(lua.getTotalMemoryUsage(), profile.mMemoryUsage);
+            const auto handler = profile.mHandlers.find("onUpdate");
+            ASSERT_NE(handler, profile.mHandlers.end());
+            EXPECT_EQ(handler->second.mCalls, 2u);
+            EXPECT_GE(handler->second.mTotalTime, handler->second.mMaxTime);
+            EXPECT_GT(profile.mFrameTime.count(), 0);
+
+            lua.resetFrameProfile();
+            EXPECT_EQ(lua.getScriptsProfile()[scriptId].mFrameTime.count(), 0);
+        }
+        lua.sol().collect_garbage();
+        EXPECT_LT(lua.getScriptsProfile()[scriptId].mMemoryUsage, 100 * 4000);
+    }
+
+    TEST_F(LuaScriptsContainerTest, MemoryHardLimit)
+    {
+        LuaUtil::LuaStateSettings settings;
+        settings.mScriptMemoryHardLimit = 100 * 4000;
+        LuaUtil::LuaState lua(mVFS.get(), &mCfg, settings);
+        if (!lua.hasCustomAllocator())
+            GTEST_SKIP() << "Custom Lua allocator is not supported";
+
+        LuaUtil::ScriptsContainer scripts(&lua, "Test");
+        EXPECT_TRUE(scripts.addCustomScript(*mCfg.findId("profiled.lua")));
+        testing::internal::CaptureStdout();
+        scripts.update(1.5f);
+        EXPECT_THAT(testing::internal::GetCapturedStdout(), HasSubstr("Test[profiled.lua] onUpdate failed"));
+        EXPECT_LE(lua.getScriptsProfile()[*mCfg.findId("profiled.lua")].mMemoryUsage, 100 * 4000);
+    }
+
+    TEST_F(LuaScriptsContainerTest, MemoryHardLimitShouldCountSmallAllocations)
+    {
+        LuaUtil::LuaStateSettings settings;
+        settings.mScriptMemoryHardLimit = 100 * 4000;
+        LuaUtil::LuaState lua(mVFS.get(), &mCfg, settings);
+        if (!lua.hasCustomAllocator())
+            GTEST_SKIP() << "Custom Lua allocator is not supported";
+
+        const int scriptId = *mCfg.findId("smallObjects.lua");
+        LuaUtil::ScriptsContainer scripts(&lua, "Test");
+        EXPECT_TRUE(scripts.addCustomScript(scriptId));
+        testing::internal::CaptureStdout();
+        scripts.update(1.5f);
+        EXPECT_THAT(testing::internal::GetCapturedStdout(), HasSubstr("Test[smallObjects.lua] onUpdate failed"));
+        EXPECT_LE(lua.getScriptsProfile()[scriptId].mMemoryUsage, 100 * 4000);
+        EXPECT_GT(lua.getSmallAllocMemoryUsage(), 100 * 4000 / 2);
+    }
+
 }
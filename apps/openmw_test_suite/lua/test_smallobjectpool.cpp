@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <components/lua/smallobjectpool.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+namespace
+{
+    using LuaUtil::SmallObjectPool;
+
+    TEST(LuaSmallObjectPoolTest, AllocatedBlocksShouldBeAlignedAndNotOverlap)
+    {
+        SmallObjectPool pool;
+        std::vector<std::pair<void*, std::size_t>> blocks;
+        for (std::size_t size = 1; size <= SmallObjectPool::sMaxSize; ++size)
+        {
+            void* ptr = pool.reallocate(nullptr, 0, size);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % SmallObjectPool::sGranularity, 0u);
+            std::memset(ptr, static_cast<int>(size), size);
+            blocks.emplace_back(ptr, size);
+        }
+        for (const auto& [ptr, size] : blocks)
+        {
+            const unsigned char* data = static_cast<const unsigned char*>(ptr);
+            for (std::size_t i = 0; i < size; ++i)
+                ASSERT_EQ(data[i], static_cast<unsigned char>(size));
+            pool.reallocate(ptr, size, 0);
+        }
+    }
+
+    TEST(LuaSmallObjectPoolTest, FreedBlockShouldBeReused)
+    {
+        SmallObjectPool pool;
+        void* first = pool.reallocate(nullptr, 0, 24);
+        pool.reallocate(first, 24, 0);
+        EXPECT_EQ(pool.reallocate(nullptr, 0, 32), first);
+        EXPECT_EQ(pool.getChunksCount(), 1u);
+    }
+
+    TEST(LuaSmallObjectPoolTest, ReallocateWithinSizeClassShouldKeepPointer)
+    {
+        SmallObjectPool pool;
+        void* ptr = pool.reallocate(nullptr, 0, 17);
+        EXPECT_EQ(pool.reallocate(ptr, 17, 32), ptr);
+        pool.reallocate(ptr, 32, 0);
+    }
+
+    TEST(LuaSmallObjectPoolTest, ReallocateShouldPreserveDataBetweenPoolAndMalloc)
+    {
+        SmallObjectPool pool;
+        char* ptr = static_cast<char*>(pool.reallocate(nullptr, 0, 8));
+        std::memcpy(ptr, "abcdefg", 8);
+        ptr = static_cast<char*>(pool.reallocate(ptr, 8, 100));
+        EXPECT_STREQ(ptr, "abcdefg");
+        ptr = static_cast<char*>(pool.reallocate(ptr, 100, 1000));
+        EXPECT_STREQ(ptr, "abcdefg");
+        ptr = static_cast<char*>(pool.reallocate(ptr, 1000, 8));
+        EXPECT_STREQ(ptr, "abcdefg");
+        EXPECT_EQ(pool.reallocate(ptr, 8, 0), nullptr);
+    }
+
+    TEST(LuaSmallObjectPoolTest, ShouldAllocateNewChunkWhenCurrentIsFull)
+    {
+        SmallObjectPool pool;
+        std::set<void*> blocks;
+        const std::size_t count = 2 * SmallObjectPool::sChunkSize / SmallObjectPool::sMaxSize;
+        for (std::size_t i = 0; i < count; ++i)
+            blocks.insert(pool.allocate(SmallObjectPool::sMaxSize));
+        EXPECT_EQ(blocks.size(), count);
+        EXPECT_GE(pool.getChunksCount(), 2u);
+    }
+
+    TEST(LuaSmallObjectPoolTest, BlocksShouldKeepTheirOwner)
+    {
+        SmallObjectPool pool;
+        void* noOwner = pool.allocate(32);
+        void* first = pool.allocate(32, 1);
+        void* second = pool.allocate(32, 2);
+        EXPECT_EQ(SmallObjectPool::getOwner(noOwner), -1);
+        EXPECT_EQ(SmallObjectPool::getOwner(first), 1);
+        EXPECT_EQ(SmallObjectPool::getOwner(second), 2);
+        EXPECT_EQ(pool.getChunksCount(), 3u);
+        void* reallocated = pool.reallocate(first, 32, 200, 1);
+        EXPECT_EQ(SmallObjectPool::getOwner(reallocated), 1);
+    }
+
+    TEST(LuaSmallObjectPoolTest, FreedBlockShouldBeReusedOnlyBySameOwner)
+    {
+        SmallObjectPool pool;
+        void* first = pool.allocate(32, 1);
+        pool.deallocate(first, 32);
+        void* second = pool.allocate(32, 2);
+        EXPECT_NE(second, first);
+        EXPECT_EQ(SmallObjectPool::getOwner(second), 2);
+        EXPECT_EQ(pool.allocate(32, 1), first);
+    }
+}
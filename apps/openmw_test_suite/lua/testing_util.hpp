@@ -11,7 +11,7 @@ namespace
 {
 
     template <typename T>
-    T get(sol::state& lua, const std::string& luaCode)
+    T get(sol::state_view& lua, const std::string& luaCode)
     {
         return lua.safe_script("return " + luaCode).get<T>();
     }
@@ -0,0 +1,282 @@
+#include <components/misc/taskscheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    struct Gate
+    {
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        bool mOpen = false;
+
+        void open()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mMutex);
+                mOpen = true;
+            }
+            mCondition.notify_all();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mCondition.wait(lock, [&] { return mOpen; });
+        }
+    };
+
+    TEST(MiscTaskSchedulerTest, submittedTaskShouldBeDone)
+    {
+        TaskScheduler scheduler(2);
+        std::atomic<int> value {0};
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { value = 42; });
+        task->wait();
+        EXPECT_TRUE(task->isDone());
+        EXPECT_FALSE(task->isCancelled());
+        EXPECT_EQ(value, 42);
+    }
+
+    TEST(MiscTaskSchedulerTest, allTasksShouldBeDone)
+    {
+        TaskScheduler scheduler(4);
+        std::atomic<int> counter {0};
+        std::vector<TaskScheduler::TaskPtr> tasks;
+        for (int i = 0; i < 1000; ++i)
+            tasks.push_back(scheduler.submit([&] { ++counter; }));
+        for (const TaskScheduler::TaskPtr& task : tasks)
+            task->wait();
+        EXPECT_EQ(counter, 1000);
+    }
+
+    TEST(MiscTaskSchedulerTest, taskShouldStartAfterDependencies)
+    {
+        TaskScheduler scheduler(4);
+        Gate gate;
+        std::atomic<int> finished {0};
+        std::vector<TaskScheduler::TaskPtr> dependencies;
+        for (int i = 0; i < 3; ++i)
+            dependencies.push_back(scheduler.submit([&] { gate.wait(); ++finished; }));
+        int finishedBefore = -1;
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { finishedBefore = finished; },
+            TaskPriority::Normal, dependencies);
+        EXPECT_FALSE(task->isDone());
+        gate.open();
+        task->wait();
+        EXPECT_EQ(finishedBefore, 3);
+    }
+
+    TEST(MiscTaskSchedulerTest, cancelledTaskShouldNotRun)
+    {
+        TaskScheduler scheduler(1);
+        Gate gate;
+        const TaskScheduler::TaskPtr blocker = scheduler.submit([&] { gate.wait(); });
+        bool ran = false;
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { ran = true; });
+        EXPECT_TRUE(task->cancel());
+        EXPECT_TRUE(task->isDone());
+        EXPECT_TRUE(task->isCancelled());
+        gate.open();
+        blocker->wait();
+        const TaskScheduler::TaskPtr after = scheduler.submit([] {});
+        after->wait();
+        EXPECT_FALSE(ran);
+    }
+
+    TEST(MiscTaskSchedulerTest, runOrWaitShouldRunNotStartedTaskInCallingThread)
+    {
+        TaskScheduler scheduler(1);
+        Gate gate;
+        const TaskScheduler::TaskPtr blocker = scheduler.submit([&] { gate.wait(); });
+        std::thread::id runThread;
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { runThread = std::this_thread::get_id(); });
+        task->runOrWait();
+        EXPECT_TRUE(task->isDone());
+        EXPECT_FALSE(task->isCancelled());
+        EXPECT_EQ(runThread, std::this_thread::get_id());
+        gate.open();
+        blocker->wait();
+        const TaskScheduler::TaskPtr after = scheduler.submit([] {});
+        after->wait();
+        task->runOrWait();
+        EXPECT_EQ(runThread, std::this_thread::get_id());
+    }
+
+    TEST(MiscTaskSchedulerTest, runOrWaitShouldWaitForTaskWithPendingDependencies)
+    {
+        TaskScheduler scheduler(2);
+        Gate gate;
+        std::atomic<bool> dependencyFinished {false};
+        const TaskScheduler::TaskPtr dependency = scheduler.submit([&] { gate.wait(); dependencyFinished = true; });
+        bool finishedBefore = false;
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { finishedBefore = dependencyFinished; },
+            TaskPriority::Normal, {dependency});
+        std::thread opener([&] { gate.open(); });
+        task->runOrWait();
+        opener.join();
+        EXPECT_TRUE(finishedBefore);
+    }
+
+    TEST(MiscTaskSchedulerTest, cancelShouldNotAffectFinishedTask)
+    {
+        TaskScheduler scheduler(1);
+        const TaskScheduler::TaskPtr task = scheduler.submit([] {});
+        task->wait();
+        EXPECT_FALSE(task->cancel());
+        EXPECT_FALSE(task->isCancelled());
+    }
+
+    TEST(MiscTaskSchedulerTest, dependentOfCancelledTaskShouldRun)
+    {
+        TaskScheduler scheduler(1);
+        Gate gate;
+        const TaskScheduler::TaskPtr blocker = scheduler.submit([&] { gate.wait(); });
+        const TaskScheduler::TaskPtr cancelled = scheduler.submit([] {});
+        std::atomic<bool> ran {false};
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { ran = true; }, TaskPriority::Normal, {cancelled});
+        cancelled->cancel();
+        gate.open();
+        task->wait();
+        EXPECT_TRUE(ran);
+    }
+
+    TEST(MiscTaskSchedulerTest, higherPriorityTaskShouldRunFirst)
+    {
+        TaskScheduler scheduler(1);
+        Gate gate;
+        const TaskScheduler::TaskPtr blocker = scheduler.submit([&] { gate.wait(); });
+        std::vector<int> order;
+        std::vector<TaskScheduler::TaskPtr> tasks;
+        tasks.push_back(scheduler.submit([&] { order.push_back(2); }, TaskPriority::Low));
+        tasks.push_back(scheduler.submit([&] { order.push_back(1); }, TaskPriority::Normal));
+        tasks.push_back(scheduler.submit([&] { order.push_back(0); }, TaskPriority::High));
+        gate.open();
+        for (const TaskScheduler::TaskPtr& task : tasks)
+            task->wait();
+        EXPECT_EQ(order, (std::vector<int> {0, 1, 2}));
+    }
+
+    TEST(MiscTaskSchedulerTest, tasksWithSamePriorityShouldRunInSubmissionOrderWithSingleThread)
+    {
+        TaskScheduler scheduler(1);
+        std::vector<int> order;
+        std::vector<TaskScheduler::TaskPtr> tasks;
+        for (int i = 0; i < 10; ++i)
+            tasks.push_back(scheduler.submit([&order, i] { order.push_back(i); }));
+        for (const TaskScheduler::TaskPtr& task : tasks)
+            task->wait();
+        EXPECT_EQ(order, (std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    TEST(MiscTaskSchedulerTest, taskSubmittedFromTaskShouldBeDone)
+    {
+        TaskScheduler scheduler(2);
+        std::atomic<int> value {0};
+        TaskScheduler::TaskPtr inner;
+        std::mutex mutex;
+        const TaskScheduler::TaskPtr outer = scheduler.submit([&]
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            inner = scheduler.submit([&] { value = 13; });
+        });
+        outer->wait();
+        const std::lock_guard<std::mutex> lock(mutex);
+        inner->wait();
+        EXPECT_EQ(value, 13);
+    }
+
+    TEST(MiscTaskSchedulerTest, parallelForShouldCallFunctionForEachIndexOnce)
+    {
+        TaskScheduler scheduler(4);
+        std::vector<std::atomic<int>> calls(1000);
+        scheduler.parallelFor(calls.size(), [&] (std::size_t i) { ++calls[i]; });
+        for (const std::atomic<int>& value : calls)
+            EXPECT_EQ(value, 1);
+    }
+
+    TEST(MiscTaskSchedulerTest, parallelForFromTaskShouldNotDeadlockWithSingleThread)
+    {
+        TaskScheduler scheduler(1);
+        std::atomic<int> counter {0};
+        const TaskScheduler::TaskPtr task = scheduler.submit([&]
+        {
+            scheduler.parallelFor(10, [&] (std::size_t) { ++counter; });
+        });
+        task->wait();
+        EXPECT_EQ(counter, 10);
+    }
+
+    // Opens the gate when the queued tasks are drained by stop, the only thread of the scheduler is blocked meanwhile.
+    std::thread openWhenQueueIsDrained(const TaskScheduler& scheduler, Gate& gate)
+    {
+        return std::thread([&]
+        {
+            while (scheduler.getQueuedTasksCount() != 0)
+                std::this_thread::yield();
+            gate.open();
+        });
+    }
+
+    TEST(MiscTaskSchedulerTest, destructorShouldCancelNotStartedTasks)
+    {
+        Gate gate;
+        std::atomic<bool> started {false};
+        std::atomic<bool> ran {false};
+        TaskScheduler::TaskPtr blocker;
+        TaskScheduler::TaskPtr task;
+        std::thread opener;
+        {
+            TaskScheduler scheduler(1);
+            blocker = scheduler.submit([&] { started = true; gate.wait(); });
+            task = scheduler.submit([&] { ran = true; });
+            while (!started)
+                std::this_thread::yield();
+            opener = openWhenQueueIsDrained(scheduler, gate);
+        }
+        opener.join();
+        EXPECT_FALSE(blocker->isCancelled());
+        EXPECT_TRUE(task->isDone());
+        EXPECT_TRUE(task->isCancelled());
+        EXPECT_FALSE(ran);
+    }
+
+    TEST(MiscTaskSchedulerTest, stopShouldWaitForRunningTaskAndCancelNotStartedTasks)
+    {
+        Gate gate;
+        TaskScheduler scheduler(1);
+        std::atomic<bool> started {false};
+        std::atomic<bool> ran {false};
+        const TaskScheduler::TaskPtr blocker = scheduler.submit([&] { started = true; gate.wait(); });
+        const TaskScheduler::TaskPtr task = scheduler.submit([&] { ran = true; });
+        const TaskScheduler::TaskPtr dependent = scheduler.submit([&] { ran = true; }, TaskPriority::Normal, {task});
+        while (!started)
+            std::this_thread::yield();
+        std::thread opener = openWhenQueueIsDrained(scheduler, gate);
+        scheduler.stop();
+        opener.join();
+        EXPECT_TRUE(blocker->isDone());
+        EXPECT_FALSE(blocker->isCancelled());
+        EXPECT_TRUE(task->isDone());
+        EXPECT_TRUE(task->isCancelled());
+        EXPECT_TRUE(dependent->isCancelled());
+        EXPECT_FALSE(ran);
+    }
+
+    TEST(MiscTaskSchedulerTest, taskSubmittedAfterStopShouldBeCancelled)
+    {
+        TaskScheduler scheduler(2);
+        scheduler.stop();
+        const TaskScheduler::TaskPtr task = scheduler.submit([] {});
+        EXPECT_TRUE(task->isCancelled());
+        EXPECT_TRUE(task->isDone());
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "apps/openmw/mwdialogue/infoindex.hpp"
+
+#include <components/esm3/loaddial.hpp>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWDialogue;
+
+    struct MWDialogueInfoIndexTest : Test
+    {
+        ESM::Dialogue mDialogue;
+        InfoIndex::Speaker mSpeaker;
+
+        MWDialogueInfoIndexTest()
+        {
+            mSpeaker.mId = "fargoth";
+            mSpeaker.mClass = "commoner";
+            mSpeaker.mRace = "wood elf";
+        }
+
+        ESM::DialInfo& addInfo(const std::string& id)
+        {
+            ESM::DialInfo& info = mDialogue.mInfo.emplace_back();
+            info.mId = id;
+            info.mFactionLess = false;
+            return info;
+        }
+
+        std::vector<std::string> getCandidates() const
+        {
+            const InfoIndex index(mDialogue);
+            std::vector<std::string> result;
+            index.forEachCandidate(mSpeaker, [&] (const InfoIndex::Entry& entry)
+            {
+                result.push_back(entry.mInfo->mId);
+                return true;
+            });
+            return result;
+        }
+    };
+
+    TEST_F(MWDialogueInfoIndexTest, should_skip_infos_for_other_speakers)
+    {
+        addInfo("actor").mActor = "Fargoth";
+        addInfo("other_actor").mActor = "Hrisskar Flat-Foot";
+        addInfo("class").mClass = "Commoner";
+        addInfo("other_class").mClass = "Guard";
+        addInfo("race").mRace = "Wood Elf";
+        addInfo("other_race").mRace = "Dark Elf";
+        addInfo("other_faction").mFaction = "Hlaalu";
+        addInfo("any");
+        EXPECT_EQ(getCandidates(), (std::vector<std::string> {"actor", "class", "race", "any"}));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_keep_order_of_dialogue)
+    {
+        mSpeaker.mFaction = "hlaalu";
+        addInfo("any1");
+        addInfo("race").mRace = "Wood Elf";
+        addInfo("faction").mFaction = "Hlaalu";
+        addInfo("actor").mActor = "fargoth";
+        addInfo("any2");
+        addInfo("class").mClass = "commoner";
+        EXPECT_EQ(getCandidates(), (std::vector<std::string> {"any1", "race", "faction", "actor", "any2", "class"}));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_use_only_bucket_of_most_selective_condition)
+    {
+        ESM::DialInfo& info = addInfo("class_and_race");
+        info.mClass = "Guard";
+        info.mRace = "Wood Elf";
+        EXPECT_EQ(getCandidates(), std::vector<std::string>());
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_ignore_faction_for_factionless_infos)
+    {
+        ESM::DialInfo& info = addInfo("factionless");
+        info.mFaction = "Hlaalu";
+        info.mFactionLess = true;
+        EXPECT_EQ(getCandidates(), (std::vector<std::string> {"factionless"}));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_give_only_infos_for_creature_id)
+    {
+        mSpeaker = InfoIndex::Speaker();
+        mSpeaker.mId = "mudcrab";
+        mSpeaker.mIsCreature = true;
+        addInfo("actor").mActor = "Mudcrab";
+        addInfo("any");
+        EXPECT_EQ(getCandidates(), (std::vector<std::string> {"actor"}));
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_stop_when_function_returns_false)
+    {
+        addInfo("first");
+        addInfo("second");
+        const InfoIndex index(mDialogue);
+        std::size_t count = 0;
+        index.forEachCandidate(mSpeaker, [&] (const InfoIndex::Entry&) { ++count; return false; });
+        EXPECT_EQ(count, 1);
+    }
+
+    TEST_F(MWDialogueInfoIndexTest, should_decode_selects)
+    {
+        ESM::DialInfo& info = addInfo("select");
+        info.mSelects.emplace_back().mSelectRule = "02X00Global";
+        info.mSelects.emplace_back().mSelectRule = "01573";
+        const InfoIndex index(mDialogue);
+        std::vector<const SelectWrapper*> selects;
+        index.forEachCandidate(mSpeaker, [&] (const InfoIndex::Entry& entry)
+        {
+            for (const SelectWrapper& select : entry.mSelects)
+                selects.push_back(&select);
+            return true;
+        });
+        ASSERT_EQ(selects.size(), 2);
+        EXPECT_EQ(selects[0]->getFunction(), SelectWrapper::Function_Global);
+        EXPECT_EQ(selects[0]->getType(), SelectWrapper::Type_Numeric);
+        EXPECT_EQ(selects[0]->getName(), "global");
+        EXPECT_EQ(selects[1]->getFunction(), SelectWrapper::Function_PcAttribute);
+        EXPECT_EQ(selects[1]->getArgument(), 7);
+        EXPECT_EQ(selects[1]->getType(), SelectWrapper::Type_Integer);
+        EXPECT_FALSE(selects[1]->isNpcOnly());
+    }
+}
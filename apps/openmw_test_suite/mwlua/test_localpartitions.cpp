@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+
+#include "apps/openmw/mwlua/localpartitions.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWLua;
+
+    constexpr std::size_t objectsCount = 100;
+
+    // Every object writes its id to the first queue and a few values to the second queue of its partition.
+    // Partition 0 writes to the result queues directly, like partition 0 of LuaManager.
+    std::pair<std::vector<int>, std::vector<int>> runUpdate(std::size_t partitionsCount)
+    {
+        std::vector<int> ids {-1};
+        std::vector<int> values {-2, -3};
+        const std::size_t idsBase = ids.size();
+        const std::size_t valuesBase = values.size();
+
+        std::vector<std::vector<int>> partitionIds(partitionsCount);
+        std::vector<std::vector<int>> partitionValues(partitionsCount);
+        std::vector<std::vector<int>*> idsSources {&ids};
+        std::vector<std::vector<int>*> valuesSources {&values};
+        for (std::size_t i = 1; i < partitionsCount; ++i)
+        {
+            idsSources.push_back(&partitionIds[i]);
+            valuesSources.push_back(&partitionValues[i]);
+        }
+
+        std::vector<std::vector<OutputSegment<2>>> segments(partitionsCount);
+        PartitionsRunner runner(partitionsCount, [&] (std::size_t partition)
+        {
+            // Objects of a partition are processed in the reverse order, the merge has to restore it
+            for (std::size_t id = objectsCount; id-- > 0;)
+            {
+                if (id % partitionsCount != partition)
+                    continue;
+                std::vector<int>& dstIds = *idsSources[partition];
+                std::vector<int>& dstValues = *valuesSources[partition];
+                const std::array<std::size_t, 2> begin {dstIds.size(), dstValues.size()};
+                if (id % 3 != 0)
+                    dstIds.push_back(static_cast<int>(id));
+                for (std::size_t i = 0; i < id % 4; ++i)
+                    dstValues.push_back(static_cast<int>(id * 10 + i));
+                const std::array<std::size_t, 2> end {dstIds.size(), dstValues.size()};
+                if (begin != end)
+                    segments[partition].push_back({{0, id}, partition, begin, end});
+            }
+        });
+        runner.run();
+
+        std::vector<const std::vector<OutputSegment<2>>*> partitionsSegments;
+        for (const auto& v : segments)
+            partitionsSegments.push_back(&v);
+        const auto sorted = sortOutputSegments(partitionsSegments);
+        mergeOutput(sorted, 0, idsSources, ids, idsBase);
+        mergeOutput(sorted, 1, valuesSources, values, valuesBase);
+        for (std::size_t i = 1; i < partitionsCount; ++i)
+        {
+            EXPECT_TRUE(partitionIds[i].empty());
+            EXPECT_TRUE(partitionValues[i].empty());
+        }
+        return {std::move(ids), std::move(values)};
+    }
+
+    TEST(MWLuaLocalPartitionsTest, single_partition_should_give_output_in_order_of_keys)
+    {
+        const auto [ids, values] = runUpdate(1);
+        ASSERT_FALSE(ids.empty());
+        EXPECT_EQ(ids.front(), -1);
+        EXPECT_TRUE(std::is_sorted(ids.begin() + 1, ids.end()));
+        ASSERT_GE(values.size(), 2u);
+        EXPECT_EQ(values[0], -2);
+        EXPECT_EQ(values[1], -3);
+        EXPECT_TRUE(std::is_sorted(values.begin() + 2, values.end()));
+    }
+
+    TEST(MWLuaLocalPartitionsTest, multiple_partitions_should_give_same_output_as_single_partition)
+    {
+        const auto expected = runUpdate(1);
+        for (std::size_t partitionsCount : {2, 3, 4, 8})
+        {
+            for (int i = 0; i < 10; ++i)
+                EXPECT_EQ(runUpdate(partitionsCount), expected) << partitionsCount;
+        }
+    }
+
+    TEST(MWLuaLocalPartitionsTest, run_should_process_every_partition_once)
+    {
+        std::vector<std::atomic<int>> counters(4);
+        PartitionsRunner runner(counters.size(), [&] (std::size_t partition) { ++counters[partition]; });
+        runner.run();
+        runner.run();
+        for (const std::atomic<int>& counter : counters)
+            EXPECT_EQ(counter, 2);
+    }
+
+    TEST(MWLuaLocalPartitionsTest, run_should_rethrow_exception_from_worker)
+    {
+        bool shouldThrow = true;
+        PartitionsRunner runner(2, [&] (std::size_t partition)
+        {
+            if (partition == 1 && shouldThrow)
+                throw 42;
+        });
+        EXPECT_THROW(runner.run(), int);
+        shouldThrow = false;
+        EXPECT_NO_THROW(runner.run());
+    }
+
+    TEST(MWLuaLocalPartitionsTest, run_should_rethrow_exception_from_first_partition_after_workers_are_finished)
+    {
+        std::atomic<int> finished {0};
+        PartitionsRunner runner(3, [&] (std::size_t partition)
+        {
+            if (partition == 0)
+                throw std::runtime_error("error");
+            ++finished;
+        });
+        EXPECT_THROW(runner.run(), std::runtime_error);
+        EXPECT_EQ(finished, 2);
+    }
+
+    TEST(MWLuaLocalPartitionsTest, world_access_from_two_partitions_should_be_serialized)
+    {
+        // Imitates the cell cache of World that is modified by `find*Cell` and ray casts of local scripts.
+        std::map<int, int> cache;
+        int active = 0;
+        bool overlapped = false;
+        PartitionsRunner runner(2, [&] (std::size_t)
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                const auto lock = lockWorldAccess();
+                if (++active > 1)
+                    overlapped = true;
+                ++cache[i % 100];
+                --active;
+            }
+        });
+        runner.run();
+        EXPECT_FALSE(overlapped);
+        ASSERT_EQ(cache.size(), 100u);
+        for (const auto& [key, value] : cache)
+            EXPECT_EQ(value, 200) << key;
+    }
+}
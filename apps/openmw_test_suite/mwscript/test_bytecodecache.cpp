@@ -0,0 +1,110 @@
+#include "apps/openmw/mwscript/bytecodecache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWScript;
+
+    struct MWScriptBytecodeCacheTest : Test
+    {
+        std::filesystem::path mDirectory;
+        std::string mPath;
+        std::vector<std::string> mContentFiles;
+        const ScriptHash mExtensionsHash {1, 2};
+        const std::string mText = "Begin test\nshort value\nEnd";
+        const std::vector<Interpreter::Type_Code> mCode {1, 2, 3, 4, 5};
+        Compiler::Locals mLocals;
+
+        MWScriptBytecodeCacheTest()
+        {
+            std::string name = UnitTest::GetInstance()->current_test_info()->name();
+            std::replace(name.begin(), name.end(), '/', '_');
+            mDirectory = std::filesystem::temp_directory_path() / ("openmw_test_bytecodecache_" + name);
+            std::filesystem::create_directories(mDirectory);
+            mPath = (mDirectory / "bytecode.cache").string();
+            mContentFiles.push_back((mDirectory / "Morrowind.esm").string());
+            mContentFiles.push_back((mDirectory / "Tribunal.esm").string());
+            writeContentFile(mContentFiles[0], "GLOB gamehour f");
+            writeContentFile(mContentFiles[1], "GLOB counter s");
+            mLocals.declare('s', "value");
+            mLocals.declare('f', "speed");
+        }
+
+        ~MWScriptBytecodeCacheTest()
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(mDirectory, ec);
+        }
+
+        static void writeContentFile(const std::string& path, const std::string& data)
+        {
+            std::ofstream(path, std::ios::binary | std::ios::trunc) << data;
+        }
+
+        void saveScript()
+        {
+            BytecodeCache cache(mPath, mContentFiles, mExtensionsHash);
+            cache.insert("test", getScriptHash(mText), mCode, mLocals);
+            cache.save();
+        }
+    };
+
+    TEST_F(MWScriptBytecodeCacheTest, find_should_return_saved_script)
+    {
+        saveScript();
+        BytecodeCache cache(mPath, mContentFiles, mExtensionsHash);
+        cache.load();
+        const BytecodeCache::Entry* entry = cache.find("test", getScriptHash(mText));
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->mByteCode, mCode);
+        const Compiler::Locals& locals = mLocals;
+        EXPECT_EQ(entry->mLocals.get('s'), locals.get('s'));
+        EXPECT_EQ(entry->mLocals.get('l'), locals.get('l'));
+        EXPECT_EQ(entry->mLocals.get('f'), locals.get('f'));
+    }
+
+    TEST_F(MWScriptBytecodeCacheTest, find_should_ignore_changed_script_text)
+    {
+        saveScript();
+        BytecodeCache cache(mPath, mContentFiles, mExtensionsHash);
+        cache.load();
+        EXPECT_EQ(cache.find("test", getScriptHash(mText + "\n")), nullptr);
+    }
+
+    TEST_F(MWScriptBytecodeCacheTest, load_should_discard_cache_for_different_content_files)
+    {
+        saveScript();
+        BytecodeCache cache(mPath, {mContentFiles[0]}, mExtensionsHash);
+        cache.load();
+        EXPECT_EQ(cache.find("test", getScriptHash(mText)), nullptr);
+    }
+
+    TEST_F(MWScriptBytecodeCacheTest, load_should_discard_cache_for_different_extensions)
+    {
+        saveScript();
+        BytecodeCache cache(mPath, mContentFiles, ScriptHash {1, 3});
+        cache.load();
+        EXPECT_EQ(cache.find("test", getScriptHash(mText)), nullptr);
+    }
+
+    TEST_F(MWScriptBytecodeCacheTest, load_should_discard_cache_when_content_file_changes_global_type)
+    {
+        saveScript();
+        // The size is the same, so only the modification time tells that the file is changed
+        const auto time = std::filesystem::last_write_time(mContentFiles[1]);
+        writeContentFile(mContentFiles[1], "GLOB counter l");
+        std::filesystem::last_write_time(mContentFiles[1], time + std::chrono::hours(1));
+        BytecodeCache cache(mPath, mContentFiles, mExtensionsHash);
+        cache.load();
+        EXPECT_EQ(cache.find("test", getScriptHash(mText)), nullptr);
+    }
+}
@@ -49,6 +49,16 @@ namespace
             mInterpreter.run(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()), context);
         }
 
+        Interpreter::Program decode(const CompiledScript& script)
+        {
+            return mInterpreter.decode(&script.mByteCode[0], static_cast<int>(script.mByteCode.size()));
+        }
+
+        void run(const Interpreter::Program& program, const CompiledScript& script, TestInterpreterContext& context)
+        {
+            mInterpreter.run(program, &script.mByteCode[0], static_cast<int>(script.mByteCode.size()), context);
+        }
+
         template<typename T, typename ...TArgs>
         void installOpcode(int code, TArgs&& ...args)
         {
@@ -484,6 +494,54 @@ messagebox,"this is a %g",a
         }
     }
 
+    TEST_F(MWScriptTest, mwscript_test_decoded_program_should_be_reusable)
+    {
+        registerExtensions();
+        if(const auto script = compile(sScript2))
+        {
+            class AddTopic : public Interpreter::Opcode0
+            {
+                int& mCalls;
+            public:
+                AddTopic(int& calls) : mCalls(calls) {}
+
+                void execute(Interpreter::Runtime& runtime)
+                {
+                    EXPECT_EQ(runtime.getStringLiteral(runtime[0].mInteger), "OpenMW Unit Test");
+                    runtime.pop();
+                    ++mCalls;
+                }
+            };
+            int calls = 0;
+            installOpcode<AddTopic>(Compiler::Dialogue::opcodeAddTopic, calls);
+            const Interpreter::Program program = decode(*script);
+            TestInterpreterContext context;
+            run(program, *script, context);
+            run(program, *script, context);
+            EXPECT_EQ(calls, 2);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
+    TEST_F(MWScriptTest, mwscript_test_unknown_opcode_should_throw_on_execution)
+    {
+        registerExtensions();
+        if(const auto script = compile(sScript2))
+        {
+            Interpreter::Program program;
+            EXPECT_NO_THROW(program = decode(*script));
+            TestInterpreterContext context;
+            EXPECT_THROW(run(program, *script, context), std::runtime_error);
+        }
+        else
+        {
+            FAIL();
+        }
+    }
+
     TEST_F(MWScriptTest, mwscript_test_math)
     {
         if(const auto script = compile(sScript3))
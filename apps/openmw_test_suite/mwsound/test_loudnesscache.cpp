@@ -0,0 +1,42 @@
+#include "apps/openmw/mwsound/loudnesscache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWSound;
+
+    TEST(MWSoundLoudnessCacheTest, get_should_return_inserted_track)
+    {
+        LoudnessCache cache;
+        cache.insert("vo/a.mp3", {0.5f, 1.0f});
+        EXPECT_EQ(cache.get("vo/a.mp3"), (std::vector<float> {0.5f, 1.0f}));
+        EXPECT_EQ(cache.get("vo/b.mp3"), std::nullopt);
+    }
+
+    TEST(MWSoundLoudnessCacheTest, insert_should_drop_least_recently_used_tracks_above_limit)
+    {
+        LoudnessCache cache(4 * sizeof(float));
+        cache.insert("vo/a.mp3", {1, 2});
+        cache.insert("vo/b.mp3", {3, 4});
+        ASSERT_TRUE(cache.get("vo/a.mp3").has_value());
+        cache.insert("vo/c.mp3", {5, 6});
+        EXPECT_TRUE(cache.get("vo/a.mp3").has_value());
+        EXPECT_FALSE(cache.get("vo/b.mp3").has_value());
+        EXPECT_TRUE(cache.get("vo/c.mp3").has_value());
+        EXPECT_EQ(cache.getSize(), 4 * sizeof(float));
+    }
+
+    TEST(MWSoundLoudnessCacheTest, insert_should_ignore_track_bigger_than_limit)
+    {
+        LoudnessCache cache(2 * sizeof(float));
+        cache.insert("vo/a.mp3", {1});
+        cache.insert("vo/b.mp3", {1, 2, 3});
+        EXPECT_TRUE(cache.get("vo/a.mp3").has_value());
+        EXPECT_FALSE(cache.get("vo/b.mp3").has_value());
+        EXPECT_EQ(cache.getSize(), sizeof(float));
+    }
+}
@@ -0,0 +1,75 @@
+#include "apps/openmw/mwworld/preloadpredictor.hpp"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+    using namespace testing;
+    using namespace MWWorld;
+
+    struct MWWorldPreloadPredictorTest : Test
+    {
+        PreloadPredictor mPredictor {0.5f, 1000.f};
+    };
+
+    TEST_F(MWWorldPreloadPredictorTest, first_update_should_set_position_without_velocity)
+    {
+        mPredictor.update(osg::Vec3f(1, 2, 3), 0.1f);
+        EXPECT_EQ(mPredictor.getPosition(), osg::Vec3f(1, 2, 3));
+        EXPECT_EQ(mPredictor.getVelocity(), osg::Vec3f());
+        EXPECT_EQ(mPredictor.getPredictedPosition(1), osg::Vec3f(1, 2, 3));
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, velocity_should_converge_to_constant_movement)
+    {
+        osg::Vec3f position;
+        mPredictor.update(position, 0.1f);
+        for (int i = 0; i < 100; ++i)
+        {
+            position += osg::Vec3f(10, 0, 0);
+            mPredictor.update(position, 0.1f);
+        }
+        EXPECT_NEAR(mPredictor.getVelocity().x(), 100, 1e-3);
+        EXPECT_NEAR(mPredictor.getPredictedPosition(2).x(), position.x() + 200, 1e-2);
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, single_irregular_frame_should_change_velocity_partially)
+    {
+        mPredictor.update(osg::Vec3f(), 0.1f);
+        mPredictor.update(osg::Vec3f(0, 50, 0), 0.1f);
+        EXPECT_FLOAT_EQ(mPredictor.getVelocity().y(), 100);
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, teleport_should_reset_velocity)
+    {
+        mPredictor.update(osg::Vec3f(), 0.1f);
+        mPredictor.update(osg::Vec3f(10, 0, 0), 0.1f);
+        mPredictor.update(osg::Vec3f(5000, 0, 0), 0.1f);
+        EXPECT_EQ(mPredictor.getPosition(), osg::Vec3f(5000, 0, 0));
+        EXPECT_EQ(mPredictor.getVelocity(), osg::Vec3f());
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, zero_duration_should_be_ignored)
+    {
+        mPredictor.update(osg::Vec3f(), 0.1f);
+        mPredictor.update(osg::Vec3f(10, 0, 0), 0);
+        EXPECT_EQ(mPredictor.getPosition(), osg::Vec3f());
+        EXPECT_EQ(mPredictor.getVelocity(), osg::Vec3f());
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, nearest_path_point_should_be_on_segment_to_predicted_position)
+    {
+        mPredictor.reset(osg::Vec3f());
+        mPredictor.update(osg::Vec3f(100, 0, 0), 1);
+        ASSERT_FLOAT_EQ(mPredictor.getVelocity().x(), 100);
+        EXPECT_EQ(mPredictor.getNearestPathPoint(osg::Vec3f(150, 50, 0), 1), osg::Vec3f(150, 0, 0));
+        EXPECT_EQ(mPredictor.getNearestPathPoint(osg::Vec3f(0, 50, 0), 1), osg::Vec3f(100, 0, 0));
+        EXPECT_EQ(mPredictor.getNearestPathPoint(osg::Vec3f(500, 50, 0), 1), osg::Vec3f(200, 0, 0));
+    }
+
+    TEST_F(MWWorldPreloadPredictorTest, nearest_path_point_without_velocity_should_be_position)
+    {
+        mPredictor.reset(osg::Vec3f(1, 2, 3));
+        EXPECT_EQ(mPredictor.getNearestPathPoint(osg::Vec3f(100, 0, 0), 1), osg::Vec3f(1, 2, 3));
+    }
+}
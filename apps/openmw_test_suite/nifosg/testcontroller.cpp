@@ -0,0 +1,133 @@
+#include <components/nif/nifkey.hpp>
+#include <components/nifosg/controller.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace NifOsg;
+
+    std::shared_ptr<Nif::FloatKeyMap> makeKeys(const std::vector<std::pair<float, float>>& keys,
+        unsigned int interpolationType = Nif::InterpolationType_Linear)
+    {
+        auto result = std::make_shared<Nif::FloatKeyMap>();
+        result->mInterpolationType = interpolationType;
+        for (const auto& [time, value] : keys)
+        {
+            result->mTimes.push_back(time);
+            result->mValues.push_back(value);
+        }
+        result->sortKeys();
+        return result;
+    }
+
+    // Value of every key is the square of its time, so linear interpolation differs from the square.
+    FloatInterpolator makeSquaresInterpolator()
+    {
+        return FloatInterpolator(makeKeys({{0, 0}, {1, 1}, {2, 4}, {3, 9}, {4, 16}}), -1.f);
+    }
+
+    TEST(NifOsgFloatKeyMapTest, sort_keys_should_keep_sorted_keys)
+    {
+        const auto keys = makeKeys({{0, 10}, {1, 11}, {2, 12}});
+        EXPECT_EQ(keys->mTimes, (std::vector<float> {0, 1, 2}));
+        EXPECT_EQ(keys->mValues, (std::vector<float> {10, 11, 12}));
+    }
+
+    TEST(NifOsgFloatKeyMapTest, sort_keys_should_order_keys_by_time)
+    {
+        const auto keys = makeKeys({{2, 12}, {0, 10}, {3, 13}, {1, 11}});
+        EXPECT_EQ(keys->mTimes, (std::vector<float> {0, 1, 2, 3}));
+        EXPECT_EQ(keys->mValues, (std::vector<float> {10, 11, 12, 13}));
+    }
+
+    TEST(NifOsgFloatKeyMapTest, sort_keys_should_keep_last_key_for_duplicate_times)
+    {
+        const auto keys = makeKeys({{0, 10}, {1, 11}, {1, 21}, {2, 12}, {1, 31}, {2, 22}});
+        EXPECT_EQ(keys->mTimes, (std::vector<float> {0, 1, 2}));
+        EXPECT_EQ(keys->mValues, (std::vector<float> {10, 31, 22}));
+    }
+
+    TEST(NifOsgFloatKeyMapTest, sort_keys_should_keep_tangents_with_their_keys)
+    {
+        Nif::FloatKeyMap keys;
+        keys.mInterpolationType = Nif::InterpolationType_Quadratic;
+        keys.mTimes = {1, 0, 1};
+        keys.mValues = {11, 10, 21};
+        keys.mInTans = {1, 0, 2};
+        keys.mOutTans = {-1, 0, -2};
+        keys.sortKeys();
+        EXPECT_EQ(keys.mTimes, (std::vector<float> {0, 1}));
+        EXPECT_EQ(keys.mValues, (std::vector<float> {10, 21}));
+        EXPECT_EQ(keys.mInTans, (std::vector<float> {0, 2}));
+        EXPECT_EQ(keys.mOutTans, (std::vector<float> {0, -2}));
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_without_keys_should_return_default_value)
+    {
+        const FloatInterpolator interpolator(std::make_shared<Nif::FloatKeyMap>(), 42.f);
+        EXPECT_EQ(interpolator.interpKey(1), 42.f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_before_first_key_should_return_first_value)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        EXPECT_EQ(interpolator.interpKey(-1), 0.f);
+        EXPECT_EQ(interpolator.interpKey(0), 0.f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_after_last_key_should_return_last_value)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        EXPECT_EQ(interpolator.interpKey(4), 16.f);
+        EXPECT_EQ(interpolator.interpKey(5), 16.f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_should_interpolate_between_neighbour_keys_for_increasing_time)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 0.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.75f), 0.75f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1), 1.f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.5f), 2.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(2.5f), 6.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3.5f), 12.5f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_should_skip_several_keys)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 0.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3.5f), 12.5f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_should_support_time_going_backwards)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        EXPECT_FLOAT_EQ(interpolator.interpKey(3.5f), 12.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(2.5f), 6.5f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 0.5f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_should_restart_from_first_keys_after_loop_wrap)
+    {
+        const FloatInterpolator interpolator = makeSquaresInterpolator();
+        for (float time = 0; time < 4; time += 0.25f)
+            interpolator.interpKey(time);
+        EXPECT_EQ(interpolator.interpKey(4), 16.f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.25f), 0.25f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.25f), 1.75f);
+    }
+
+    TEST(NifOsgValueInterpolatorTest, interp_key_should_use_last_of_duplicate_keys)
+    {
+        const FloatInterpolator interpolator(makeKeys({{0, 0}, {1, 5}, {1, 10}, {2, 20}}));
+        EXPECT_FLOAT_EQ(interpolator.interpKey(0.5f), 5.f);
+        EXPECT_FLOAT_EQ(interpolator.interpKey(1.5f), 15.f);
+    }
+}
@@ -0,0 +1,73 @@
+#include <apps/openmw/benchmark.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace OMW;
+
+    Benchmark parse(const std::string& text)
+    {
+        std::istringstream stream(text);
+        return Benchmark::parse(stream);
+    }
+
+    TEST(OpenMWBenchmarkTest, parse_should_skip_comments_and_empty_lines)
+    {
+        const Benchmark benchmark = parse("# comment\n\n  0 coc \"Balmora\"\n");
+        ASSERT_EQ(benchmark.getCommands().size(), 1);
+        EXPECT_EQ(benchmark.getCommands()[0].mFrame, 0);
+        EXPECT_EQ(benchmark.getCommands()[0].mText, "coc \"Balmora\"");
+    }
+
+    TEST(OpenMWBenchmarkTest, commands_should_be_ordered_by_frame_keeping_order_within_frame)
+    {
+        const Benchmark benchmark = parse("10 b\n0 a\n10 c\n");
+        EXPECT_EQ(benchmark.getCommands(0), std::vector<std::string> {"a"});
+        EXPECT_EQ(benchmark.getCommands(10), (std::vector<std::string> {"b", "c"}));
+        EXPECT_TRUE(benchmark.getCommands(5).empty());
+    }
+
+    TEST(OpenMWBenchmarkTest, benchmark_should_finish_after_last_command_without_end)
+    {
+        const Benchmark benchmark = parse("0 a\n42 b\n");
+        EXPECT_EQ(benchmark.getEndFrame(), 43);
+        EXPECT_FALSE(benchmark.isFinished(42));
+        EXPECT_TRUE(benchmark.isFinished(43));
+    }
+
+    TEST(OpenMWBenchmarkTest, benchmark_should_finish_at_end_command)
+    {
+        const Benchmark benchmark = parse("0 a\n100 end\n200 b\n");
+        EXPECT_EQ(benchmark.getEndFrame(), 100);
+    }
+
+    TEST(OpenMWBenchmarkTest, parse_should_throw_on_invalid_frame)
+    {
+        EXPECT_THROW(parse("x coc Balmora\n"), std::runtime_error);
+        EXPECT_THROW(parse("-1 coc Balmora\n"), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkTest, parse_should_throw_on_missing_command)
+    {
+        EXPECT_THROW(parse("10\n"), std::runtime_error);
+    }
+
+    TEST(OpenMWBenchmarkTest, csv_should_contain_all_attributes_with_empty_missing_values)
+    {
+        Benchmark benchmark = parse("2 end\n");
+        benchmark.setFrameDuration(0, 0.5);
+        benchmark.setFrameDuration(1, 0.25);
+        benchmark.setFrameAttributes(0, {{"b", 1}});
+        benchmark.setFrameAttributes(1, {{"a", 2}, {"c,d", 3}});
+        std::ostringstream stream;
+        benchmark.writeCsv(stream);
+        EXPECT_EQ(stream.str(), "frame,duration,a,b,\"c,d\"\n0,0.5,,1,\n1,0.25,2,,3\n");
+    }
+}
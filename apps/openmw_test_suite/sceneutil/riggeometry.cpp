@@ -0,0 +1,113 @@
+#include <components/misc/taskscheduler.hpp>
+#include <components/sceneutil/riggeometry.hpp>
+#include <components/sceneutil/skeleton.hpp>
+
+#include <osg/MatrixTransform>
+#include <osg/TriangleFunctor>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct CollectVertices
+    {
+        std::vector<osg::Vec3f>* mVertices = nullptr;
+
+        void operator()(const osg::Vec3& v1, const osg::Vec3& v2, const osg::Vec3& v3, bool /*temp*/ = false)
+        {
+            mVertices->push_back(v1);
+            mVertices->push_back(v2);
+            mVertices->push_back(v3);
+        }
+    };
+
+    constexpr unsigned verticesCount = 12;
+
+    osg::ref_ptr<osg::Geometry> makeSourceGeometry()
+    {
+        osg::ref_ptr<osg::Vec3Array> vertices(new osg::Vec3Array);
+        osg::ref_ptr<osg::Vec3Array> normals(new osg::Vec3Array);
+        for (unsigned i = 0; i < verticesCount; ++i)
+        {
+            vertices->push_back(osg::Vec3f(i, (i * 2) % 5, i % 3));
+            normals->push_back(osg::Vec3f(0, 0, 1));
+        }
+        osg::ref_ptr<osg::Geometry> result(new osg::Geometry);
+        result->setVertexArray(vertices);
+        result->setNormalArray(normals, osg::Array::BIND_PER_VERTEX);
+        result->addPrimitiveSet(new osg::DrawArrays(GL_TRIANGLES, 0, verticesCount));
+        return result;
+    }
+
+    // Vertices are influenced by one bone, by both bones with different weights or by nothing.
+    osg::ref_ptr<RigGeometry::InfluenceMap> makeInfluenceMap()
+    {
+        RigGeometry::BoneInfluence root;
+        root.mInvBindMatrix = osg::Matrixf::translate(-1, 0, 0);
+        root.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(), 100);
+        RigGeometry::BoneInfluence child;
+        child.mInvBindMatrix = osg::Matrixf::rotate(0.3, osg::Vec3f(1, 0, 0));
+        child.mBoundSphere = osg::BoundingSpheref(osg::Vec3f(), 100);
+        for (unsigned short i = 0; i < verticesCount - 2; ++i)
+        {
+            if (i % 3 != 1)
+                root.mWeights.emplace_back(i, i % 3 == 0 ? 1.f : 0.25f);
+            if (i % 3 != 0)
+                child.mWeights.emplace_back(i, i % 3 == 1 ? 1.f : 0.75f);
+        }
+        osg::ref_ptr<RigGeometry::InfluenceMap> result(new RigGeometry::InfluenceMap);
+        result->mData.emplace_back("Root", root);
+        result->mData.emplace_back("Child", child);
+        return result;
+    }
+
+    std::vector<osg::Vec3f> skin(Misc::TaskScheduler* scheduler)
+    {
+        osg::ref_ptr<Skeleton> skeleton(new Skeleton);
+        osg::ref_ptr<osg::MatrixTransform> root(new osg::MatrixTransform(
+            osg::Matrix::rotate(0.5, osg::Vec3f(0, 0, 1)) * osg::Matrix::translate(1, 2, 3)));
+        root->setName("Root");
+        osg::ref_ptr<osg::MatrixTransform> child(new osg::MatrixTransform(
+            osg::Matrix::rotate(-1, osg::Vec3f(0, 1, 0)) * osg::Matrix::translate(0, 0, 4)));
+        child->setName("Child");
+        root->addChild(child);
+        skeleton->addChild(root);
+
+        RigGeometry::setTaskScheduler(scheduler);
+        osg::ref_ptr<RigGeometry> rig(new RigGeometry);
+        RigGeometry::setTaskScheduler(nullptr);
+        rig->setSourceGeometry(makeSourceGeometry());
+        rig->setInfluenceMap(makeInfluenceMap());
+        skeleton->addChild(rig);
+
+        osg::NodeVisitor cullVisitor(osg::NodeVisitor::CULL_VISITOR, osg::NodeVisitor::TRAVERSE_ALL_CHILDREN);
+        cullVisitor.setTraversalNumber(1);
+        cullVisitor.pushOntoNodePath(skeleton);
+        rig->accept(cullVisitor);
+
+        std::vector<osg::Vec3f> result;
+        osg::TriangleFunctor<CollectVertices> functor;
+        functor.mVertices = &result;
+        rig->accept(functor);
+        return result;
+    }
+
+    TEST(SceneUtilRigGeometryTest, skinning_on_task_scheduler_should_give_same_vertices_as_skinning_on_cull_thread)
+    {
+        const std::vector<osg::Vec3f> serial = skin(nullptr);
+        ASSERT_EQ(serial.size(), verticesCount);
+
+        const osg::ref_ptr<osg::Geometry> source = makeSourceGeometry();
+        const osg::Vec3Array& sourceVertices = static_cast<const osg::Vec3Array&>(*source->getVertexArray());
+        EXPECT_NE(serial, std::vector<osg::Vec3f>(sourceVertices.begin(), sourceVertices.end()));
+
+        Misc::TaskScheduler scheduler(2);
+        for (int i = 0; i < 10; ++i)
+            EXPECT_EQ(skin(&scheduler), serial);
+    }
+}
@@ -1,8 +1,11 @@
 #include "extensions.hpp"
 
 #include <cassert>
+#include <sstream>
 #include <stdexcept>
 
+#include <extern/smhasher/MurmurHash3.h>
+
 #include "generator.hpp"
 #include "literals.hpp"
 
@@ -207,4 +210,26 @@ namespace Compiler
         for (const auto & mKeyword : mKeywords)
             keywords.push_back (mKeyword.first);
     }
+
+    std::array<std::uint64_t, 2> Extensions::getHash() const
+    {
+        std::ostringstream stream;
+
+        for (const auto& [keyword, index] : mKeywords)
+            stream << keyword << ' ' << index << '\n';
+
+        for (const auto& [index, function] : mFunctions)
+            stream << index << ' ' << function.mReturn << ' ' << function.mArguments << ' ' << function.mCode
+                << ' ' << function.mCodeExplicit << ' ' << function.mSegment << '\n';
+
+        for (const auto& [index, instruction] : mInstructions)
+            stream << index << ' ' << instruction.mArguments << ' ' << instruction.mCode
+                << ' ' << instruction.mCodeExplicit << ' ' << instruction.mSegment << '\n';
+
+        const std::string data = stream.str();
+        const std::array<std::uint64_t, 2> seed {0, 0};
+        std::array<std::uint64_t, 2> hash {0, 0};
+        MurmurHash3_x64_128(data.data(), static_cast<int>(data.size()), seed.data(), hash.data());
+        return hash;
+    }
 }
@@ -1,6 +1,8 @@
 #ifndef COMPILER_EXTENSIONS_H_INCLUDED
 #define COMPILER_EXTENSIONS_H_INCLUDED
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <map>
 #include <vector>
@@ -109,6 +111,10 @@ namespace Compiler
 
             void listKeywords (std::vector<std::string>& keywords) const;
             ///< Append all known keywords to \a kaywords.
+
+            std::array<std::uint64_t, 2> getHash() const;
+            ///< Return a hash of all registered keywords, signatures and opcodes. Code compiled with
+            /// extensions of a different hash must not be reused.
     };
 }
 
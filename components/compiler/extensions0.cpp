@@ -339,6 +339,9 @@ namespace Compiler
             extensions.registerInstruction ("togglerecastmesh", "", opcodeToggleRecastMesh);
             extensions.registerInstruction ("help", "", opcodeHelp);
             extensions.registerInstruction ("reloadlua", "", opcodeReloadLua);
+            extensions.registerInstruction ("dumpluaprofile", "", opcodeDumpLuaProfile);
+            extensions.registerInstruction ("savetrace", "", opcodeSaveTrace);
+            extensions.registerInstruction ("dumpscriptprofile", "", opcodeDumpScriptProfile);
         }
     }
 
@@ -320,6 +320,9 @@ namespace Compiler
         const int opcodeStartScriptExplicit = 0x200031d;
         const int opcodeHelp = 0x2000320;
         const int opcodeReloadLua = 0x2000321;
+        const int opcodeDumpLuaProfile = 0x2000322;
+        const int opcodeSaveTrace = 0x2000323;
+        const int opcodeDumpScriptProfile = 0x2000324;
     }
 
     namespace Sky
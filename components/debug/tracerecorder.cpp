@@ -0,0 +1,217 @@
+#include "tracerecorder.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace Debug
+{
+    namespace
+    {
+        thread_local std::string currentThreadName;
+
+        void writeJsonString(std::ostream& stream, std::string_view value)
+        {
+            stream << '"';
+            for (const char c : value)
+            {
+                switch (c)
+                {
+                    case '"': stream << "\\\""; break;
+                    case '\\': stream << "\\\\"; break;
+                    case '\n': stream << "\\n"; break;
+                    case '\t': stream << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                                   << static_cast<int>(c) << std::dec << std::setfill(' ');
+                        else
+                            stream << c;
+                }
+            }
+            stream << '"';
+        }
+    }
+
+    thread_local TraceRecorder::ThreadBufferOwner TraceRecorder::sThreadBuffer;
+
+    TraceRecorder::ThreadBufferOwner::~ThreadBufferOwner()
+    {
+        if (mBuffer == nullptr)
+            return;
+        // Thread local objects are destroyed before the static recorder
+        const std::lock_guard<std::mutex> lock(instance().mMutex);
+        mBuffer->mFinished = true;
+    }
+
+    void TraceRecorder::ThreadBuffer::push(const Event& event)
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mEvents[mHead % mEvents.size()] = event;
+        ++mHead;
+    }
+
+    TraceRecorder& TraceRecorder::instance()
+    {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    void TraceRecorder::start(std::size_t eventsPerThread, const std::filesystem::path& outputDirectory)
+    {
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mEventsPerThread = std::max<std::size_t>(eventsPerThread, 1);
+            mOutputDirectory = outputDirectory;
+        }
+        mEnabled = true;
+    }
+
+    void TraceRecorder::stop()
+    {
+        mEnabled = false;
+    }
+
+    void TraceRecorder::setThreadName(std::string_view name)
+    {
+        currentThreadName = name;
+        if (sThreadBuffer.mBuffer == nullptr)
+            return;
+        const std::lock_guard<std::mutex> lock(mMutex);
+        sThreadBuffer.mBuffer->mName = currentThreadName;
+    }
+
+    TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+    {
+        if (sThreadBuffer.mBuffer == nullptr)
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            const auto finished = std::find_if(mBuffers.begin(), mBuffers.end(),
+                [] (const std::shared_ptr<ThreadBuffer>& v) { return v->mFinished; });
+            std::shared_ptr<ThreadBuffer> buffer;
+            if (finished != mBuffers.end())
+            {
+                // Events of the exited thread are dropped, so the number of buffers is limited by the number of
+                // threads running at the same time.
+                buffer = *finished;
+                const std::lock_guard<std::mutex> bufferLock(buffer->mMutex);
+                buffer->mEvents.assign(mEventsPerThread, Event {});
+                buffer->mHead = 0;
+                buffer->mFinished = false;
+            }
+            else
+            {
+                buffer = std::make_shared<ThreadBuffer>(mBuffers.size(), mEventsPerThread, std::string());
+                mBuffers.push_back(buffer);
+            }
+            buffer->mName = currentThreadName.empty() ? "Thread " + std::to_string(buffer->mId) : currentThreadName;
+            sThreadBuffer.mBuffer = std::move(buffer);
+        }
+        return sThreadBuffer.mBuffer.get();
+    }
+
+    void TraceRecorder::recordZone(const char* category, const char* name, Clock::time_point start,
+        Clock::time_point end)
+    {
+        if (!isEnabled())
+            return;
+        getThreadBuffer()->push(Event {category, name, start, end - start, 0, EventType::Zone});
+    }
+
+    void TraceRecorder::recordCounter(const char* category, const char* name, double value)
+    {
+        if (!isEnabled())
+            return;
+        getThreadBuffer()->push(Event {category, name, Clock::now(), Clock::duration::zero(), value,
+            EventType::Counter});
+    }
+
+    void TraceRecorder::writeChromeTrace(std::ostream& stream) const
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        std::vector<std::string> names;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            buffers = mBuffers;
+            for (const auto& buffer : buffers)
+                names.push_back(buffer->mName);
+        }
+
+        const auto toMicroseconds = [] (Clock::duration value)
+        {
+            return std::chrono::duration<double, std::micro>(value).count();
+        };
+
+        stream << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        const auto beginEvent = [&]
+        {
+            if (!first)
+                stream << ',';
+            first = false;
+            stream << "\n{";
+        };
+
+        std::vector<Event> events;
+        for (std::size_t i = 0; i < buffers.size(); ++i)
+        {
+            ThreadBuffer& buffer = *buffers[i];
+            beginEvent();
+            stream << "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.mId << ",\"args\":{\"name\":";
+            writeJsonString(stream, names[i]);
+            stream << "}}";
+
+            events.clear();
+            {
+                // Copied under the lock, so the owner thread is not blocked while the events are formatted
+                const std::lock_guard<std::mutex> lock(buffer.mMutex);
+                const std::uint64_t capacity = buffer.mEvents.size();
+                const std::uint64_t begin = buffer.mHead > capacity ? buffer.mHead - capacity : 0;
+                for (std::uint64_t j = begin; j < buffer.mHead; ++j)
+                    events.push_back(buffer.mEvents[j % capacity]);
+            }
+
+            for (auto it = events.begin(); it != events.end(); ++it)
+            {
+                beginEvent();
+                stream << "\"name\":";
+                writeJsonString(stream, it->mName);
+                stream << ",\"cat\":";
+                writeJsonString(stream, it->mCategory);
+                stream << ",\"pid\":1,\"tid\":" << buffer.mId << ",\"ts\":" << toMicroseconds(it->mStart - mEpoch);
+                switch (it->mType)
+                {
+                    case EventType::Zone:
+                        stream << ",\"ph\":\"X\",\"dur\":" << toMicroseconds(it->mDuration) << '}';
+                        break;
+                    case EventType::Counter:
+                        stream << ",\"ph\":\"C\",\"args\":{\"value\":" << it->mValue << "}}";
+                        break;
+                }
+            }
+        }
+        stream << "\n]}\n";
+    }
+
+    std::filesystem::path TraceRecorder::save() const
+    {
+        std::filesystem::path directory;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            directory = mOutputDirectory;
+        }
+        const std::time_t time = std::time(nullptr);
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%d_%H-%M-%S", std::localtime(&time));
+        const std::filesystem::path path = directory / ("trace_" + std::string(timestamp) + ".json");
+        std::ofstream file(path);
+        if (!file.is_open())
+            throw std::runtime_error("Failed to open file for trace: " + path.string());
+        writeChromeTrace(file);
+        if (!file)
+            throw std::runtime_error("Failed to write trace to file: " + path.string());
+        return path;
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef OPENMW_COMPONENTS_DEBUG_TRACERECORDER_H
+#define OPENMW_COMPONENTS_DEBUG_TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Debug
+{
+    /// @brief Records timed zones and counters from any thread.
+    /// Every thread writes to its own ring buffer and keeps only the last events. The buffer lock is contended only
+    /// while the trace is written. A buffer of an exited thread keeps its events until it is reused by a new thread.
+    /// When recording is not started a zone costs a single relaxed atomic load.
+    /// Names and categories are not copied, they must outlive the recorder (e.g. be string literals).
+    class TraceRecorder
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static TraceRecorder& instance();
+
+        /// @param eventsPerThread capacity of ring buffers for threads which didn't record anything yet.
+        void start(std::size_t eventsPerThread, const std::filesystem::path& outputDirectory);
+
+        void stop();
+
+        bool isEnabled() const { return mEnabled.load(std::memory_order_relaxed); }
+
+        /// Sets the name of the calling thread shown in the trace.
+        void setThreadName(std::string_view name);
+
+        void recordZone(const char* category, const char* name, Clock::time_point start, Clock::time_point end);
+
+        void recordCounter(const char* category, const char* name, double value);
+
+        /// Writes recorded events in Chrome trace event format, it can be opened by chrome://tracing and Perfetto UI.
+        /// Recording may continue, events overwritten while writing are skipped.
+        void writeChromeTrace(std::ostream& stream) const;
+
+        /// Writes the trace to a new file in the output directory. Returns path to the file.
+        /// Throws std::runtime_error on failure.
+        std::filesystem::path save() const;
+
+    private:
+        enum class EventType : std::uint8_t
+        {
+            Zone,
+            Counter,
+        };
+
+        struct Event
+        {
+            const char* mCategory;
+            const char* mName;
+            Clock::time_point mStart;
+            Clock::duration mDuration;
+            double mValue;
+            EventType mType;
+        };
+
+        struct ThreadBuffer
+        {
+            const std::size_t mId;
+            std::mutex mMutex;
+            std::vector<Event> mEvents;  // guarded by mMutex
+            std::uint64_t mHead = 0;  // number of pushed events, guarded by mMutex
+            std::string mName;  // guarded by TraceRecorder::mMutex
+            bool mFinished = false;  // the owner thread has exited, guarded by TraceRecorder::mMutex
+
+            ThreadBuffer(std::size_t id, std::size_t capacity, std::string name)
+                : mId(id), mEvents(capacity), mName(std::move(name)) {}
+
+            void push(const Event& event);
+        };
+
+        TraceRecorder() = default;
+
+        // Marks the buffer as finished when the owner thread exits, so it can be reused by another thread.
+        struct ThreadBufferOwner
+        {
+            std::shared_ptr<ThreadBuffer> mBuffer;
+
+            ~ThreadBufferOwner();
+        };
+
+        ThreadBuffer* getThreadBuffer();
+
+        static thread_local ThreadBufferOwner sThreadBuffer;
+
+        std::atomic<bool> mEnabled {false};
+        const Clock::time_point mEpoch = Clock::now();
+        mutable std::mutex mMutex;
+        std::size_t mEventsPerThread = 0;
+        std::filesystem::path mOutputDirectory;
+        std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+    };
+
+    /// Records the time from construction to destruction as a zone of the calling thread.
+    class TraceZone
+    {
+    public:
+        TraceZone(const char* category, const char* name)
+            : mCategory(category)
+            , mName(name)
+            , mEnabled(TraceRecorder::instance().isEnabled())
+        {
+            if (mEnabled)
+                mStart = TraceRecorder::Clock::now();
+        }
+
+        TraceZone(const TraceZone&) = delete;
+        TraceZone& operator=(const TraceZone&) = delete;
+
+        ~TraceZone()
+        {
+            if (mEnabled)
+                TraceRecorder::instance().recordZone(mCategory, mName, mStart, TraceRecorder::Clock::now());
+        }
+
+    private:
+        const char* const mCategory;
+        const char* const mName;
+        const bool mEnabled;
+        TraceRecorder::Clock::time_point mStart;
+    };
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "dbrefgeometryobject.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracerecorder.hpp>
 #include <components/misc/thread.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 
@@ -131,7 +132,7 @@ namespace DetourNavigator
         , mRecastMeshManager(recastMeshManager)
         , mOffMeshConnectionsManager(offMeshConnectionsManager)
         , mShouldStop()
-        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize)
+        , mNavMeshTilesCache(settings.mMaxNavMeshTilesCacheSize, settings.mCompressNavMeshTilesCache)
         , mDbWorker(makeDbWorker(*this, std::move(db), mSettings))
     {
         for (std::size_t i = 0; i < mSettings.get().mAsyncNavMeshUpdaterThreads; ++i)
@@ -323,6 +324,7 @@ namespace DetourNavigator
     {
         Log(Debug::Debug) << "Start process navigator jobs by thread=" << std::this_thread::get_id();
         Misc::setCurrentThreadIdlePriority();
+        Debug::TraceRecorder::instance().setThreadName("Navigator");
         while (!mShouldStop)
         {
             try
@@ -363,6 +365,7 @@ namespace DetourNavigator
 
     JobStatus AsyncNavMeshUpdater::processJob(Job& job)
     {
+        const Debug::TraceZone zone("Navigator", "Job");
         Log(Debug::Debug) << "Processing job " << job.mId << " by thread=" << std::this_thread::get_id();
 
         const auto navMeshCacheItem = job.mNavMeshCacheItem.lock();
@@ -416,11 +419,12 @@ namespace DetourNavigator
         const PreparedNavMeshData* preparedNavMeshDataPtr = nullptr;
 
         if (cachedNavMeshData)
+            preparedNavMeshDataPtr = cachedNavMeshData.get(preparedNavMeshData);
+
+        if (preparedNavMeshDataPtr == nullptr)
         {
-            preparedNavMeshDataPtr = &cachedNavMeshData.get();
-        }
-        else
-        {
+            cachedNavMeshData = NavMeshTilesCache::Value();
+
             if (job.mChangeType != ChangeType::update && mDbWorker != nullptr)
             {
                 job.mRecastMesh = std::move(recastMesh);
@@ -444,7 +448,8 @@ namespace DetourNavigator
             {
                 cachedNavMeshData = mNavMeshTilesCache.set(job.mAgentHalfExtents, job.mChangedTile,
                                                            *recastMesh, std::move(preparedNavMeshData));
-                preparedNavMeshDataPtr = cachedNavMeshData ? &cachedNavMeshData.get() : preparedNavMeshData.get();
+                preparedNavMeshDataPtr = preparedNavMeshData != nullptr
+                    ? preparedNavMeshData.get() : cachedNavMeshData.get(preparedNavMeshData);
             }
         }
 
@@ -490,7 +495,8 @@ namespace DetourNavigator
 
         const auto offMeshConnections = mOffMeshConnectionsManager.get().get(job.mChangedTile);
 
-        const PreparedNavMeshData* preparedNavMeshDataPtr = cachedNavMeshData ? &cachedNavMeshData.get() : preparedNavMeshData.get();
+        const PreparedNavMeshData* preparedNavMeshDataPtr = preparedNavMeshData != nullptr
+            ? preparedNavMeshData.get() : cachedNavMeshData.get(preparedNavMeshData);
         const UpdateNavMeshStatus status = navMeshCacheItem.lock()->updateTile(job.mChangedTile, std::move(cachedNavMeshData),
             makeNavMeshTileData(*preparedNavMeshDataPtr, offMeshConnections, job.mAgentHalfExtents, job.mChangedTile, mSettings.get().mRecast));
 
@@ -745,6 +751,7 @@ namespace DetourNavigator
 
     void DbWorker::run() noexcept
     {
+        Debug::TraceRecorder::instance().setThreadName("NavMeshDb");
         constexpr std::size_t writesPerTransaction = 100;
         auto transaction = mDb->startTransaction();
         while (!mShouldStop)
@@ -770,6 +777,7 @@ namespace DetourNavigator
 
     void DbWorker::processJob(JobIt job)
     {
+        const Debug::TraceZone zone("Navigator", "DbJob");
         const auto process = [&] (auto f)
         {
             try
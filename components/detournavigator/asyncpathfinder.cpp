@@ -0,0 +1,119 @@
+#include "asyncpathfinder.hpp"
+#include "findsmoothpath.hpp"
+#include "settingsutils.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <osg/Stats>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        template <class T>
+        bool isLessPrioritized(const T& lhs, const T& rhs)
+        {
+            return std::tie(lhs.mPriority, lhs.mId) > std::tie(rhs.mPriority, rhs.mId);
+        }
+    }
+
+    PathQueryResult findPath(const Settings& settings, const GuardedNavMeshCacheItem& navMeshCacheItem,
+        const PathQuery& query)
+    {
+        PathQueryResult result;
+        auto out = std::back_inserter(result.mPath);
+        result.mStatus = findSmoothPath(navMeshCacheItem.lockConst()->getImpl(),
+            toNavMeshCoordinates(settings.mRecast, query.mAgentHalfExtents),
+            toNavMeshCoordinates(settings.mRecast, query.mStepSize),
+            toNavMeshCoordinates(settings.mRecast, query.mStart),
+            toNavMeshCoordinates(settings.mRecast, query.mEnd),
+            query.mIncludeFlags, query.mAreaCosts, settings, query.mEndTolerance, query.mAllowCoarsePath, out);
+        return result;
+    }
+
+    AsyncPathFinder::AsyncPathFinder(const Settings& settings, std::size_t threadsCount)
+        : mSettings(settings)
+    {
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mThreads.emplace_back([&] { process(); });
+    }
+
+    AsyncPathFinder::~AsyncPathFinder()
+    {
+        mShouldStop = true;
+        std::unique_lock<std::mutex> lock(mMutex);
+        mJobs.clear();
+        mHasJob.notify_all();
+        lock.unlock();
+        for (auto& thread : mThreads)
+            thread.join();
+    }
+
+    std::future<PathQueryResult> AsyncPathFinder::post(const SharedNavMeshCacheItem& navMeshCacheItem,
+        const PathQuery& query, float priority)
+    {
+        if (mThreads.empty())
+        {
+            std::promise<PathQueryResult> result;
+            result.set_value(findPath(mSettings, *navMeshCacheItem, query));
+            return result.get_future();
+        }
+
+        const std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.push_back(Job {priority, mNextJobId++, navMeshCacheItem, query, std::promise<PathQueryResult>()});
+        std::future<PathQueryResult> result = mJobs.back().mResult.get_future();
+        std::push_heap(mJobs.begin(), mJobs.end(), isLessPrioritized<Job>);
+        mHasJob.notify_one();
+        return result;
+    }
+
+    void AsyncPathFinder::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        std::size_t queued = 0;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            queued = mJobs.size();
+        }
+        stats.setAttribute(frameNumber, "NavMesh PathQueries", static_cast<double>(queued));
+        stats.setAttribute(frameNumber, "NavMesh PathProcessing", static_cast<double>(mProcessing.load()));
+    }
+
+    void AsyncPathFinder::process() noexcept
+    {
+        Log(Debug::Debug) << "Start process path queries by thread=" << std::this_thread::get_id();
+        while (!mShouldStop)
+        {
+            std::optional<Job> job = getNextJob();
+            if (!job.has_value())
+                continue;
+            ++mProcessing;
+            try
+            {
+                job->mResult.set_value(findPath(mSettings, *job->mNavMeshCacheItem, job->mQuery));
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "AsyncPathFinder::process exception: " << e.what();
+                job->mResult.set_exception(std::current_exception());
+            }
+            --mProcessing;
+        }
+        Log(Debug::Debug) << "Stop path queries processing by thread=" << std::this_thread::get_id();
+    }
+
+    std::optional<AsyncPathFinder::Job> AsyncPathFinder::getNextJob()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mHasJob.wait(lock, [&] { return mShouldStop || !mJobs.empty(); });
+        if (mShouldStop)
+            return std::nullopt;
+        std::pop_heap(mJobs.begin(), mJobs.end(), isLessPrioritized<Job>);
+        std::optional<Job> result(std::move(mJobs.back()));
+        mJobs.pop_back();
+        return result;
+    }
+}
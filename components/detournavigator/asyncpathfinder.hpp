@@ -0,0 +1,94 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_ASYNCPATHFINDER_H
+
+#include "areatype.hpp"
+#include "flags.hpp"
+#include "navmeshcacheitem.hpp"
+#include "settings.hpp"
+#include "status.hpp"
+
+#include <osg/Vec3f>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace osg
+{
+    class Stats;
+}
+
+namespace DetourNavigator
+{
+    struct PathQuery
+    {
+        osg::Vec3f mAgentHalfExtents;
+        float mStepSize = 0;
+        osg::Vec3f mStart;
+        osg::Vec3f mEnd;
+        Flags mIncludeFlags = Flag_none;
+        AreaCosts mAreaCosts;
+        float mEndTolerance = 0;
+        bool mAllowCoarsePath = false;
+    };
+
+    struct PathQueryResult
+    {
+        Status mStatus = Status::NavMeshNotFound;
+        std::vector<osg::Vec3f> mPath;
+    };
+
+    /**
+     * @brief findPath does the same as DetourNavigator::findPath but for already resolved navmesh.
+     * Safe to call from any thread.
+     */
+    PathQueryResult findPath(const Settings& settings, const GuardedNavMeshCacheItem& navMeshCacheItem,
+        const PathQuery& query);
+
+    /**
+     * @brief AsyncPathFinder processes path queries by worker threads. Each thread reuses own navmesh query.
+     * Queries with lower priority value are processed first.
+     */
+    class AsyncPathFinder
+    {
+    public:
+        AsyncPathFinder(const Settings& settings, std::size_t threadsCount);
+
+        ~AsyncPathFinder();
+
+        std::future<PathQueryResult> post(const SharedNavMeshCacheItem& navMeshCacheItem, const PathQuery& query,
+            float priority);
+
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
+    private:
+        struct Job
+        {
+            float mPriority;
+            std::size_t mId;
+            SharedNavMeshCacheItem mNavMeshCacheItem;
+            PathQuery mQuery;
+            std::promise<PathQueryResult> mResult;
+        };
+
+        const Settings& mSettings;
+        mutable std::mutex mMutex;
+        std::condition_variable mHasJob;
+        std::vector<Job> mJobs;
+        std::size_t mNextJobId = 0;
+        std::atomic_bool mShouldStop {false};
+        std::atomic_size_t mProcessing {0};
+        std::vector<std::thread> mThreads;
+
+        void process() noexcept;
+
+        std::optional<Job> getNextJob();
+    };
+}
+
+#endif
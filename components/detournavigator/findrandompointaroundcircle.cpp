@@ -12,7 +12,7 @@ namespace DetourNavigator
     std::optional<osg::Vec3f> findRandomPointAroundCircle(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents,
         const osg::Vec3f& start, const float maxRadius, const Flags includeFlags, const DetourSettings& settings)
     {
-        dtNavMeshQuery navMeshQuery;
+        dtNavMeshQuery& navMeshQuery = getThreadNavMeshQuery();
         if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mMaxNavMeshQueryNodes))
             return std::optional<osg::Vec3f>();
 
@@ -7,6 +7,12 @@
 
 namespace DetourNavigator
 {
+    dtNavMeshQuery& getThreadNavMeshQuery()
+    {
+        thread_local dtNavMeshQuery navMeshQuery;
+        return navMeshQuery;
+    }
+
     std::size_t fixupCorridor(std::vector<dtPolyRef>& path, std::size_t pathSize, const std::vector<dtPolyRef>& visited)
     {
         std::vector<dtPolyRef>::const_reverse_iterator furthestVisited;
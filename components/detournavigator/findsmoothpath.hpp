@@ -9,6 +9,7 @@
 #include "debug.hpp"
 #include "status.hpp"
 #include "areatype.hpp"
+#include "findtilepath.hpp"
 
 #include <DetourCommon.h>
 #include <DetourNavMesh.h>
@@ -31,6 +32,10 @@ namespace DetourNavigator
         return (osg::Vec2f(v1.x(), v1.z()) - osg::Vec2f(v2.x(), v2.z())).length() < r;
     }
 
+    /// Returns navmesh query owned by the calling thread. Detour keeps node pool and open list of already initialized
+    /// query when it is initialized again with not greater number of nodes so it's not allocated for each path.
+    dtNavMeshQuery& getThreadNavMeshQuery();
+
     std::size_t fixupCorridor(std::vector<dtPolyRef>& path, std::size_t pathSize, const std::vector<dtPolyRef>& visited);
 
     // This function checks if the path has a small U-turn, that is,
@@ -255,12 +260,15 @@ namespace DetourNavigator
         return Status::Success;
     }
 
+    /// @param allowCoarsePath allows to end the path at the exit of the last tile within path refinement tiles
+    /// distance on a route over tiles when end is further. Status is Success in that case, so it's only for paths
+    /// that are requested again when actor approaches their end.
     template <class OutputIterator>
     Status findSmoothPath(const dtNavMesh& navMesh, const osg::Vec3f& halfExtents, const float stepSize,
             const osg::Vec3f& start, const osg::Vec3f& end, const Flags includeFlags, const AreaCosts& areaCosts,
-            const Settings& settings, float endTolerance, OutputIterator& out)
+            const Settings& settings, float endTolerance, bool allowCoarsePath, OutputIterator& out)
     {
-        dtNavMeshQuery navMeshQuery;
+        dtNavMeshQuery& navMeshQuery = getThreadNavMeshQuery();
         if (!initNavMeshQuery(navMeshQuery, navMesh, settings.mDetour.mMaxNavMeshQueryNodes))
             return Status::InitNavMeshQueryFailed;
 
@@ -283,9 +291,18 @@ namespace DetourNavigator
         if (endRef == 0)
             return Status::EndPolygonNotFound;
 
+        // Far end is reached by detailed path to the point on a route over tiles
+        PathTarget target {endRef, end};
+        if (allowCoarsePath && settings.mDetour.mPathRefinementTiles > 0)
+        {
+            if (const auto coarseTarget = findCoarsePathTarget(navMesh, navMeshQuery, queryFilter, startRef, endRef,
+                    settings.mDetour.mPathRefinementTiles, static_cast<std::size_t>(settings.mMaxTilesNumber)))
+                target = *coarseTarget;
+        }
+
         std::vector<dtPolyRef> polygonPath(settings.mDetour.mMaxPolygonPathSize);
-        const auto polygonPathSize = findPath(navMeshQuery, startRef, endRef, start, end, queryFilter,
-                                              polygonPath.data(), polygonPath.size());
+        const auto polygonPathSize = findPath(navMeshQuery, startRef, target.mRef, start, target.mPosition,
+                                              queryFilter, polygonPath.data(), polygonPath.size());
 
         if (!polygonPathSize.has_value())
             return Status::FindPathOverPolygonsFailed;
@@ -293,10 +310,10 @@ namespace DetourNavigator
         if (*polygonPathSize == 0)
             return Status::Success;
 
-        const bool partialPath = polygonPath[*polygonPathSize - 1] != endRef;
+        const bool partialPath = polygonPath[*polygonPathSize - 1] != target.mRef;
         auto outTransform = OutputTransformIterator<OutputIterator>(out, settings.mRecast);
-        const Status smoothStatus = makeSmoothPath(navMesh, navMeshQuery, queryFilter, start, end, stepSize,
-            polygonPath, *polygonPathSize, settings.mDetour.mMaxSmoothPathSize, outTransform);
+        const Status smoothStatus = makeSmoothPath(navMesh, navMeshQuery, queryFilter, start, target.mPosition,
+            stepSize, polygonPath, *polygonPathSize, settings.mDetour.mMaxSmoothPathSize, outTransform);
 
         if (smoothStatus != Status::Success)
             return smoothStatus;
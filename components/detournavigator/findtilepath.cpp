@@ -0,0 +1,204 @@
+#include "findtilepath.hpp"
+
+#include <DetourNavMeshQuery.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <utility>
+
+namespace DetourNavigator
+{
+    namespace
+    {
+        float getDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return osg::Vec2f(static_cast<float>(lhs.x() - rhs.x()), static_cast<float>(lhs.y() - rhs.y())).length();
+        }
+
+        int getChebyshevDistance(const TilePosition& lhs, const TilePosition& rhs)
+        {
+            return std::max(std::abs(lhs.x() - rhs.x()), std::abs(lhs.y() - rhs.y()));
+        }
+
+        const dtMeshTile* getTile(const dtNavMesh& navMesh, dtPolyRef ref)
+        {
+            const dtMeshTile* tile = nullptr;
+            const dtPoly* poly = nullptr;
+            if (dtStatusFailed(navMesh.getTileAndPolyByRef(ref, &tile, &poly)))
+                return nullptr;
+            return tile;
+        }
+
+        TilePosition getTilePosition(const dtMeshTile& tile)
+        {
+            return TilePosition(tile.header->x, tile.header->y);
+        }
+
+        bool isLinkedTo(const dtNavMesh& navMesh, const dtMeshTile& tile, const dtPoly& poly,
+            const TilePosition& position)
+        {
+            for (unsigned int i = poly.firstLink; i != DT_NULL_LINK; i = tile.links[i].next)
+            {
+                const dtLink& link = tile.links[i];
+                if (link.side == 0xff)
+                    continue;
+                const dtMeshTile* const neighbour = getTile(navMesh, link.ref);
+                if (neighbour != nullptr && getTilePosition(*neighbour) == position)
+                    return true;
+            }
+            return false;
+        }
+
+        /// Polygon of the tile leading to the next tile closest to the tile center
+        std::optional<PathTarget> findTileExit(const dtNavMesh& navMesh, const dtNavMeshQuery& navMeshQuery,
+            const dtQueryFilter& filter, const dtMeshTile& tile, const TilePosition& next)
+        {
+            const osg::Vec3f min(tile.header->bmin[0], tile.header->bmin[1], tile.header->bmin[2]);
+            const osg::Vec3f max(tile.header->bmax[0], tile.header->bmax[1], tile.header->bmax[2]);
+            const osg::Vec3f center = (min + max) * 0.5f;
+            const dtPolyRef base = navMesh.getPolyRefBase(&tile);
+            std::optional<PathTarget> result;
+            float minDistance = std::numeric_limits<float>::max();
+            for (int i = 0; i < tile.header->polyCount; ++i)
+            {
+                const dtPoly& poly = tile.polys[i];
+                const dtPolyRef ref = base | static_cast<dtPolyRef>(i);
+                if (!filter.passFilter(ref, &tile, &poly) || !isLinkedTo(navMesh, tile, poly, next))
+                    continue;
+                osg::Vec3f position;
+                if (dtStatusFailed(navMeshQuery.closestPointOnPoly(ref, center.ptr(), position.ptr(), nullptr)))
+                    continue;
+                const float distance = (position - center).length2();
+                if (distance < minDistance)
+                {
+                    minDistance = distance;
+                    result = PathTarget {ref, position};
+                }
+            }
+            return result;
+        }
+    }
+
+    std::vector<TilePosition> getConnectedTiles(const dtNavMesh& navMesh, const dtQueryFilter& filter,
+        const dtMeshTile& tile)
+    {
+        std::vector<TilePosition> result;
+        const dtPolyRef base = navMesh.getPolyRefBase(&tile);
+        for (int i = 0; i < tile.header->polyCount; ++i)
+        {
+            const dtPoly& poly = tile.polys[i];
+            if (!filter.passFilter(base | static_cast<dtPolyRef>(i), &tile, &poly))
+                continue;
+            for (unsigned int k = poly.firstLink; k != DT_NULL_LINK; k = tile.links[k].next)
+            {
+                const dtLink& link = tile.links[k];
+                if (link.side == 0xff)
+                    continue;
+                const dtMeshTile* neighbour = nullptr;
+                const dtPoly* neighbourPoly = nullptr;
+                if (dtStatusFailed(navMesh.getTileAndPolyByRef(link.ref, &neighbour, &neighbourPoly))
+                        || !filter.passFilter(link.ref, neighbour, neighbourPoly))
+                    continue;
+                const TilePosition position = getTilePosition(*neighbour);
+                if (std::find(result.begin(), result.end(), position) == result.end())
+                    result.push_back(position);
+            }
+        }
+        return result;
+    }
+
+    std::vector<TilePosition> findTilePath(const dtNavMesh& navMesh, const dtQueryFilter& filter,
+        const TilePosition& start, const TilePosition& end, std::size_t maxNodes)
+    {
+        struct Node
+        {
+            float mCost;
+            TilePosition mParent;
+            bool mClosed;
+        };
+
+        using Item = std::pair<float, TilePosition>;
+
+        std::map<TilePosition, Node> nodes;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+        std::size_t visited = 0;
+
+        nodes.emplace(start, Node {0, start, false});
+        open.emplace(getDistance(start, end), start);
+
+        while (!open.empty())
+        {
+            const TilePosition current = open.top().second;
+            open.pop();
+
+            Node& node = nodes.find(current)->second;
+            if (node.mClosed)
+                continue;
+            node.mClosed = true;
+
+            if (current == end)
+            {
+                std::vector<TilePosition> result;
+                for (TilePosition position = end; position != start; position = nodes.find(position)->second.mParent)
+                    result.push_back(position);
+                result.push_back(start);
+                std::reverse(result.begin(), result.end());
+                return result;
+            }
+
+            if (++visited > maxNodes)
+                break;
+
+            const dtMeshTile* const tile = navMesh.getTileAt(current.x(), current.y(), 0);
+            if (tile == nullptr || tile->header == nullptr)
+                continue;
+
+            for (const TilePosition& neighbour : getConnectedTiles(navMesh, filter, *tile))
+            {
+                const float cost = node.mCost + getDistance(current, neighbour);
+                const auto it = nodes.find(neighbour);
+                if (it != nodes.end() && (it->second.mClosed || it->second.mCost <= cost))
+                    continue;
+                nodes.insert_or_assign(neighbour, Node {cost, current, false});
+                open.emplace(cost + getDistance(neighbour, end), neighbour);
+            }
+        }
+
+        return {};
+    }
+
+    std::optional<PathTarget> findCoarsePathTarget(const dtNavMesh& navMesh, const dtNavMeshQuery& navMeshQuery,
+        const dtQueryFilter& filter, dtPolyRef startRef, dtPolyRef endRef, int refinementTiles, std::size_t maxNodes)
+    {
+        const dtMeshTile* const startTile = getTile(navMesh, startRef);
+        const dtMeshTile* const endTile = getTile(navMesh, endRef);
+        if (startTile == nullptr || endTile == nullptr)
+            return {};
+
+        const TilePosition start = getTilePosition(*startTile);
+        const TilePosition end = getTilePosition(*endTile);
+        if (getChebyshevDistance(start, end) <= refinementTiles)
+            return {};
+
+        const std::vector<TilePosition> tilePath = findTilePath(navMesh, filter, start, end, maxNodes);
+        if (tilePath.empty())
+            return {};
+
+        const auto next = std::find_if(tilePath.begin(), tilePath.end(),
+            [&] (const TilePosition& v) { return getChebyshevDistance(start, v) > refinementTiles; });
+        if (next == tilePath.begin() || next == tilePath.end())
+            return {};
+
+        const TilePosition& target = *std::prev(next);
+        const dtMeshTile* const tile = navMesh.getTileAt(target.x(), target.y(), 0);
+        if (tile == nullptr || tile->header == nullptr)
+            return {};
+
+        return findTileExit(navMesh, navMeshQuery, filter, *tile, *next);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDTILEPATH_H
+#define OPENMW_COMPONENTS_DETOURNAVIGATOR_FINDTILEPATH_H
+
+#include "tileposition.hpp"
+
+#include <DetourNavMesh.h>
+
+#include <osg/Vec3f>
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+class dtNavMeshQuery;
+class dtQueryFilter;
+
+namespace DetourNavigator
+{
+    /**
+     * @brief getConnectedTiles returns neighbour tiles linked to polygons of the tile. Only polygons passing the
+     * filter are considered.
+     */
+    std::vector<TilePosition> getConnectedTiles(const dtNavMesh& navMesh, const dtQueryFilter& filter,
+        const dtMeshTile& tile);
+
+    /**
+     * @brief findTilePath searches a route over navmesh tiles graph where tiles are connected by polygon links.
+     * @param maxNodes limits number of visited tiles.
+     * @return tiles from start to end inclusive or empty vector if there is no route.
+     */
+    std::vector<TilePosition> findTilePath(const dtNavMesh& navMesh, const dtQueryFilter& filter,
+        const TilePosition& start, const TilePosition& end, std::size_t maxNodes);
+
+    struct PathTarget
+    {
+        dtPolyRef mRef;
+        osg::Vec3f mPosition;
+    };
+
+    /**
+     * @brief findCoarsePathTarget plans a route over navmesh tiles when end is further than refinementTiles tiles
+     * from start and returns a point on the route to build detailed path to instead of the end.
+     * @return empty optional if end is close enough or there is no route over tiles.
+     */
+    std::optional<PathTarget> findCoarsePathTarget(const dtNavMesh& navMesh, const dtNavMeshQuery& navMeshQuery,
+        const dtQueryFilter& filter, dtPolyRef startRef, dtPolyRef endRef, int refinementTiles, std::size_t maxNodes);
+}
+
+#endif
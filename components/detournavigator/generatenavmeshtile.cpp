@@ -18,23 +18,10 @@
 #include <vector>
 #include <optional>
 #include <functional>
+#include <string>
 
 namespace DetourNavigator
 {
-    namespace
-    {
-        struct Ignore
-        {
-            std::shared_ptr<NavMeshTileConsumer> mConsumer;
-
-            ~Ignore() noexcept
-            {
-                if (mConsumer != nullptr)
-                    mConsumer->ignore();
-            }
-        };
-    }
-
     GenerateNavMeshTile::GenerateNavMeshTile(std::string worldspace, const TilePosition& tilePosition,
             RecastMeshProvider recastMeshProvider, const osg::Vec3f& agentHalfExtents,
             const DetourNavigator::Settings& settings, std::weak_ptr<NavMeshTileConsumer> consumer)
@@ -59,12 +46,13 @@ namespace DetourNavigator
 
         try
         {
-            Ignore ignore {consumer};
-
             const std::shared_ptr<RecastMesh> recastMesh = mRecastMeshProvider.getMesh(mWorldspace, mTilePosition);
 
             if (recastMesh == nullptr || isEmpty(*recastMesh))
+            {
+                consumer->ignore(mWorldspace, mTilePosition);
                 return;
+            }
 
             const std::vector<DbRefGeometryObject> objects = makeDbRefGeometryObjects(recastMesh->getMeshSources(),
                 [&] (const MeshSource& v) { return consumer->resolveMeshSource(v); });
@@ -72,24 +60,29 @@ namespace DetourNavigator
             const std::optional<NavMeshTileInfo> info = consumer->find(mWorldspace, mTilePosition, input);
 
             if (info.has_value() && info->mVersion == mSettings.mNavMeshVersion)
+            {
+                consumer->identity(mWorldspace, mTilePosition, info->mTileId);
                 return;
+            }
 
             const auto data = prepareNavMeshTileData(*recastMesh, mTilePosition, mAgentHalfExtents, mSettings.mRecast);
 
             if (data == nullptr)
+            {
+                consumer->ignore(mWorldspace, mTilePosition);
                 return;
+            }
 
             if (info.has_value())
-                consumer->update(info->mTileId, mSettings.mNavMeshVersion, *data);
+                consumer->update(mWorldspace, mTilePosition, info->mTileId, mSettings.mNavMeshVersion, *data);
             else
                 consumer->insert(mWorldspace, mTilePosition, mSettings.mNavMeshVersion, input, *data);
-
-            ignore.mConsumer = nullptr;
         }
         catch (const std::exception& e)
         {
             Log(Debug::Warning) << "Failed to generate navmesh for worldspace \"" << mWorldspace
                                 << "\" tile " << mTilePosition << ": " << e.what();
+            consumer->cancel(e.what());
         }
     }
 }
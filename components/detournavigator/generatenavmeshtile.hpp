@@ -39,12 +39,21 @@ namespace DetourNavigator
         virtual std::optional<NavMeshTileInfo> find(const std::string& worldspace, const TilePosition& tilePosition,
             const std::vector<std::byte>& input) = 0;
 
-        virtual void ignore() = 0;
+        /// Called for a tile which has no navmesh: there is no geometry or the generated navmesh is empty.
+        virtual void ignore(const std::string& worldspace, const TilePosition& tilePosition) = 0;
+
+        /// Called for a tile which is already stored with the same input and version.
+        virtual void identity(const std::string& worldspace, const TilePosition& tilePosition,
+                              std::int64_t tileId) = 0;
 
         virtual void insert(const std::string& worldspace, const TilePosition& tilePosition,
                             std::int64_t version, const std::vector<std::byte>& input, PreparedNavMeshData& data) = 0;
 
-        virtual void update(std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) = 0;
+        virtual void update(const std::string& worldspace, const TilePosition& tilePosition,
+                            std::int64_t tileId, std::int64_t version, PreparedNavMeshData& data) = 0;
+
+        /// Called when tile generation failed. Nothing is known about the tile, so stored data should be kept.
+        virtual void cancel(std::string_view reason) = 0;
     };
 
     class GenerateNavMeshTile final : public SceneUtil::WorkItem
@@ -7,6 +7,7 @@
 #include "waitconditiontype.hpp"
 #include "heightfieldshape.hpp"
 #include "objecttransform.hpp"
+#include "asyncpathfinder.hpp"
 
 #include <components/resource/bulletshape.hpp>
 
@@ -193,6 +194,14 @@ namespace DetourNavigator
          */
         virtual std::map<osg::Vec3f, SharedNavMeshCacheItem> getNavMeshes() const = 0;
 
+        /**
+         * @brief findPathAsync posts path search to be done by worker threads.
+         * @param query defines agent, path ends and allowed surfaces.
+         * @param priority queries with lower value are processed first, e.g. distance from player to actor.
+         * @return future with result of the search. Path points are in scene coordinates.
+         */
+        virtual std::future<PathQueryResult> findPathAsync(const PathQuery& query, float priority) = 0;
+
         virtual const Settings& getSettings() const = 0;
 
         virtual void reportStats(unsigned int frameNumber, osg::Stats& stats) const = 0;
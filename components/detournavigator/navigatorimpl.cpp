@@ -13,6 +13,7 @@ namespace DetourNavigator
         : mSettings(settings)
         , mNavMeshManager(mSettings, std::move(db))
         , mUpdatesEnabled(true)
+        , mAsyncPathFinder(mSettings, mSettings.mAsyncPathFinderThreads)
     {
     }
 
@@ -188,6 +189,18 @@ namespace DetourNavigator
         return mNavMeshManager.getNavMeshes();
     }
 
+    std::future<PathQueryResult> NavigatorImpl::findPathAsync(const PathQuery& query, float priority)
+    {
+        const auto navMesh = getNavMesh(query.mAgentHalfExtents);
+        if (navMesh == nullptr)
+        {
+            std::promise<PathQueryResult> result;
+            result.set_value(PathQueryResult {Status::NavMeshNotFound, {}});
+            return result.get_future();
+        }
+        return mAsyncPathFinder.post(navMesh, query, priority);
+    }
+
     const Settings& NavigatorImpl::getSettings() const
     {
         return mSettings;
@@ -196,6 +209,7 @@ namespace DetourNavigator
     void NavigatorImpl::reportStats(unsigned int frameNumber, osg::Stats& stats) const
     {
         mNavMeshManager.reportStats(frameNumber, stats);
+        mAsyncPathFinder.reportStats(frameNumber, stats);
     }
 
     RecastMeshTiles NavigatorImpl::getRecastMeshTiles() const
@@ -60,6 +60,8 @@ namespace DetourNavigator
 
         std::map<osg::Vec3f, SharedNavMeshCacheItem> getNavMeshes() const override;
 
+        std::future<PathQueryResult> findPathAsync(const PathQuery& query, float priority) override;
+
         const Settings& getSettings() const override;
 
         void reportStats(unsigned int frameNumber, osg::Stats& stats) const override;
@@ -76,6 +78,7 @@ namespace DetourNavigator
         std::map<osg::Vec3f, std::size_t> mAgents;
         std::unordered_map<ObjectId, ObjectId> mAvoidIds;
         std::unordered_map<ObjectId, ObjectId> mWaterIds;
+        AsyncPathFinder mAsyncPathFinder;
 
         void updateAvoidShapeId(const ObjectId id, const ObjectId avoidId);
         void updateWaterShapeId(const ObjectId id, const ObjectId waterId);
@@ -90,6 +90,13 @@ namespace DetourNavigator
             return std::map<osg::Vec3f, SharedNavMeshCacheItem>();
         }
 
+        std::future<PathQueryResult> findPathAsync(const PathQuery& /*query*/, float /*priority*/) override
+        {
+            std::promise<PathQueryResult> result;
+            result.set_value(PathQueryResult {Status::NavMeshNotFound, {}});
+            return result.get_future();
+        }
+
         const Settings& getSettings() const override
         {
             return mDefaultSettings;
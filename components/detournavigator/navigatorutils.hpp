@@ -18,13 +18,14 @@ namespace DetourNavigator
      * @param includeFlags setup allowed surfaces for actor to walk.
      * @param out the beginning of the destination range.
      * @param endTolerance defines maximum allowed distance to end path point in addition to agentHalfExtents
+     * @param allowCoarsePath allows to end the path on a route over tiles before far end, see findSmoothPath.
      * @return Output iterator to the element in the destination range, one past the last element of found path.
      * Equal to out if no path is found.
      */
     template <class OutputIterator>
     inline Status findPath(const Navigator& navigator, const osg::Vec3f& agentHalfExtents, const float stepSize, const osg::Vec3f& start,
         const osg::Vec3f& end, const Flags includeFlags, const DetourNavigator::AreaCosts& areaCosts,
-        float endTolerance, OutputIterator& out)
+        float endTolerance, bool allowCoarsePath, OutputIterator& out)
     {
         static_assert(
             std::is_same<
@@ -39,7 +40,20 @@ namespace DetourNavigator
         const auto settings = navigator.getSettings();
         return findSmoothPath(navMesh->lockConst()->getImpl(), toNavMeshCoordinates(settings.mRecast, agentHalfExtents),
             toNavMeshCoordinates(settings.mRecast, stepSize), toNavMeshCoordinates(settings.mRecast, start),
-            toNavMeshCoordinates(settings.mRecast, end), includeFlags, areaCosts, settings, endTolerance, out);
+            toNavMeshCoordinates(settings.mRecast, end), includeFlags, areaCosts, settings, endTolerance,
+            allowCoarsePath, out);
+    }
+
+    /**
+     * @brief findPath builds a complete path to the end, see the overload above.
+     */
+    template <class OutputIterator>
+    inline Status findPath(const Navigator& navigator, const osg::Vec3f& agentHalfExtents, const float stepSize, const osg::Vec3f& start,
+        const osg::Vec3f& end, const Flags includeFlags, const DetourNavigator::AreaCosts& areaCosts,
+        float endTolerance, OutputIterator& out)
+    {
+        return findPath(navigator, agentHalfExtents, stepSize, start, end, includeFlags, areaCosts, endTolerance,
+            false, out);
     }
 
     /**
@@ -83,6 +83,31 @@ namespace DetourNavigator
              WHERE tile_id = :tile_id
         )";
 
+        constexpr std::string_view deleteTilesAtQuery = R"(
+            DELETE FROM tiles
+             WHERE worldspace = :worldspace
+               AND tile_position_x = :tile_position_x
+               AND tile_position_y = :tile_position_y
+        )";
+
+        constexpr std::string_view deleteTilesAtExceptQuery = R"(
+            DELETE FROM tiles
+             WHERE worldspace = :worldspace
+               AND tile_position_x = :tile_position_x
+               AND tile_position_y = :tile_position_y
+               AND tile_id != :exclude_tile_id
+        )";
+
+        constexpr std::string_view deleteTilesOutsideRangeQuery = R"(
+            DELETE FROM tiles
+             WHERE worldspace = :worldspace
+               AND (   tile_position_x < :begin_tile_position_x
+                    OR tile_position_y < :begin_tile_position_y
+                    OR tile_position_x >= :end_tile_position_x
+                    OR tile_position_y >= :end_tile_position_y
+                   )
+        )";
+
         constexpr std::string_view getMaxShapeIdQuery = R"(
             SELECT max(shape_id) FROM shapes
         )";
@@ -118,6 +143,9 @@ namespace DetourNavigator
         , mGetTileData(*mDb, DbQueries::GetTileData {})
         , mInsertTile(*mDb, DbQueries::InsertTile {})
         , mUpdateTile(*mDb, DbQueries::UpdateTile {})
+        , mDeleteTilesAt(*mDb, DbQueries::DeleteTilesAt {})
+        , mDeleteTilesAtExcept(*mDb, DbQueries::DeleteTilesAtExcept {})
+        , mDeleteTilesOutsideRange(*mDb, DbQueries::DeleteTilesOutsideRange {})
         , mGetMaxShapeId(*mDb, DbQueries::GetMaxShapeId {})
         , mFindShapeId(*mDb, DbQueries::FindShapeId {})
         , mInsertShape(*mDb, DbQueries::InsertShape {})
@@ -173,6 +201,22 @@ namespace DetourNavigator
         return execute(*mDb, mUpdateTile, tileId, version, compressedData);
     }
 
+    int NavMeshDb::deleteTilesAt(const std::string& worldspace, const TilePosition& tilePosition)
+    {
+        return execute(*mDb, mDeleteTilesAt, worldspace, tilePosition);
+    }
+
+    int NavMeshDb::deleteTilesAtExcept(const std::string& worldspace, const TilePosition& tilePosition,
+        TileId excludeTileId)
+    {
+        return execute(*mDb, mDeleteTilesAtExcept, worldspace, tilePosition, excludeTileId);
+    }
+
+    int NavMeshDb::deleteTilesOutsideRange(const std::string& worldspace, const TilesPositionsRange& range)
+    {
+        return execute(*mDb, mDeleteTilesOutsideRange, worldspace, range);
+    }
+
     ShapeId NavMeshDb::getMaxShapeId()
     {
         ShapeId shapeId {0};
@@ -261,6 +305,48 @@ namespace DetourNavigator
             Sqlite3::bindParameter(db, statement, ":data", data);
         }
 
+        std::string_view DeleteTilesAt::text() noexcept
+        {
+            return deleteTilesAtQuery;
+        }
+
+        void DeleteTilesAt::bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+            const TilePosition& tilePosition)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
+            Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
+        }
+
+        std::string_view DeleteTilesAtExcept::text() noexcept
+        {
+            return deleteTilesAtExceptQuery;
+        }
+
+        void DeleteTilesAtExcept::bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+            const TilePosition& tilePosition, TileId excludeTileId)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":tile_position_x", tilePosition.x());
+            Sqlite3::bindParameter(db, statement, ":tile_position_y", tilePosition.y());
+            Sqlite3::bindParameter(db, statement, ":exclude_tile_id", excludeTileId);
+        }
+
+        std::string_view DeleteTilesOutsideRange::text() noexcept
+        {
+            return deleteTilesOutsideRangeQuery;
+        }
+
+        void DeleteTilesOutsideRange::bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+            const TilesPositionsRange& range)
+        {
+            Sqlite3::bindParameter(db, statement, ":worldspace", worldspace);
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_x", range.mBegin.x());
+            Sqlite3::bindParameter(db, statement, ":begin_tile_position_y", range.mBegin.y());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_x", range.mEnd.x());
+            Sqlite3::bindParameter(db, statement, ":end_tile_position_y", range.mEnd.y());
+        }
+
         std::string_view GetMaxShapeId::text() noexcept
         {
             return getMaxShapeIdQuery;
@@ -1,6 +1,7 @@
 #ifndef OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
 #define OPENMW_COMPONENTS_DETOURNAVIGATOR_NAVMESHDB_H
 
+#include "gettilespositions.hpp"
 #include "tileposition.hpp"
 
 #include <components/sqlite3/db.hpp>
@@ -90,6 +91,27 @@ namespace DetourNavigator
                 const std::vector<std::byte>& data);
         };
 
+        struct DeleteTilesAt
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+                const TilePosition& tilePosition);
+        };
+
+        struct DeleteTilesAtExcept
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+                const TilePosition& tilePosition, TileId excludeTileId);
+        };
+
+        struct DeleteTilesOutsideRange
+        {
+            static std::string_view text() noexcept;
+            static void bind(sqlite3& db, sqlite3_stmt& statement, const std::string& worldspace,
+                const TilesPositionsRange& range);
+        };
+
         struct GetMaxShapeId
         {
             static std::string_view text() noexcept;
@@ -131,6 +153,12 @@ namespace DetourNavigator
 
         int updateTile(TileId tileId, TileVersion version, const std::vector<std::byte>& data);
 
+        int deleteTilesAt(const std::string& worldspace, const TilePosition& tilePosition);
+
+        int deleteTilesAtExcept(const std::string& worldspace, const TilePosition& tilePosition, TileId excludeTileId);
+
+        int deleteTilesOutsideRange(const std::string& worldspace, const TilesPositionsRange& range);
+
         ShapeId getMaxShapeId();
 
         std::optional<ShapeId> findShapeId(const std::string& name, ShapeType type, const Sqlite3::ConstBlob& hash);
@@ -144,6 +172,9 @@ namespace DetourNavigator
         Sqlite3::Statement<DbQueries::GetTileData> mGetTileData;
         Sqlite3::Statement<DbQueries::InsertTile> mInsertTile;
         Sqlite3::Statement<DbQueries::UpdateTile> mUpdateTile;
+        Sqlite3::Statement<DbQueries::DeleteTilesAt> mDeleteTilesAt;
+        Sqlite3::Statement<DbQueries::DeleteTilesAtExcept> mDeleteTilesAtExcept;
+        Sqlite3::Statement<DbQueries::DeleteTilesOutsideRange> mDeleteTilesOutsideRange;
         Sqlite3::Statement<DbQueries::GetMaxShapeId> mGetMaxShapeId;
         Sqlite3::Statement<DbQueries::FindShapeId> mFindShapeId;
         Sqlite3::Statement<DbQueries::InsertShape> mInsertShape;
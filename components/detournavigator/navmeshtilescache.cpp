@@ -1,4 +1,7 @@
 #include "navmeshtilescache.hpp"
+#include "serialization.hpp"
+
+#include <components/misc/compression.hpp>
 
 #include <osg/Stats>
 
@@ -6,9 +9,19 @@
 
 namespace DetourNavigator
 {
-    NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize)
-        : mMaxNavMeshDataSize(maxNavMeshDataSize), mUsedNavMeshDataSize(0), mFreeNavMeshDataSize(0),
-          mHitCount(0), mGetCount(0) {}
+    const PreparedNavMeshData* NavMeshTilesCache::Value::get(std::unique_ptr<PreparedNavMeshData>& buffer) const
+    {
+        if (mIterator->mPreparedNavMeshData != nullptr)
+            return mIterator->mPreparedNavMeshData.get();
+        buffer = std::make_unique<PreparedNavMeshData>();
+        if (!deserialize(Misc::decompress(mIterator->mCompressedNavMeshData), *buffer))
+            buffer = nullptr;
+        return buffer.get();
+    }
+
+    NavMeshTilesCache::NavMeshTilesCache(const std::size_t maxNavMeshDataSize, bool compress)
+        : mMaxNavMeshDataSize(maxNavMeshDataSize), mCompress(compress), mUsedNavMeshDataSize(0),
+          mUsedRawNavMeshDataSize(0), mFreeNavMeshDataSize(0), mHitCount(0), mGetCount(0) {}
 
     NavMeshTilesCache::Value NavMeshTilesCache::get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
         const RecastMesh& recastMesh)
@@ -31,8 +44,15 @@ namespace DetourNavigator
     NavMeshTilesCache::Value NavMeshTilesCache::set(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
         const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value)
     {
-        const auto itemSize = sizeof(RecastMesh) + getSize(recastMesh)
+        std::vector<std::byte> compressed;
+        if (mCompress && value != nullptr)
+            compressed = Misc::compress(serialize(*value));
+
+        const auto rawItemSize = sizeof(RecastMesh) + getSize(recastMesh)
             + (value == nullptr ? 0 : sizeof(PreparedNavMeshData) + getSize(*value));
+        const auto itemSize = mCompress
+            ? sizeof(RecastMesh) + getSize(recastMesh) + compressed.size()
+            : rawItemSize;
 
         const std::lock_guard<std::mutex> lock(mMutex);
 
@@ -45,7 +65,8 @@ namespace DetourNavigator
         RecastMeshData key {recastMesh.getMesh(), recastMesh.getWater(),
                     recastMesh.getHeightfields(), recastMesh.getFlatHeightfields()};
 
-        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentHalfExtents, changedTile, std::move(key), itemSize);
+        const auto iterator = mFreeItems.emplace(mFreeItems.end(), agentHalfExtents, changedTile, std::move(key),
+            itemSize, rawItemSize);
         const auto emplaced = mValues.emplace(std::make_tuple(agentHalfExtents, changedTile, std::cref(iterator->mRecastMeshData)), iterator);
 
         if (!emplaced.second)
@@ -57,9 +78,13 @@ namespace DetourNavigator
             return Value(*this, emplaced.first->second);
         }
 
-        iterator->mPreparedNavMeshData = std::move(value);
+        if (mCompress)
+            iterator->mCompressedNavMeshData = std::move(compressed);
+        else
+            iterator->mPreparedNavMeshData = std::move(value);
         ++iterator->mUseCount;
         mUsedNavMeshDataSize += itemSize;
+        mUsedRawNavMeshDataSize += rawItemSize;
         mBusyItems.splice(mBusyItems.end(), mFreeItems, iterator);
 
         return Value(*this, iterator);
@@ -71,6 +96,7 @@ namespace DetourNavigator
         {
             const std::lock_guard<std::mutex> lock(mMutex);
             result.mNavMeshCacheSize = mUsedNavMeshDataSize;
+            result.mNavMeshCacheRawSize = mUsedRawNavMeshDataSize;
             result.mUsedNavMeshTiles = mBusyItems.size();
             result.mCachedNavMeshTiles = mFreeItems.size();
             result.mHitCount = mHitCount;
@@ -82,6 +108,7 @@ namespace DetourNavigator
     void reportStats(const NavMeshTilesCache::Stats& stats, unsigned int frameNumber, osg::Stats& out)
     {
         out.setAttribute(frameNumber, "NavMesh CacheSize", static_cast<double>(stats.mNavMeshCacheSize));
+        out.setAttribute(frameNumber, "NavMesh CacheRawSize", static_cast<double>(stats.mNavMeshCacheRawSize));
         out.setAttribute(frameNumber, "NavMesh UsedTiles", static_cast<double>(stats.mUsedNavMeshTiles));
         out.setAttribute(frameNumber, "NavMesh CachedTiles", static_cast<double>(stats.mCachedNavMeshTiles));
         if (stats.mGetCount > 0)
@@ -97,6 +124,7 @@ namespace DetourNavigator
             return;
 
         mUsedNavMeshDataSize -= item.mSize;
+        mUsedRawNavMeshDataSize -= item.mRawSize;
         mFreeNavMeshDataSize -= item.mSize;
 
         mValues.erase(value);
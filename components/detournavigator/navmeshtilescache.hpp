@@ -10,7 +10,9 @@
 #include <list>
 #include <mutex>
 #include <cassert>
+#include <cstddef>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 namespace osg
@@ -56,15 +58,19 @@ namespace DetourNavigator
             TilePosition mChangedTile;
             RecastMeshData mRecastMeshData;
             std::unique_ptr<PreparedNavMeshData> mPreparedNavMeshData;
+            /// Serialized and compressed mPreparedNavMeshData when cache is compressed
+            std::vector<std::byte> mCompressedNavMeshData;
             std::size_t mSize;
+            std::size_t mRawSize;
 
             Item(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
-                 RecastMeshData&& recastMeshData, std::size_t size)
+                 RecastMeshData&& recastMeshData, std::size_t size, std::size_t rawSize)
                 : mUseCount(0)
                 , mAgentHalfExtents(agentHalfExtents)
                 , mChangedTile(changedTile)
                 , mRecastMeshData(std::move(recastMeshData))
                 , mSize(size)
+                , mRawSize(rawSize)
             {}
         };
 
@@ -110,11 +116,17 @@ namespace DetourNavigator
                 return *this;
             }
 
+            /// Only for not compressed cache
             const PreparedNavMeshData& get() const
             {
+                assert(mIterator->mPreparedNavMeshData != nullptr);
                 return *mIterator->mPreparedNavMeshData;
             }
 
+            /// Compressed data is unpacked into the buffer which has to outlive the result.
+            /// Returns nullptr when data can't be unpacked.
+            const PreparedNavMeshData* get(std::unique_ptr<PreparedNavMeshData>& buffer) const;
+
             operator bool() const
             {
                 return mOwner;
@@ -128,17 +140,20 @@ namespace DetourNavigator
         struct Stats
         {
             std::size_t mNavMeshCacheSize;
+            std::size_t mNavMeshCacheRawSize;
             std::size_t mUsedNavMeshTiles;
             std::size_t mCachedNavMeshTiles;
             std::size_t mHitCount;
             std::size_t mGetCount;
         };
 
-        NavMeshTilesCache(const std::size_t maxNavMeshDataSize);
+        explicit NavMeshTilesCache(const std::size_t maxNavMeshDataSize, bool compress = false);
 
         Value get(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
             const RecastMesh& recastMesh);
 
+        /// Takes ownership of the value only for not compressed cache. Compressed cache stores a copy
+        /// leaving the value untouched.
         Value set(const osg::Vec3f& agentHalfExtents, const TilePosition& changedTile,
             const RecastMesh& recastMesh, std::unique_ptr<PreparedNavMeshData>&& value);
 
@@ -147,7 +162,9 @@ namespace DetourNavigator
     private:
         mutable std::mutex mMutex;
         std::size_t mMaxNavMeshDataSize;
+        const bool mCompress;
         std::size_t mUsedNavMeshDataSize;
+        std::size_t mUsedRawNavMeshDataSize;
         std::size_t mFreeNavMeshDataSize;
         std::size_t mHitCount;
         std::size_t mGetCount;
@@ -31,6 +31,7 @@ namespace DetourNavigator
         int mMaxNavMeshQueryNodes = 0;
         std::size_t mMaxPolygonPathSize = 0;
         std::size_t mMaxSmoothPathSize = 0;
+        int mPathRefinementTiles = 0;
     };
 
     struct Settings
@@ -46,7 +47,9 @@ namespace DetourNavigator
         int mWaitUntilMinDistanceToPlayer = 0;
         int mMaxTilesNumber = 0;
         std::size_t mAsyncNavMeshUpdaterThreads = 0;
+        std::size_t mAsyncPathFinderThreads = 0;
         std::size_t mMaxNavMeshTilesCacheSize = 0;
+        bool mCompressNavMeshTilesCache = false;
         std::string mRecastMeshPathPrefix;
         std::string mNavMeshPathPrefix;
         std::chrono::milliseconds mMinUpdateInterval;
@@ -2,6 +2,7 @@
 
 #include <streambuf>
 #include <algorithm>
+#include <atomic>
 
 #include "lowlevelfile.hpp"
 
@@ -9,6 +10,8 @@ namespace
 {
 // somewhat arbitrary though 64KB buffers didn't seem to improve performance any
 const size_t sBufferSize = 8192;
+
+std::atomic<std::uint64_t> sBytesRead {0};
 }
 
 namespace Files
@@ -45,6 +48,7 @@ namespace Files
                 // Read in the next chunk of data, and set the read pointers on success
                 // Failure will throw exception in LowLevelFile
                 size_t got = mFile.read(mBuffer, toRead);
+                sBytesRead.fetch_add(got, std::memory_order_relaxed);
                 setg(&mBuffer[0], &mBuffer[0], &mBuffer[0]+got);
             }
             if(gptr() == egptr())
@@ -115,4 +119,9 @@ namespace Files
         auto buf = std::unique_ptr<std::streambuf>(new ConstrainedFileStreamBuf(filename, start, length));
         return IStreamPtr(new ConstrainedFileStream(std::move(buf)));
     }
+
+    std::uint64_t getConstrainedFileStreamBytesRead()
+    {
+        return sBytesRead.load(std::memory_order_relaxed);
+    }
 }
@@ -1,6 +1,7 @@
 #ifndef OPENMW_CONSTRAINEDFILESTREAM_H
 #define OPENMW_CONSTRAINEDFILESTREAM_H
 
+#include <cstdint>
 #include <istream>
 #include <memory>
 
@@ -22,6 +23,10 @@ typedef std::shared_ptr<std::istream> IStreamPtr;
 
 IStreamPtr openConstrainedFileStream(const char *filename, size_t start=0, size_t length=0xFFFFFFFF);
 
+/// Total number of bytes read from disk by all constrained file streams of all threads.
+/// @note Includes VFS archives and content files.
+std::uint64_t getConstrainedFileStreamBytesRead();
+
 }
 
 #endif
@@ -1,7 +1,9 @@
 #include "interpreter.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
+#include <string>
 
 #include "opcodes.hpp"
 
@@ -19,18 +21,33 @@ namespace Interpreter
         throw std::runtime_error(error);
     }
 
+    static void executeUnknownCode(void* /*opcode*/, Runtime& /*runtime*/, unsigned int code)
+    {
+        const unsigned int segSpec = code >> 30;
+
+        if (segSpec == 0)
+            abortUnknownCode(0, code >> 24);
+        if (segSpec == 2)
+            abortUnknownCode(2, (code >> 20) & 0x3ff);
+        if (code >> 26 == 0x30)
+            abortUnknownCode(3, (code >> 8) & 0x3ffff);
+        if (code >> 26 == 0x32)
+            abortUnknownCode(5, code & 0x3ffffff);
+
+        abortUnknownSegment(code);
+    }
+
     template<typename T>
-    auto& getDispatcher(const T& segment, unsigned int seg, int opcode)
+    static Instruction getInstruction(const T& segment, Type_Code code, int opcode, unsigned int arg0)
     {
-        auto it = segment.find(opcode);
-        if (it == segment.end())
-        {
-            abortUnknownCode(seg, opcode);
-        }
-        return it->second;
+        const auto it = std::lower_bound(segment.begin(), segment.end(), opcode,
+            [] (const auto& entry, int value) { return entry.mCode < value; });
+        if (it == segment.end() || it->mCode != opcode)
+            return Instruction {&executeUnknownCode, nullptr, code};
+        return Instruction {it->mHandler, it->mOpcode.get(), arg0};
     }
 
-    void Interpreter::execute (Type_Code code)
+    Instruction Interpreter::decode (Type_Code code) const
     {
         unsigned int segSpec = code >> 30;
 
@@ -41,7 +58,7 @@ namespace Interpreter
                 const int opcode = code >> 24;
                 const unsigned int arg0 = code & 0xffffff;
 
-                return getDispatcher(mSegment0, 0, opcode)->execute(mRuntime, arg0);
+                return getInstruction(mSegment0, code, opcode, arg0);
             }
 
             case 2:
@@ -49,7 +66,7 @@ namespace Interpreter
                 const int opcode = (code >> 20) & 0x3ff;
                 const unsigned int arg0 = code & 0xfffff;
 
-                return getDispatcher(mSegment2, 2, opcode)->execute(mRuntime, arg0);
+                return getInstruction(mSegment2, code, opcode, arg0);
             }
         }
 
@@ -62,18 +79,18 @@ namespace Interpreter
                 const int opcode = (code >> 8) & 0x3ffff;
                 const unsigned int arg0 = code & 0xff;
 
-                return getDispatcher(mSegment3, 3, opcode)->execute(mRuntime, arg0);
+                return getInstruction(mSegment3, code, opcode, arg0);
             }
 
             case 0x32:
             {
                 const int opcode = code & 0x3ffffff;
 
-                return getDispatcher(mSegment5, 5, opcode)->execute(mRuntime);
+                return getInstruction(mSegment5, code, opcode, 0);
             }
         }
 
-        abortUnknownSegment (code);
+        return Instruction {&executeUnknownCode, nullptr, code};
     }
 
     void Interpreter::begin()
@@ -106,9 +123,31 @@ namespace Interpreter
     Interpreter::Interpreter() : mRunning (false)
     {}
 
+    Program Interpreter::decode (const Type_Code *code, int codeSize) const
+    {
+        assert (codeSize>=4);
+
+        const int opcodes = static_cast<int> (code[0]);
+        const Type_Code *codeBlock = code + 4;
+
+        Program program;
+        program.reserve (opcodes);
+
+        for (int i = 0; i < opcodes; ++i)
+            program.push_back (decode (codeBlock[i]));
+
+        return program;
+    }
+
     void Interpreter::run (const Type_Code *code, int codeSize, Context& context)
+    {
+        run (decode (code, codeSize), code, codeSize, context);
+    }
+
+    void Interpreter::run (const Program& program, const Type_Code *code, int codeSize, Context& context)
     {
         assert (codeSize>=4);
+        assert (program.size() == code[0]);
 
         begin();
 
@@ -116,15 +155,14 @@ namespace Interpreter
         {
             mRuntime.configure (code, codeSize, context);
 
-            int opcodes = static_cast<int> (code[0]);
-
-            const Type_Code *codeBlock = code + 4;
+            const int opcodes = static_cast<int> (program.size());
+            const Instruction *instructions = program.data();
 
             while (mRuntime.getPC()>=0 && mRuntime.getPC()<opcodes)
             {
-                Type_Code runCode = codeBlock[mRuntime.getPC()];
+                const Instruction& instruction = instructions[mRuntime.getPC()];
                 mRuntime.setPC (mRuntime.getPC()+1);
-                execute (runCode);
+                instruction.mHandler (instruction.mOpcode, mRuntime, instruction.mArg0);
             }
         }
         catch (...)
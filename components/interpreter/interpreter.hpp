@@ -1,11 +1,12 @@
 #ifndef INTERPRETER_INTERPRETER_H_INCLUDED
 #define INTERPRETER_INTERPRETER_H_INCLUDED
 
-#include <map>
+#include <algorithm>
 #include <stack>
 #include <memory>
 #include <cassert>
 #include <utility>
+#include <vector>
 
 #include "runtime.hpp"
 #include "types.hpp"
@@ -13,31 +14,72 @@
 
 namespace Interpreter
 {
+    typedef void (*Handler) (void *opcode, Runtime& runtime, unsigned int arg0);
+
+    /// Instruction with the opcode already resolved to a direct handler call.
+    struct Instruction
+    {
+        Handler mHandler;
+        void *mOpcode;
+        unsigned int mArg0;
+    };
+
+    /// Pre-decoded code block of a script (see Interpreter::decode). Only valid for the interpreter
+    /// that decoded it.
+    typedef std::vector<Instruction> Program;
+
     class Interpreter
     {
+            template<typename TOpcode>
+            struct OpcodeEntry
+            {
+                int mCode;
+                Handler mHandler;
+                std::unique_ptr<TOpcode> mOpcode;
+            };
+
+            /// Opcodes of one segment, sorted by code. Only searched when a script is decoded.
+            template<typename TOpcode>
+            using Segment = std::vector<OpcodeEntry<TOpcode>>;
+
             std::stack<Runtime> mCallstack;
             bool mRunning;
             Runtime mRuntime;
-            std::map<int, std::unique_ptr<Opcode1>> mSegment0;
-            std::map<int, std::unique_ptr<Opcode1>> mSegment2;
-            std::map<int, std::unique_ptr<Opcode1>> mSegment3;
-            std::map<int, std::unique_ptr<Opcode0>> mSegment5;
+            Segment<Opcode1> mSegment0;
+            Segment<Opcode1> mSegment2;
+            Segment<Opcode1> mSegment3;
+            Segment<Opcode0> mSegment5;
 
             // not implemented
             Interpreter (const Interpreter&);
             Interpreter& operator= (const Interpreter&);
 
-            void execute (Type_Code code);
+            Instruction decode (Type_Code code) const;
 
             void begin();
 
             void end();
 
-            template<typename TSeg, typename TOp>
-            void installSegment(TSeg& seg, int code, TOp&& op)
+            // opcode points to the base class, it has to be cast back to it before the downcast
+            template<typename T>
+            static void callOpcode1 (void *opcode, Runtime& runtime, unsigned int arg0)
             {
-                assert(seg.find(code) == seg.end());
-                seg.emplace(code, std::move(op));
+                static_cast<T *> (static_cast<Opcode1 *> (opcode))->T::execute (runtime, arg0);
+            }
+
+            template<typename T>
+            static void callOpcode0 (void *opcode, Runtime& runtime, unsigned int /*arg0*/)
+            {
+                static_cast<T *> (static_cast<Opcode0 *> (opcode))->T::execute (runtime);
+            }
+
+            template<typename TOpcode, typename T>
+            void installSegment(Segment<TOpcode>& seg, int code, Handler handler, std::unique_ptr<T>&& op)
+            {
+                const auto it = std::lower_bound(seg.begin(), seg.end(), code,
+                    [] (const OpcodeEntry<TOpcode>& entry, int value) { return entry.mCode < value; });
+                assert(it == seg.end() || it->mCode != code);
+                seg.insert(it, OpcodeEntry<TOpcode> {code, handler, std::move(op)});
             }
 
         public:
@@ -47,28 +89,35 @@ namespace Interpreter
             template<typename T, typename ...TArgs>
             void installSegment0(int code, TArgs&& ...args)
             {
-                installSegment(mSegment0, code, std::make_unique<T>(std::forward<TArgs>(args)...));
+                installSegment(mSegment0, code, &callOpcode1<T>, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
             template<typename T, typename ...TArgs>
             void installSegment2(int code, TArgs&& ...args)
             {
-                installSegment(mSegment2, code, std::make_unique<T>(std::forward<TArgs>(args)...));
+                installSegment(mSegment2, code, &callOpcode1<T>, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
             template<typename T, typename ...TArgs>
             void installSegment3(int code, TArgs&& ...args)
             {
-                installSegment(mSegment3, code, std::make_unique<T>(std::forward<TArgs>(args)...));
+                installSegment(mSegment3, code, &callOpcode1<T>, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
             template<typename T, typename ...TArgs>
             void installSegment5(int code, TArgs&& ...args)
             {
-                installSegment(mSegment5, code, std::make_unique<T>(std::forward<TArgs>(args)...));
+                installSegment(mSegment5, code, &callOpcode0<T>, std::make_unique<T>(std::forward<TArgs>(args)...));
             }
 
+            Program decode (const Type_Code *code, int codeSize) const;
+            ///< Translate the code block of a script into direct handler calls. Unknown opcodes are
+            /// reported only when they are executed.
+
             void run (const Type_Code *code, int codeSize, Context& context);
+
+            void run (const Program& program, const Type_Code *code, int codeSize, Context& context);
+            ///< \a program must have been decoded from \a code by this interpreter.
     };
 }
 
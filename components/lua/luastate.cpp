@@ -4,6 +4,8 @@
 #include <luajit.h>
 #endif // NO_LUAJIT
 
+#include <algorithm>
+#include <cstdlib>
 #include <filesystem>
 
 #include <components/debug/debuglog.hpp>
@@ -49,8 +51,104 @@ namespace LuaUtil
         "type", "unpack", "xpcall", "rawequal", "rawget", "rawset", "getmetatable", "setmetatable"};
     static const std::string safePackages[] = {"coroutine", "math", "string", "table"};
 
-    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf) : mConf(conf), mVFS(vfs)
+    void* LuaState::trackingAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize)
     {
+        LuaState* self = static_cast<LuaState*>(ud);
+        if (ptr == nullptr)
+            osize = 0;  // In Lua 5.2+ osize encodes the type of the object if ptr is NULL.
+
+        int owner = self->mActiveScope != nullptr ? self->mActiveScope->mScriptId : -1;
+        auto ownerIt = self->mBigAllocOwners.end();
+        if (SmallObjectPool::isSmall(osize))
+            owner = SmallObjectPool::getOwner(ptr);  // Reallocated memory still belongs to the same script.
+        else if (ptr != nullptr)
+        {
+            ownerIt = self->mBigAllocOwners.find(ptr);
+            owner = ownerIt != self->mBigAllocOwners.end() ? ownerIt->second : -1;
+        }
+        const std::int64_t attributedOld = owner >= 0 ? static_cast<std::int64_t>(osize) : 0;
+        const std::int64_t attributedNew = owner >= 0 ? static_cast<std::int64_t>(nsize) : 0;
+
+        const std::int64_t hardLimit = self->mSettings.mScriptMemoryHardLimit;
+        if (hardLimit > 0 && attributedNew > attributedOld
+            && self->getScriptProfile(owner).mMemoryUsage + attributedNew - attributedOld > hardLimit)
+            return nullptr;  // Lua raises "not enough memory" error in the script.
+
+        void* newPtr = self->mPool.reallocate(ptr, osize, nsize, owner);
+        if (newPtr == nullptr && nsize != 0)
+            return nullptr;
+
+        self->mTotalMemoryUsage += static_cast<std::int64_t>(nsize) - static_cast<std::int64_t>(osize);
+        if (SmallObjectPool::isSmall(osize))
+            self->mSmallAllocMemoryUsage -= static_cast<std::int64_t>(osize);
+        if (SmallObjectPool::isSmall(nsize))
+            self->mSmallAllocMemoryUsage += static_cast<std::int64_t>(nsize);
+
+        if (ownerIt != self->mBigAllocOwners.end())
+            self->mBigAllocOwners.erase(ownerIt);
+        if (owner >= 0 && nsize != 0 && !SmallObjectPool::isSmall(nsize))
+            self->mBigAllocOwners.emplace(newPtr, owner);
+        if (attributedNew != attributedOld)
+        {
+            std::int64_t& usage = self->getScriptProfile(owner).mMemoryUsage;
+            const std::int64_t softLimit = self->mSettings.mScriptMemorySoftLimit;
+            const bool wasBelowSoftLimit = usage <= softLimit;
+            usage += attributedNew - attributedOld;
+            if (softLimit > 0 && wasBelowSoftLimit && usage > softLimit)
+                self->mSoftLimitExceeded = true;
+        }
+        return newPtr;
+    }
+
+    lua_State* LuaState::createLuaRuntime(LuaState* luaState)
+    {
+        if (lua_State* result = lua_newstate(&trackingAllocator, luaState))
+        {
+            luaState->mCustomAllocator = true;
+            luaState->mProfilerEnabled = luaState->mSettings.mProfiler;
+            return result;
+        }
+        Log(Debug::Warning) << "Can't set custom allocator for Lua; Lua profiler and per-script memory limits are disabled";
+        luaState->mTotalMemoryUsage = luaState->mSmallAllocMemoryUsage = 0;
+        return luaL_newstate();
+    }
+
+    static int collectGarbage(lua_State* L)
+    {
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        return 0;
+    }
+
+    void LuaState::checkSoftLimit()
+    {
+        mSoftLimitExceeded = false;
+        // Called from a destructor, so errors in __gc metamethods should not be propagated.
+        lua_State* L = mLua.lua_state();
+        lua_pushcfunction(L, &collectGarbage);
+        if (lua_pcall(L, 0, 0, 0) != 0)
+        {
+            const char* error = lua_tostring(L, -1);
+            Log(Debug::Error) << "Lua garbage collection failed: " << (error != nullptr ? error : "unknown error");
+            lua_pop(L, 1);
+        }
+        for (std::size_t scriptId = 0; scriptId < mScriptsProfile.size(); ++scriptId)
+        {
+            const std::int64_t usage = mScriptsProfile[scriptId].mMemoryUsage;
+            if (usage > mSettings.mScriptMemorySoftLimit)
+                Log(Debug::Warning) << "Lua script " << (*mConf)[scriptId].mScriptPath << " uses " << usage / 1024
+                                    << " KiB, the soft limit is " << mSettings.mScriptMemorySoftLimit / 1024 << " KiB";
+        }
+    }
+
+    LuaState::LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf, const LuaStateSettings& settings)
+        : mSettings(settings)
+        , mLuaHolder(createLuaRuntime(this))
+        , mLua(mLuaHolder.get())
+        , mConf(conf)
+        , mVFS(vfs)
+    {
+        sol::set_default_state(mLua.lua_state());
+
         mLua.open_libraries(sol::lib::base, sol::lib::coroutine, sol::lib::math,
                             sol::lib::string, sol::lib::table, sol::lib::os, sol::lib::debug);
 
@@ -120,6 +218,58 @@ namespace LuaUtil
         mSandboxEnv = sol::nil;
     }
 
+    ScriptProfile& LuaState::getScriptProfile(int scriptId)
+    {
+        if (static_cast<std::size_t>(scriptId) >= mScriptsProfile.size())
+            mScriptsProfile.resize(std::max(static_cast<std::size_t>(scriptId) + 1, mConf->size()));
+        return mScriptsProfile[scriptId];
+    }
+
+    void LuaState::resetFrameProfile()
+    {
+        for (ScriptProfile& profile : mScriptsProfile)
+            profile.mFrameTime = {};
+    }
+
+    LuaState::ProfilingScope::ProfilingScope(LuaState& lua, int scriptId, std::string_view handlerName)
+        : mLua(lua.mCustomAllocator ? &lua : nullptr)
+        , mScriptId(scriptId)
+        , mHandlerName(handlerName)
+        , mParent(lua.mActiveScope)
+    {
+        if (mLua == nullptr)
+            return;
+        mLua->mActiveScope = this;
+        if (mLua->mProfilerEnabled)
+            mStart = std::chrono::steady_clock::now();
+    }
+
+    LuaState::ProfilingScope::~ProfilingScope()
+    {
+        if (mLua == nullptr)
+            return;
+        mLua->mActiveScope = mParent;
+        if (mParent == nullptr && mLua->mSoftLimitExceeded)
+            mLua->checkSoftLimit();
+        if (!mLua->mProfilerEnabled)
+            return;
+
+        const auto elapsed = std::chrono::steady_clock::now() - mStart;
+        const auto time = elapsed - mNestedTime;
+        if (mParent != nullptr)
+            mParent->mNestedTime += elapsed;
+
+        ScriptProfile& profile = mLua->getScriptProfile(mScriptId);
+        profile.mFrameTime += time;
+        profile.mTotalTime += time;
+        auto it = profile.mHandlers.find(mHandlerName);
+        if (it == profile.mHandlers.end())
+            it = profile.mHandlers.emplace(std::string(mHandlerName), ScriptProfile::Handler{}).first;
+        ++it->second.mCalls;
+        it->second.mTotalTime += time;
+        it->second.mMaxTime = std::max(it->second.mMaxTime, time);
+    }
+
     sol::table makeReadOnly(sol::table table)
     {
         if (table == sol::nil)
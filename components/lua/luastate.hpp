@@ -1,19 +1,52 @@
 #ifndef COMPONENTS_LUA_LUASTATE_H
 #define COMPONENTS_LUA_LUASTATE_H
 
+#include <chrono>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include <sol/sol.hpp>
 
 #include <components/vfs/manager.hpp>
 
 #include "configuration.hpp"
+#include "smallobjectpool.hpp"
 
 namespace LuaUtil
 {
 
     std::string getLuaVersion();
 
+    struct LuaStateSettings
+    {
+        // Measure CPU time of every script.
+        bool mProfiler = false;
+
+        // Limits for memory allocated by a single script. 0 means no limit.
+        // Exceeding the soft limit triggers full garbage collection and a warning.
+        // Allocations above the hard limit fail with "not enough memory" error in the script.
+        std::int64_t mScriptMemorySoftLimit = 0;
+        std::int64_t mScriptMemoryHardLimit = 0;
+    };
+
+    struct ScriptProfile
+    {
+        struct Handler
+        {
+            std::size_t mCalls = 0;
+            std::chrono::steady_clock::duration mTotalTime{};
+            std::chrono::steady_clock::duration mMaxTime{};
+        };
+
+        std::int64_t mMemoryUsage = 0;
+        std::chrono::steady_clock::duration mFrameTime{};  // Since the last call of LuaState::resetFrameProfile
+        std::chrono::steady_clock::duration mTotalTime{};
+        std::map<std::string, Handler, std::less<>> mHandlers;
+    };
+
     // Holds Lua state.
     // Provides additional features:
     //   - Load scripts from the virtual filesystem;
@@ -29,11 +62,14 @@ namespace LuaUtil
     class LuaState
     {
     public:
-        explicit LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf);
+        explicit LuaState(const VFS::Manager* vfs, const ScriptsConfiguration* conf,
+                          const LuaStateSettings& settings = LuaStateSettings{});
+        LuaState(const LuaState&) = delete;
+        LuaState(LuaState&&) = delete;
         ~LuaState();
 
-        // Returns underlying sol::state.
-        sol::state& sol() { return mLua; }
+        // Returns underlying sol::state_view.
+        sol::state_view& sol() { return mLua; }
 
         // Can be used by a C++ function that is called from Lua to get the Lua traceback.
         // Makes no sense if called not from Lua code.
@@ -82,6 +118,41 @@ namespace LuaUtil
         sol::function loadFromVFS(const std::string& path);
         sol::environment newInternalLibEnvironment();
 
+        // Attributes memory allocations and CPU time (if the profiler is enabled) to the script while the object exists.
+        // Can be nested; in this case the time of the inner call is not included to the time of the outer one.
+        // Does nothing if Lua implementation doesn't support custom allocators.
+        class ProfilingScope
+        {
+        public:
+            ProfilingScope(LuaState& lua, int scriptId, std::string_view handlerName);
+            ProfilingScope(const ProfilingScope&) = delete;
+            ~ProfilingScope();
+
+        private:
+            friend class LuaState;
+
+            LuaState* mLua;
+            int mScriptId;
+            std::string_view mHandlerName;
+            std::chrono::steady_clock::time_point mStart;
+            std::chrono::steady_clock::duration mNestedTime{};
+            ProfilingScope* mParent;
+        };
+
+        bool isProfilerEnabled() const { return mProfilerEnabled; }
+
+        // Custom allocator is used for the memory pool, memory tracking and limits. It is not available
+        // if Lua implementation doesn't support it (e.g. LuaJIT on 64-bit platforms without GC64).
+        bool hasCustomAllocator() const { return mCustomAllocator; }
+
+        std::int64_t getTotalMemoryUsage() const { return mTotalMemoryUsage; }
+        // Memory in blocks allocated from SmallObjectPool chunks.
+        std::int64_t getSmallAllocMemoryUsage() const { return mSmallAllocMemoryUsage; }
+
+        // Indexed by scriptId. Memory which is not attributed to any script is not included.
+        const std::vector<ScriptProfile>& getScriptsProfile() const { return mScriptsProfile; }
+        void resetFrameProfile();
+
     private:
         static sol::protected_function_result throwIfError(sol::protected_function_result&&);
         template <typename... Args>
@@ -89,7 +160,30 @@ namespace LuaUtil
 
         sol::function loadScriptAndCache(const std::string& path);
 
-        sol::state mLua;
+        static void* trackingAllocator(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+        static lua_State* createLuaRuntime(LuaState* luaState);
+        ScriptProfile& getScriptProfile(int scriptId);
+        void checkSoftLimit();
+
+        struct LuaCloser
+        {
+            void operator()(lua_State* L) const { lua_close(L); }
+        };
+
+        // Allocator data should be declared before mLuaHolder because the allocator is used by lua_close.
+        const LuaStateSettings mSettings;
+        SmallObjectPool mPool;
+        bool mCustomAllocator = false;
+        bool mProfilerEnabled = false;
+        bool mSoftLimitExceeded = false;
+        std::int64_t mTotalMemoryUsage = 0;
+        std::int64_t mSmallAllocMemoryUsage = 0;
+        std::vector<ScriptProfile> mScriptsProfile;
+        std::unordered_map<const void*, int> mBigAllocOwners;  // Owners of small blocks are stored in the pool
+        ProfilingScope* mActiveScope = nullptr;
+
+        std::unique_ptr<lua_State, LuaCloser> mLuaHolder;
+        sol::state_view mLua;
         const ScriptsConfiguration* mConf;
         sol::table mSandboxEnv;
         std::map<std::string, sol::bytecode> mCompiledScripts;
@@ -74,6 +74,7 @@ namespace LuaUtil
 
         try
         {
+            const LuaState::ProfilingScope profilingScope(mLua, scriptId, "<load>");
             sol::object scriptOutput = mLua.runInNewSandbox(path, mNamePrefix, mAPI, script.mHiddenData);
             if (scriptOutput == sol::nil)
                 return true;
@@ -278,6 +279,7 @@ namespace LuaUtil
         {
             try
             {
+                const LuaState::ProfilingScope profilingScope(mLua, list[i].mScriptId, eventName);
                 sol::object res = LuaUtil::call(list[i].mFn, data);
                 if (res != sol::nil && !res.as<bool>())
                     break;  // Skip other handlers if 'false' was returned.
@@ -301,6 +303,7 @@ namespace LuaUtil
         try
         {
             const std::string& data = mLua.getConfiguration()[scriptId].mInitializationData;
+            const LuaState::ProfilingScope profilingScope(mLua, scriptId, HANDLER_INIT);
             LuaUtil::call(onInit, deserialize(mLua.sol(), data, mSerializer));
         }
         catch (std::exception& e) { printError(scriptId, "onInit failed", e); }
@@ -335,6 +338,7 @@ namespace LuaUtil
             {
                 try
                 {
+                    const LuaState::ProfilingScope profilingScope(mLua, scriptId, HANDLER_SAVE);
                     sol::object state = LuaUtil::call(*script.mOnSave);
                     savedScript.mData = serialize(state, mSerializer);
                 }
@@ -389,6 +393,7 @@ namespace LuaUtil
                     sol::object state = deserialize(mLua.sol(), savedScript->mData, mSerializer);
                     sol::object initializationData =
                         deserialize(mLua.sol(), mLua.getConfiguration()[scriptId].mInitializationData, mSerializer);
+                    const LuaState::ProfilingScope profilingScope(mLua, scriptId, HANDLER_LOAD);
                     LuaUtil::call(*onLoad, state, initializationData);
                 }
                 catch (std::exception& e) { printError(scriptId, "onLoad failed", e); }
@@ -493,6 +498,7 @@ namespace LuaUtil
         try
         {
             Script& script = getScript(t.mScriptId);
+            const LuaState::ProfilingScope profilingScope(mLua, t.mScriptId, "<timer>");
             if (t.mSerializable)
             {
                 const std::string& callbackName = std::get<std::string>(t.mCallback);
@@ -85,6 +85,7 @@ namespace LuaUtil
         virtual ~ScriptsContainer();
 
         ESM::LuaScriptCfg::Flags getAutoStartMode() const { return mAutoStartMode; }
+        LuaState* getLuaState() const { return &mLua; }
 
         // Adds package that will be available (via `require`) for all scripts in the container.
         // Automatically applies LuaUtil::makeReadOnly to the package.
@@ -167,7 +168,11 @@ namespace LuaUtil
         {
             for (Handler& handler : handlers.mList)
             {
-                try { LuaUtil::call(handler.mFn, args...); }
+                try
+                {
+                    const LuaState::ProfilingScope profilingScope(mLua, handler.mScriptId, handlers.mName);
+                    LuaUtil::call(handler.mFn, args...);
+                }
                 catch (std::exception& e)
                 {
                     Log(Debug::Error) << mNamePrefix << "[" << scriptPath(handler.mScriptId) << "] "
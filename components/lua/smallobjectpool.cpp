@@ -0,0 +1,124 @@
+#include "smallobjectpool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace LuaUtil
+{
+
+    namespace
+    {
+        void* allocateAligned(std::size_t size)
+        {
+#ifdef _WIN32
+            return _aligned_malloc(size, size);
+#else
+            void* result = nullptr;
+            if (posix_memalign(&result, size, size) != 0)
+                return nullptr;
+            return result;
+#endif
+        }
+
+        void freeAligned(void* ptr)
+        {
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            std::free(ptr);
+#endif
+        }
+    }
+
+    SmallObjectPool::~SmallObjectPool()
+    {
+        while (mLastChunk != nullptr)
+        {
+            Chunk* prev = mLastChunk->mPrev;
+            freeAligned(mLastChunk);
+            mLastChunk = prev;
+        }
+    }
+
+    SmallObjectPool::Arena& SmallObjectPool::getArena(int owner)
+    {
+        const std::size_t index = static_cast<std::size_t>(owner + 1);
+        if (index >= mArenas.size())
+            mArenas.resize(index + 1);
+        return mArenas[index];
+    }
+
+    void* SmallObjectPool::allocate(std::size_t size, int owner)
+    {
+        if (owner < 0)
+            owner = -1;
+        const std::size_t sizeClass = getSizeClass(size);
+        Arena& arena = getArena(owner);
+        if (FreeBlock* block = arena.mFreeLists[sizeClass])
+        {
+            arena.mFreeLists[sizeClass] = block->mNext;
+            return block;
+        }
+        const std::size_t blockSize = (sizeClass + 1) * sGranularity;
+        if (arena.mChunkPos == nullptr || static_cast<std::size_t>(arena.mChunkEnd - arena.mChunkPos) < blockSize)
+        {
+            // The rest of the current chunk is lost, it is less than sMaxSize.
+            Chunk* chunk = static_cast<Chunk*>(allocateAligned(sChunkSize));
+            if (chunk == nullptr)
+                return nullptr;
+            chunk->mPrev = mLastChunk;
+            chunk->mOwner = owner;
+            mLastChunk = chunk;
+            ++mChunksCount;
+            arena.mChunkPos = reinterpret_cast<std::byte*>(chunk) + sGranularity;
+            arena.mChunkEnd = reinterpret_cast<std::byte*>(chunk) + sChunkSize;
+        }
+        void* result = arena.mChunkPos;
+        arena.mChunkPos += blockSize;
+        return result;
+    }
+
+    void SmallObjectPool::deallocate(void* ptr, std::size_t size)
+    {
+        const std::size_t sizeClass = getSizeClass(size);
+        Arena& arena = getArena(getOwner(ptr));
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->mNext = arena.mFreeLists[sizeClass];
+        arena.mFreeLists[sizeClass] = block;
+    }
+
+    void* SmallObjectPool::reallocate(void* ptr, std::size_t osize, std::size_t nsize, int owner)
+    {
+        if (ptr == nullptr)
+            osize = 0;
+        if (nsize == 0)
+        {
+            if (isSmall(osize))
+                deallocate(ptr, osize);
+            else
+                std::free(ptr);
+            return nullptr;
+        }
+        if (isSmall(osize) && isSmall(nsize) && getSizeClass(osize) == getSizeClass(nsize)
+            && getOwner(ptr) == std::max(owner, -1))
+            return ptr;
+        if (!isSmall(osize) && !isSmall(nsize))
+            return std::realloc(ptr, nsize);
+
+        void* result = isSmall(nsize) ? allocate(nsize, owner) : std::malloc(nsize);
+        if (result == nullptr || ptr == nullptr)
+            return result;
+        std::memcpy(result, ptr, std::min(osize, nsize));
+        if (isSmall(osize))
+            deallocate(ptr, osize);
+        else
+            std::free(ptr);
+        return result;
+    }
+
+}
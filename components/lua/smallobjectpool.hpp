@@ -0,0 +1,85 @@
+#ifndef COMPONENTS_LUA_SMALLOBJECTPOOL_H
+#define COMPONENTS_LUA_SMALLOBJECTPOOL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LuaUtil
+{
+
+    // Allocates small blocks of memory (Lua strings, tables, closures, etc.) from big chunks.
+    // Every size class has its own list of free blocks, so the most of allocations don't use malloc.
+    // Every owner (e.g. a script, -1 means no owner) gets its own chunks, so the owner of a small block can be found
+    // by its address without any additional memory per block.
+    // Chunks are returned to the system only when the pool is destroyed.
+    // Not thread safe. Never throws: returns nullptr if there is not enough memory.
+    class SmallObjectPool
+    {
+    public:
+        static constexpr std::size_t sGranularity = 16;
+        static constexpr std::size_t sMaxSize = 256;
+        static constexpr std::size_t sChunkSize = 64 * 1024;
+
+        SmallObjectPool() = default;
+        SmallObjectPool(const SmallObjectPool&) = delete;
+        ~SmallObjectPool();
+
+        static bool isSmall(std::size_t size) { return size != 0 && size <= sMaxSize; }
+
+        // `ptr` should be a small block allocated by a pool.
+        static int getOwner(const void* ptr) { return getChunk(ptr)->mOwner; }
+
+        // `size` should be small.
+        void* allocate(std::size_t size, int owner = -1);
+
+        // `size` should be the same as was used for allocation (or belong to the same size class).
+        void deallocate(void* ptr, std::size_t size);
+
+        // Has the same semantics as lua_Alloc: frees `ptr` if `nsize` is 0, allocates new block if `ptr` is nullptr.
+        // Blocks bigger than sMaxSize are allocated by malloc. New small blocks belong to `owner`.
+        void* reallocate(void* ptr, std::size_t osize, std::size_t nsize, int owner = -1);
+
+        std::size_t getChunksCount() const { return mChunksCount; }
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* mNext;
+        };
+
+        // Placed at the beginning of every chunk. Chunks are aligned by sChunkSize.
+        struct Chunk
+        {
+            Chunk* mPrev;
+            int mOwner;
+        };
+
+        struct Arena
+        {
+            std::array<FreeBlock*, sMaxSize / sGranularity> mFreeLists {};
+            std::byte* mChunkPos = nullptr;
+            std::byte* mChunkEnd = nullptr;
+        };
+
+        static_assert(sizeof(Chunk) <= sGranularity);
+        static_assert(sChunkSize % sGranularity == 0 && (sChunkSize & (sChunkSize - 1)) == 0);
+
+        static std::size_t getSizeClass(std::size_t size) { return (size - 1) / sGranularity; }
+
+        static Chunk* getChunk(const void* ptr)
+        {
+            return reinterpret_cast<Chunk*>(reinterpret_cast<std::uintptr_t>(ptr) & ~(sChunkSize - 1));
+        }
+
+        Arena& getArena(int owner);
+
+        std::vector<Arena> mArenas;  // Indexed by owner + 1
+        Chunk* mLastChunk = nullptr;
+        std::size_t mChunksCount = 0;
+    };
+
+}
+
+#endif // COMPONENTS_LUA_SMALLOBJECTPOOL_H
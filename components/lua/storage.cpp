@@ -22,9 +22,13 @@ namespace LuaUtil
         return deserialize(L, mSerializedValue);
     }
 
-    sol::object LuaStorage::Value::getReadOnly(lua_State* L) const
+    sol::object LuaStorage::Value::getReadOnly(lua_State* L, bool useCache) const
     {
-        if (mReadOnlyValue == sol::nil && !mSerializedValue.empty())
+        if (mSerializedValue.empty())
+            return sol::nil;
+        if (!useCache)
+            return deserialize(L, mSerializedValue, nullptr, true);
+        if (mReadOnlyValue == sol::nil)
             mReadOnlyValue = deserialize(L, mSerializedValue, nullptr, true);
         return mReadOnlyValue;
     }
@@ -53,11 +57,11 @@ namespace LuaUtil
         return res;
     }
 
-    sol::table LuaStorage::Section::asTable()
+    sol::table LuaStorage::Section::asTable(lua_State* L)
     {
-        sol::table res(mStorage->mLua, sol::create);
+        sol::table res(L, sol::create);
         for (const auto& [k, v] : mValues)
-            res[k] = v.getCopy(mStorage->mLua);
+            res[k] = v.getCopy(L);
         return res;
     }
 
@@ -66,26 +70,26 @@ namespace LuaUtil
         sol::state_view lua(L);
         sol::usertype<SectionReadOnlyView> roView = lua.new_usertype<SectionReadOnlyView>("ReadOnlySection");
         sol::usertype<SectionMutableView> mutableView = lua.new_usertype<SectionMutableView>("MutableSection");
-        roView["get"] = [](sol::this_state s, SectionReadOnlyView& section, std::string_view key)
+        roView["get"] = [L](sol::this_state s, SectionReadOnlyView& section, std::string_view key)
         {
-            return section.mSection->get(key).getReadOnly(s);
+            return section.mSection->get(key).getReadOnly(s, section.mSection->mStorage->mLua == L);
         };
         roView["getCopy"] = [](sol::this_state s, SectionReadOnlyView& section, std::string_view key)
         {
             return section.mSection->get(key).getCopy(s);
         };
         roView["wasChanged"] = [](SectionReadOnlyView& section) { return section.mSection->wasChanged(section.mLastCheck); };
-        roView["asTable"] = [](SectionReadOnlyView& section) { return section.mSection->asTable(); };
-        mutableView["get"] = [](sol::this_state s, SectionMutableView& section, std::string_view key)
+        roView["asTable"] = [](sol::this_state s, SectionReadOnlyView& section) { return section.mSection->asTable(s); };
+        mutableView["get"] = [L](sol::this_state s, SectionMutableView& section, std::string_view key)
         {
-            return section.mSection->get(key).getReadOnly(s);
+            return section.mSection->get(key).getReadOnly(s, section.mSection->mStorage->mLua == L);
         };
         mutableView["getCopy"] = [](sol::this_state s, SectionMutableView& section, std::string_view key)
         {
             return section.mSection->get(key).getCopy(s);
         };
         mutableView["wasChanged"] = [](SectionMutableView& section) { return section.mSection->wasChanged(section.mLastCheck); };
-        mutableView["asTable"] = [](SectionMutableView& section) { return section.mSection->asTable(); };
+        mutableView["asTable"] = [](sol::this_state s, SectionMutableView& section) { return section.mSection->asTable(s); };
         mutableView["reset"] = [](SectionMutableView& section, sol::optional<sol::table> newValues)
         {
             section.mSection->mValues.clear();
@@ -158,7 +162,7 @@ namespace LuaUtil
         for (const auto& [sectionName, section] : mData)
         {
             if (section->mPermanent)
-                data[sectionName] = section->asTable();
+                data[sectionName] = section->asTable(mLua);
         }
         std::string serializedData = serialize(data);
         Log(Debug::Info) << "Saving Lua storage \"" << path << "\" (" << serializedData.size() << " bytes)";
@@ -169,6 +173,7 @@ namespace LuaUtil
 
     const std::shared_ptr<LuaStorage::Section>& LuaStorage::getSection(std::string_view sectionName)
     {
+        const std::lock_guard<std::mutex> lock(mMutex);
         auto it = mData.find(sectionName);
         if (it != mData.end())
             return it->second;
@@ -184,6 +189,12 @@ namespace LuaUtil
         return sol::make_object<SectionReadOnlyView>(mLua, SectionReadOnlyView{section, section->mChangeCounter});
     }
 
+    sol::object LuaStorage::getReadOnlySection(lua_State* L, std::string_view sectionName)
+    {
+        const std::shared_ptr<Section>& section = getSection(sectionName);
+        return sol::make_object<SectionReadOnlyView>(L, SectionReadOnlyView{section, section->mChangeCounter});
+    }
+
     sol::object LuaStorage::getMutableSection(std::string_view sectionName)
     {
         const std::shared_ptr<Section>& section = getSection(sectionName);
@@ -2,6 +2,7 @@
 #define COMPONENTS_LUA_STORAGE_H
 
 #include <map>
+#include <mutex>
 #include <sol/sol.hpp>
 
 #include "serialization.hpp"
@@ -21,6 +22,11 @@ namespace LuaUtil
         void save(const std::string& path) const;
 
         sol::object getReadOnlySection(std::string_view sectionName);
+
+        // Creates a read-only view in another Lua state (e.g. a Lua state for local scripts). Can be used
+        // from several threads in parallel while the storage is not modified.
+        sol::object getReadOnlySection(lua_State* L, std::string_view sectionName);
+
         sol::object getMutableSection(std::string_view sectionName);
         sol::table getAllSections();
 
@@ -36,7 +42,8 @@ namespace LuaUtil
             Value() {}
             Value(const sol::object& value) : mSerializedValue(serialize(value)) {}
             sol::object getCopy(lua_State* L) const;
-            sol::object getReadOnly(lua_State* L) const;
+            // The cached value belongs to the Lua state of the storage, other states always get a new copy.
+            sol::object getReadOnly(lua_State* L, bool useCache) const;
 
         private:
             std::string mSerializedValue;
@@ -49,7 +56,7 @@ namespace LuaUtil
             const Value& get(std::string_view key) const;
             void set(std::string_view key, const sol::object& value);
             bool wasChanged(int64_t& lastCheck);
-            sol::table asTable();
+            sol::table asTable(lua_State* L);
 
             LuaStorage* mStorage;
             std::string mSectionName;
@@ -72,6 +79,7 @@ namespace LuaUtil
         const std::shared_ptr<Section>& getSection(std::string_view sectionName);
 
         lua_State* mLua;
+        std::mutex mMutex;
         std::map<std::string_view, std::shared_ptr<Section>> mData;
         std::optional<ListenerFn> mListener;
     };
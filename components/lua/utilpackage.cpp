@@ -58,7 +58,7 @@ namespace LuaUtil
         }
     }
 
-    sol::table initUtilPackage(sol::state& lua)
+    sol::table initUtilPackage(sol::state_view& lua)
     {
         sol::table util(lua, sol::create);
 
@@ -0,0 +1,273 @@
+#include "taskscheduler.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/debug/tracerecorder.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+
+namespace Misc
+{
+    namespace
+    {
+        thread_local const TaskScheduler* currentScheduler = nullptr;
+        thread_local std::size_t currentWorker = 0;
+    }
+
+    bool TaskScheduler::Task::cancel()
+    {
+        State expected = State::Pending;
+        if (!mState.compare_exchange_strong(expected, State::Cancelled))
+            return expected == State::Cancelled;
+        mScheduler.finish(*this);
+        return true;
+    }
+
+    bool TaskScheduler::Task::isDone() const
+    {
+        const std::lock_guard<std::mutex> lock(mMutex);
+        return mDone;
+    }
+
+    bool TaskScheduler::Task::isCancelled() const
+    {
+        return mState == State::Cancelled;
+    }
+
+    void TaskScheduler::Task::wait()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [&] { return mDone; });
+    }
+
+    void TaskScheduler::Task::runOrWait()
+    {
+        if (mPendingDependencies == 0)
+        {
+            State expected = State::Pending;
+            if (mState.compare_exchange_strong(expected, State::Running))
+            {
+                // the queued task is skipped by the thread which takes it
+                mScheduler.execute(*this);
+                return;
+            }
+        }
+        wait();
+    }
+
+    TaskScheduler::TaskScheduler(std::size_t threadsCount)
+    {
+        threadsCount = std::max<std::size_t>(threadsCount, 1);
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mWorkers.push_back(std::make_unique<Worker>());
+        for (std::size_t i = 0; i < threadsCount; ++i)
+            mWorkers[i]->mThread = std::thread([this, i] { run(i); });
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        stop();
+    }
+
+    void TaskScheduler::stop()
+    {
+        std::vector<TaskPtr> notStarted;
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+            for (const std::unique_ptr<Worker>& worker : mWorkers)
+            {
+                const std::lock_guard<std::mutex> workerLock(worker->mMutex);
+                for (std::deque<TaskPtr>& queue : worker->mQueues)
+                {
+                    mQueued -= queue.size();
+                    std::move(queue.begin(), queue.end(), std::back_inserter(notStarted));
+                    queue.clear();
+                }
+            }
+        }
+        mCondition.notify_all();
+        // Cancelled outside of the lock because dependents of a cancelled task are enqueued (and cancelled) too
+        for (const TaskPtr& task : notStarted)
+            task->cancel();
+        for (const std::unique_ptr<Worker>& worker : mWorkers)
+            if (worker->mThread.joinable())
+                worker->mThread.join();
+    }
+
+    std::size_t TaskScheduler::getDefaultThreadsCount()
+    {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    TaskScheduler::TaskPtr TaskScheduler::submit(std::function<void()> function, TaskPriority priority,
+        const std::vector<TaskPtr>& dependencies)
+    {
+        TaskPtr task(new Task(*this, std::move(function), priority));
+        task->mPendingDependencies = dependencies.size() + 1;
+        for (const TaskPtr& dependency : dependencies)
+        {
+            const std::lock_guard<std::mutex> lock(dependency->mMutex);
+            if (dependency->mDone)
+                --task->mPendingDependencies;
+            else
+                dependency->mDependents.push_back(task);
+        }
+        if (--task->mPendingDependencies == 0)
+            enqueue(TaskPtr(task));
+        return task;
+    }
+
+    void TaskScheduler::parallelFor(std::size_t count, const std::function<void(std::size_t)>& function,
+        TaskPriority priority)
+    {
+        std::atomic<std::size_t> next {0};
+        const auto run = [&]
+        {
+            for (std::size_t i = next++; i < count; i = next++)
+                function(i);
+        };
+        std::vector<TaskPtr> tasks;
+        const std::size_t tasksCount = std::min(count, mWorkers.size() + 1);
+        for (std::size_t i = 1; i < tasksCount; ++i)
+            tasks.push_back(submit(run, priority));
+        const auto waitTasks = [&]
+        {
+            // A task not taken by a thread yet has nothing left to do when the calling thread is done.
+            for (const TaskPtr& task : tasks)
+                if (!task->cancel())
+                    task->wait();
+        };
+        try
+        {
+            run();
+        }
+        catch (...)
+        {
+            next = count;
+            waitTasks();
+            throw;
+        }
+        waitTasks();
+    }
+
+    void TaskScheduler::enqueue(TaskPtr&& task)
+    {
+        // Tasks submitted from a worker thread go to its own queue, others are distributed evenly.
+        const std::size_t workerIndex = currentScheduler == this
+            ? currentWorker
+            : mNextWorker.fetch_add(1) % mWorkers.size();
+        {
+            const std::lock_guard<std::mutex> lock(mMutex);
+            if (!mStop)
+            {
+                {
+                    Worker& worker = *mWorkers[workerIndex];
+                    const std::lock_guard<std::mutex> workerLock(worker.mMutex);
+                    worker.mQueues[static_cast<std::size_t>(task->mPriority)].push_back(std::move(task));
+                }
+                ++mQueued;
+            }
+        }
+        if (task == nullptr)
+            mCondition.notify_one();
+        else
+            task->cancel();  // the scheduler is being destroyed
+    }
+
+    TaskScheduler::TaskPtr TaskScheduler::pop(std::size_t workerIndex)
+    {
+        for (std::size_t priority = 0; priority < sPrioritiesCount; ++priority)
+        {
+            {
+                Worker& worker = *mWorkers[workerIndex];
+                const std::lock_guard<std::mutex> lock(worker.mMutex);
+                std::deque<TaskPtr>& queue = worker.mQueues[priority];
+                if (!queue.empty())
+                {
+                    TaskPtr task = std::move(queue.front());
+                    queue.pop_front();
+                    --mQueued;
+                    return task;
+                }
+            }
+            for (std::size_t i = 1; i < mWorkers.size(); ++i)
+            {
+                Worker& victim = *mWorkers[(workerIndex + i) % mWorkers.size()];
+                const std::lock_guard<std::mutex> lock(victim.mMutex);
+                std::deque<TaskPtr>& queue = victim.mQueues[priority];
+                if (!queue.empty())
+                {
+                    TaskPtr task = std::move(queue.back());
+                    queue.pop_back();
+                    --mQueued;
+                    return task;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    void TaskScheduler::run(std::size_t workerIndex)
+    {
+        currentScheduler = this;
+        currentWorker = workerIndex;
+        Debug::TraceRecorder::instance().setThreadName("TaskScheduler " + std::to_string(workerIndex));
+        while (true)
+        {
+            if (mStop)
+                break;
+            TaskPtr task = pop(workerIndex);
+            if (task == nullptr)
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [&] { return mStop || mQueued > 0; });
+                continue;
+            }
+            if (mStop)
+            {
+                // taken by the thread before stop has drained the queues
+                task->cancel();
+                break;
+            }
+            Task::State expected = Task::State::Pending;
+            if (!task->mState.compare_exchange_strong(expected, Task::State::Running))
+                continue;  // cancelled or run by runOrWait
+            execute(*task);
+        }
+    }
+
+    void TaskScheduler::execute(Task& task)
+    {
+        ++mActive;
+        try
+        {
+            const Debug::TraceZone zone("TaskScheduler", "Task");
+            task.mFunction();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Task has failed: " << e.what();
+        }
+        task.mFunction = nullptr;
+        --mActive;
+        task.mState = Task::State::Finished;
+        finish(task);
+    }
+
+    void TaskScheduler::finish(Task& task)
+    {
+        std::vector<TaskPtr> dependents;
+        {
+            const std::lock_guard<std::mutex> lock(task.mMutex);
+            task.mDone = true;
+            dependents = std::move(task.mDependents);
+        }
+        task.mCondition.notify_all();
+        for (TaskPtr& dependent : dependents)
+            if (--dependent->mPendingDependencies == 0)
+                enqueue(std::move(dependent));
+    }
+}
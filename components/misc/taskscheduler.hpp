@@ -0,0 +1,133 @@
+#ifndef OPENMW_COMPONENTS_MISC_TASKSCHEDULER_H
+#define OPENMW_COMPONENTS_MISC_TASKSCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    enum class TaskPriority
+    {
+        High = 0,
+        Normal = 1,
+        Low = 2,
+    };
+
+    /// @brief Thread pool shared between subsystems.
+    /// Every thread has its own queue per priority; an idle thread takes tasks from queues of other threads.
+    /// A ready task with higher priority is always taken before tasks with lower priority.
+    /// With a single thread tasks of the same priority start in the order of submission.
+    class TaskScheduler
+    {
+    public:
+        class Task
+        {
+        public:
+            /// Prevents the task from running if it is not started yet. Returns true if the task won't run.
+            /// Cancelled task is considered finished for tasks depending on it.
+            bool cancel();
+
+            /// The task is finished or cancelled.
+            bool isDone() const;
+
+            bool isCancelled() const;
+
+            void wait();
+
+            /// Runs the task in the calling thread if it is ready to start but not taken by a scheduler thread yet,
+            /// otherwise waits for it. The caller doesn't depend on scheduler threads busy with other tasks.
+            void runOrWait();
+
+        private:
+            friend class TaskScheduler;
+
+            enum class State
+            {
+                Pending,
+                Running,
+                Finished,
+                Cancelled,
+            };
+
+            Task(TaskScheduler& scheduler, std::function<void()>&& function, TaskPriority priority)
+                : mScheduler(scheduler), mFunction(std::move(function)), mPriority(priority) {}
+
+            TaskScheduler& mScheduler;
+            std::function<void()> mFunction;
+            const TaskPriority mPriority;
+            std::atomic<State> mState {State::Pending};
+            std::atomic<std::size_t> mPendingDependencies {1};
+            mutable std::mutex mMutex;
+            std::condition_variable mCondition;
+            bool mDone = false;
+            std::vector<std::shared_ptr<Task>> mDependents;
+        };
+
+        using TaskPtr = std::shared_ptr<Task>;
+
+        explicit TaskScheduler(std::size_t threadsCount);
+
+        /// Calls stop.
+        ~TaskScheduler();
+
+        /// Cancels all tasks that are not started yet (including queued ones), waits for running tasks and joins
+        /// the threads.
+        /// Tasks submitted later are cancelled. Should be called by the owner before destroying objects used by
+        /// the tasks, since the last reference to the scheduler may be released from its own task.
+        void stop();
+
+        /// Number of threads that uses all hardware threads except one for the main thread.
+        static std::size_t getDefaultThreadsCount();
+
+        /// @param dependencies the task starts when all of them are finished or cancelled.
+        TaskPtr submit(std::function<void()> function, TaskPriority priority = TaskPriority::Normal,
+            const std::vector<TaskPtr>& dependencies = {});
+
+        /// Calls function for every index in [0, count) using the scheduler threads and the calling thread.
+        /// Returns when all calls are finished. The calling thread takes indices itself, so it is safe to
+        /// call from a task of the same scheduler.
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& function,
+            TaskPriority priority = TaskPriority::Normal);
+
+        std::size_t getThreadsCount() const { return mWorkers.size(); }
+
+        /// Tasks ready to start but not taken by a thread yet.
+        std::size_t getQueuedTasksCount() const { return mQueued; }
+
+        std::size_t getActiveThreadsCount() const { return mActive; }
+
+    private:
+        static constexpr std::size_t sPrioritiesCount = 3;
+
+        struct Worker
+        {
+            std::mutex mMutex;
+            std::array<std::deque<TaskPtr>, sPrioritiesCount> mQueues;
+            std::thread mThread;
+        };
+
+        void enqueue(TaskPtr&& task);
+        TaskPtr pop(std::size_t workerIndex);
+        void run(std::size_t workerIndex);
+        void execute(Task& task);
+        void finish(Task& task);
+
+        std::vector<std::unique_ptr<Worker>> mWorkers;
+        std::mutex mMutex;
+        std::condition_variable mCondition;
+        std::atomic<bool> mStop {false};  // changed only under mMutex
+        std::atomic<std::size_t> mQueued {0};
+        std::atomic<std::size_t> mActive {0};
+        std::atomic<std::size_t> mNextWorker {0};
+    };
+}
+
+#endif
@@ -5,8 +5,12 @@
 
 #include "nifstream.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
 #include <sstream>
-#include <map>
+#include <type_traits>
+#include <vector>
 
 #include "niffile.hpp"
 
@@ -23,33 +27,28 @@ enum InterpolationType
     InterpolationType_Constant = 5
 };
 
-template<typename T>
-struct KeyT {
-    T mValue;
-    T mInTan; // Only for Quadratic interpolation, and never for QuaternionKeyList
-    T mOutTan; // Only for Quadratic interpolation, and never for QuaternionKeyList
-
-    // FIXME: Implement TBC interpolation
-    /*
-    float mTension;    // Only for TBC interpolation
-    float mBias;       // Only for TBC interpolation
-    float mContinuity; // Only for TBC interpolation
-    */
-};
-using FloatKey = KeyT<float>;
-using Vector3Key = KeyT<osg::Vec3f>;
-using Vector4Key = KeyT<osg::Vec4f>;
-using QuaternionKey = KeyT<osg::Quat>;
-
 template<typename T, T (NIFStream::*getValue)()>
 struct KeyMapT {
-    using MapType = std::map<float, KeyT<T>>;
-
     using ValueType = T;
-    using KeyType = KeyT<T>;
 
     unsigned int mInterpolationType = InterpolationType_Unknown;
-    MapType mKeys;
+
+    // Keys are stored as a structure of arrays sorted by time with unique times,
+    // so lookups during playback walk contiguous memory.
+    std::vector<float> mTimes;
+    std::vector<T> mValues;
+    std::vector<T> mInTans; // Only for Quadratic interpolation, and never for QuaternionKeyList
+    std::vector<T> mOutTans; // Only for Quadratic interpolation, and never for QuaternionKeyList
+
+    // FIXME: Implement TBC interpolation
+    /*
+    std::vector<float> mTension;    // Only for TBC interpolation
+    std::vector<float> mBias;       // Only for TBC interpolation
+    std::vector<float> mContinuity; // Only for TBC interpolation
+    */
+
+    std::size_t size() const { return mTimes.size(); }
+    bool empty() const { return mTimes.empty(); }
 
     //Read in a KeyGroup (see http://niftools.sourceforge.net/doc/nif/NiKeyframeData.html)
     void read(NIFStream *nif, bool morph = false)
@@ -64,33 +63,31 @@ struct KeyMapT {
         if (count != 0 || morph)
             mInterpolationType = nif->getUInt();
 
-        KeyType key = {};
-
         if (mInterpolationType == InterpolationType_Linear || mInterpolationType == InterpolationType_Constant)
         {
+            reserve(count);
             for (size_t i = 0;i < count;i++)
             {
-                float time = nif->getFloat();
-                readValue(*nif, key);
-                mKeys[time] = key;
+                mTimes.push_back(nif->getFloat());
+                readValue(*nif);
             }
         }
         else if (mInterpolationType == InterpolationType_Quadratic)
         {
+            reserve(count, !std::is_same_v<T, osg::Quat>);
             for (size_t i = 0;i < count;i++)
             {
-                float time = nif->getFloat();
-                readQuadratic(*nif, key);
-                mKeys[time] = key;
+                mTimes.push_back(nif->getFloat());
+                readQuadratic(*nif);
             }
         }
         else if (mInterpolationType == InterpolationType_TBC)
         {
+            reserve(count);
             for (size_t i = 0;i < count;i++)
             {
-                float time = nif->getFloat();
-                readTBC(*nif, key);
-                mKeys[time] = key;
+                mTimes.push_back(nif->getFloat());
+                readTBC(*nif);
             }
         }
         else if (mInterpolationType == InterpolationType_XYZ)
@@ -108,6 +105,8 @@ struct KeyMapT {
             nif->file->fail(error.str());
         }
 
+        sortKeys();
+
         if (morph && nif->getVersion() > NIFStream::generateVersion(10,1,0,0))
         {
             if (nif->getVersion() >= NIFStream::generateVersion(10,1,0,104) &&
@@ -116,31 +115,75 @@ struct KeyMapT {
         }
     }
 
+    // Called by read, keys filled in other way have to be sorted explicitly. Files almost always have keys in order.
+    // Otherwise sort them, and when several keys have the same time the last one wins.
+    void sortKeys()
+    {
+        if (std::adjacent_find(mTimes.begin(), mTimes.end(), std::greater_equal<float>()) == mTimes.end())
+            return;
+
+        std::vector<size_t> order(mTimes.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&] (size_t a, size_t b) { return mTimes[a] < mTimes[b]; });
+
+        std::vector<size_t> unique;
+        unique.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            if (i + 1 == order.size() || mTimes[order[i]] < mTimes[order[i + 1]])
+                unique.push_back(order[i]);
+
+        mTimes = permute(mTimes, unique);
+        mValues = permute(mValues, unique);
+        if (!mInTans.empty())
+        {
+            mInTans = permute(mInTans, unique);
+            mOutTans = permute(mOutTans, unique);
+        }
+    }
+
 private:
-    static void readValue(NIFStream &nif, KeyT<T> &key)
+    void reserve(size_t count, bool tangents = false)
     {
-        key.mValue = (nif.*getValue)();
+        mTimes.reserve(count);
+        mValues.reserve(count);
+        if (tangents)
+        {
+            mInTans.reserve(count);
+            mOutTans.reserve(count);
+        }
+    }
+
+    void readValue(NIFStream &nif)
+    {
+        mValues.push_back((nif.*getValue)());
     }
 
-    template <typename U>
-    static void readQuadratic(NIFStream &nif, KeyT<U> &key)
+    void readQuadratic(NIFStream &nif)
     {
-        readValue(nif, key);
-        key.mInTan = (nif.*getValue)();
-        key.mOutTan = (nif.*getValue)();
+        readValue(nif);
+        if constexpr (!std::is_same_v<T, osg::Quat>)
+        {
+            mInTans.push_back((nif.*getValue)());
+            mOutTans.push_back((nif.*getValue)());
+        }
     }
 
-    static void readQuadratic(NIFStream &nif, KeyT<osg::Quat> &key)
+    void readTBC(NIFStream &nif)
     {
-        readValue(nif, key);
+        readValue(nif);
+        /*mTension = */nif.getFloat();
+        /*mBias = */nif.getFloat();
+        /*mContinuity = */nif.getFloat();
     }
 
-    static void readTBC(NIFStream &nif, KeyT<T> &key)
+    template <class U>
+    static std::vector<U> permute(const std::vector<U>& values, const std::vector<size_t>& order)
     {
-        readValue(nif, key);
-        /*key.mTension = */nif.getFloat();
-        /*key.mBias = */nif.getFloat();
-        /*key.mContinuity = */nif.getFloat();
+        std::vector<U> result;
+        result.reserve(order.size());
+        for (size_t index : order)
+            result.push_back(values[index]);
+        return result;
     }
 };
 using FloatKeyMap = KeyMapT<float,&NIFStream::getFloat>;
@@ -10,8 +10,10 @@
 #include <components/sceneutil/nodecallback.hpp>
 #include <components/sceneutil/statesetupdater.hpp>
 
+#include <algorithm>
 #include <set>
 #include <type_traits>
+#include <vector>
 
 #include <osg/Texture2D>
 
@@ -40,23 +42,23 @@ namespace NifOsg
     template <typename MapT>
     class ValueInterpolator
     {
-        typename MapT::MapType::const_iterator retrieveKey(float time) const
+        // Returns the index of the first key with time not less than `time`.
+        // `time` should be strictly between the first and the last key times.
+        std::size_t retrieveKey(float time) const
         {
-            // retrieve the current position in the map, optimized for the most common case
+            // retrieve the current position in the track, optimized for the most common case
             // where time moves linearly along the keyframe track
-            if (mLastHighKey != mKeys->mKeys.end())
+            const std::vector<float>& times = mKeys->mTimes;
+            std::size_t index = mLastHighKey;
+            if (index != 0)
             {
-                if (time > mLastHighKey->first)
-                {
-                    // try if we're there by incrementing one
-                    ++mLastLowKey;
-                    ++mLastHighKey;
-                }
-                if (mLastHighKey != mKeys->mKeys.end() && time >= mLastLowKey->first && time <= mLastHighKey->first)
-                    return mLastHighKey;
+                if (time > times[index] && index + 1 < times.size())
+                    ++index; // try if we're there by incrementing one
+                if (times[index - 1] < time && time <= times[index])
+                    return index;
             }
 
-            return mKeys->mKeys.lower_bound(time);
+            return std::lower_bound(times.begin(), times.end(), time) - times.begin();
         }
 
     public:
@@ -84,22 +86,12 @@ namespace NifOsg
             if (interpolator->data.empty())
                 return;
             mKeys = interpolator->data->mKeyList;
-            if (mKeys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueInterpolator(std::shared_ptr<const MapT> keys, ValueT defaultVal = ValueT())
             : mKeys(keys)
             , mDefaultVal(defaultVal)
         {
-            if (keys)
-            {
-                mLastLowKey = mKeys->mKeys.end();
-                mLastHighKey = mKeys->mKeys.end();
-            }
         }
 
         ValueT interpKey(float time) const
@@ -107,81 +99,74 @@ namespace NifOsg
             if (empty())
                 return mDefaultVal;
 
-            const typename MapT::MapType & keys = mKeys->mKeys;
+            const std::vector<float>& times = mKeys->mTimes;
 
-            if(time <= keys.begin()->first)
-                return keys.begin()->second.mValue;
+            if (time <= times.front())
+                return mKeys->mValues.front();
 
-            typename MapT::MapType::const_iterator it = retrieveKey(time);
-
-            // now do the actual interpolation
-            if (it != keys.end())
-            {
-                // cache for next time
-                mLastHighKey = it;
-                mLastLowKey = --it;
+            if (time >= times.back())
+                return mKeys->mValues.back();
 
-                float a = (time - mLastLowKey->first) / (mLastHighKey->first - mLastLowKey->first);
+            // cache for next time
+            mLastHighKey = retrieveKey(time);
 
-                return interpolate(mLastLowKey->second, mLastHighKey->second, a, mKeys->mInterpolationType);
-            }
+            const std::size_t low = mLastHighKey - 1;
+            float a = (time - times[low]) / (times[mLastHighKey] - times[low]);
 
-            return keys.rbegin()->second.mValue;
+            return interpolate(low, mLastHighKey, a, mKeys->mInterpolationType);
         }
 
         bool empty() const
         {
-            return !mKeys || mKeys->mKeys.empty();
+            return !mKeys || mKeys->empty();
         }
 
     private:
-        template <typename ValueType>
-        ValueType interpolate(const Nif::KeyT<ValueType>& a, const Nif::KeyT<ValueType>& b, float fraction, unsigned int type) const
+        ValueT interpolate(std::size_t a, std::size_t b, float fraction, unsigned int type) const
         {
+            const std::vector<ValueT>& values = mKeys->mValues;
             switch (type)
             {
                 case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
+                    return fraction > 0.5f ? values[b] : values[a];
                 case Nif::InterpolationType_Quadratic:
                 {
-                    // Using a cubic Hermite spline.
-                    // b1(t) = 2t^3  - 3t^2 + 1
-                    // b2(t) = -2t^3 + 3t^2
-                    // b3(t) = t^3 - 2t^2 + t
-                    // b4(t) = t^3 - t^2
-                    // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
-                    const float t = fraction;
-                    const float t2 = t * t;
-                    const float t3 = t2 * t;
-                    const float b1 = 2.f * t3 - 3.f * t2 + 1;
-                    const float b2 = -2.f * t3 + 3.f * t2;
-                    const float b3 = t3 - 2.f * t2 + t;
-                    const float b4 = t3 - t2;
-                    return a.mValue * b1 + b.mValue * b2 + a.mOutTan * b3 + b.mInTan * b4;
+                    if constexpr (std::is_same_v<ValueT, osg::Quat>)
+                        break; // TODO: Implement Quadratic interpolation for quaternions
+                    else
+                    {
+                        // Using a cubic Hermite spline.
+                        // b1(t) = 2t^3  - 3t^2 + 1
+                        // b2(t) = -2t^3 + 3t^2
+                        // b3(t) = t^3 - 2t^2 + t
+                        // b4(t) = t^3 - t^2
+                        // f(t) = a.mValue * b1(t) + b.mValue * b2(t) + a.mOutTan * b3(t) + b.mInTan * b4(t)
+                        const float t = fraction;
+                        const float t2 = t * t;
+                        const float t3 = t2 * t;
+                        const float b1 = 2.f * t3 - 3.f * t2 + 1;
+                        const float b2 = -2.f * t3 + 3.f * t2;
+                        const float b3 = t3 - 2.f * t2 + t;
+                        const float b4 = t3 - t2;
+                        return values[a] * b1 + values[b] * b2 + mKeys->mOutTans[a] * b3 + mKeys->mInTans[b] * b4;
+                    }
                 }
                 // TODO: Implement TBC interpolation
                 default:
-                    return a.mValue + ((b.mValue - a.mValue) * fraction);
+                    break;
             }
-        }
-        osg::Quat interpolate(const Nif::KeyT<osg::Quat>& a, const Nif::KeyT<osg::Quat>& b, float fraction, unsigned int type) const
-        {
-            switch (type)
+            if constexpr (std::is_same_v<ValueT, osg::Quat>)
             {
-                case Nif::InterpolationType_Constant:
-                    return fraction > 0.5f ? b.mValue : a.mValue;
-                // TODO: Implement Quadratic and TBC interpolation
-                default:
-                {
-                    osg::Quat result;
-                    result.slerp(fraction, a.mValue, b.mValue);
-                    return result;
-                }
+                osg::Quat result;
+                result.slerp(fraction, values[a], values[b]);
+                return result;
             }
+            else
+                return values[a] + ((values[b] - values[a]) * fraction);
         }
 
-        mutable typename MapT::MapType::const_iterator mLastLowKey;
-        mutable typename MapT::MapType::const_iterator mLastHighKey;
+        // Index of the upper key used by the last lookup, 0 if there was none.
+        mutable std::size_t mLastHighKey = 0;
 
         std::shared_ptr<const MapT> mKeys;
 
@@ -40,7 +40,7 @@ namespace Queries
         }
     };
 
-    void registerQueryBindings(sol::state& lua)
+    void registerQueryBindings(sol::state_view& lua)
     {
         sol::usertype<Field> field = lua.new_usertype<Field>("QueryField");
         sol::usertype<Filter> filter = lua.new_usertype<Filter>("QueryFilter");
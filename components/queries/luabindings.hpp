@@ -5,5 +5,5 @@
 
 namespace Queries
 {
-    void registerQueryBindings(sol::state& lua);
+    void registerQueryBindings(sol::state_view& lua);
 }
@@ -383,7 +383,11 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Keyframe",
             "",
             "Groundcover Chunk",
+            "Groundcover Cell",
             "Object Chunk",
+            "Object Chunk Flatten",
+            "Object Chunk Nodes",
+            "Object Chunk Merge",
             "Terrain Chunk",
             "Terrain Texture",
             "Land",
@@ -396,9 +400,12 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "NavMesh DbJobs",
             "NavMesh DbCacheHitRate",
             "NavMesh CacheSize",
+            "NavMesh CacheRawSize",
             "NavMesh UsedTiles",
             "NavMesh CachedTiles",
             "NavMesh CacheHitRate",
+            "NavMesh PathQueries",
+            "NavMesh PathProcessing",
             "",
             "Mechanics Actors",
             "Mechanics Objects",
@@ -407,6 +414,26 @@ void StatsHandler::setUpScene(osgViewer::ViewerBase *viewer)
             "Physics Objects",
             "Physics Projectiles",
             "Physics HeightFields",
+            "",
+            "Cell Transition",
+            "Cell Unload",
+            "Cell Terrain",
+            "Cell References",
+            "Cell Rendering",
+            "Cell Physics",
+            "Cell Navigator",
+            "Cell NavMesh Wait",
+            "Cell Read KiB",
+            "Preload Hits",
+            "Preload Misses",
+            "Preload Aborts",
+            "",
+            "Script Local",
+            "Script Deferred",
+            "Script Slowest",
+            "",
+            "Lua Memory",
+            "Lua Slowest",
         });
 
         static const auto longest = std::max_element(statNames.begin(), statNames.end(),
@@ -42,6 +42,7 @@
 
 #include <iterator>
 
+#include <components/misc/taskscheduler.hpp>
 #include <components/sceneutil/depth.hpp>
 
 using namespace osgUtil;
@@ -65,10 +66,15 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         stats.print(osg::notify(osg::NOTICE));
     }
 
+    _passTimes.clear();
+    osg::Timer* timer = osg::Timer::instance();
+
     if (options & FLATTEN_STATIC_TRANSFORMS)
     {
         OSG_INFO<<"Optimizer::optimize() doing FLATTEN_STATIC_TRANSFORMS"<<std::endl;
 
+        osg::Timer_t startTick = timer->tick();
+
         int i=0;
         bool result = false;
         do
@@ -84,19 +90,27 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
         CombineStaticTransformsVisitor cstv(this);
         node->accept(cstv);
         cstv.removeTransforms(node);
+
+        _passTimes[FLATTEN_STATIC_TRANSFORMS] = timer->delta_s(startTick, timer->tick());
     }
 
     if (options & SHARE_DUPLICATE_STATE && _sharedStateManager)
     {
+        osg::Timer_t startTick = timer->tick();
+
         if (_sharedStateMutex) _sharedStateMutex->lock();
         _sharedStateManager->share(node);
         if (_sharedStateMutex) _sharedStateMutex->unlock();
+
+        _passTimes[SHARE_DUPLICATE_STATE] = timer->delta_s(startTick, timer->tick());
     }
 
     if (options & REMOVE_REDUNDANT_NODES)
     {
         OSG_INFO<<"Optimizer::optimize() doing REMOVE_REDUNDANT_NODES"<<std::endl;
 
+        osg::Timer_t startTick = timer->tick();
+
         RemoveEmptyNodesVisitor renv(this);
         node->accept(renv);
         renv.removeEmptyNodes();
@@ -107,23 +121,28 @@ void Optimizer::optimize(osg::Node* node, unsigned int options)
 
         MergeGroupsVisitor mgrp(this);
         node->accept(mgrp);
+
+        _passTimes[REMOVE_REDUNDANT_NODES] = timer->delta_s(startTick, timer->tick());
     }
 
     if (options & MERGE_GEOMETRY)
     {
         OSG_INFO<<"Optimizer::optimize() doing MERGE_GEOMETRY"<<std::endl;
 
-        osg::Timer_t startTick = osg::Timer::instance()->tick();
+        osg::Timer_t startTick = timer->tick();
 
         MergeGeometryVisitor mgv(this);
         mgv.setTargetMaximumNumberOfVertices(1000000);
         mgv.setMergeAlphaBlending(_mergeAlphaBlending);
         mgv.setViewPoint(_viewPoint);
+        mgv.setTaskScheduler(_taskScheduler);
         node->accept(mgv);
 
-        osg::Timer_t endTick = osg::Timer::instance()->tick();
+        osg::Timer_t endTick = timer->tick();
+
+        _passTimes[MERGE_GEOMETRY] = timer->delta_s(startTick, endTick);
 
-        OSG_INFO<<"MERGE_GEOMETRY took "<<osg::Timer::instance()->delta_s(startTick,endTick)<<std::endl;
+        OSG_INFO<<"MERGE_GEOMETRY took "<<timer->delta_s(startTick,endTick)<<std::endl;
     }
 
     if (options & VERTEX_POSTTRANSFORM)
@@ -1355,30 +1374,41 @@ bool Optimizer::MergeGeometryVisitor::mergeGroup(osg::Group& group)
                 group.addChild(*itr);
             }
 
-            // now do the merging of geometries
+            // now do the merging of geometries, the lists don't share geometries so they can be merged in parallel.
+            // The merged geometries are added to the group afterwards to keep the group untouched by other threads.
+            const auto mergeDuplicateList = [&] (std::size_t index)
+            {
+                DuplicateList& duplicateList = mergeList[index];
+                if (duplicateList.empty())
+                    return;
+                if (_alphaBlendingActive)
+                {
+                    LessGeometryViewPoint lgvp;
+                    lgvp._viewPoint = _viewPoint;
+                    std::sort(duplicateList.begin(), duplicateList.end(), lgvp);
+                }
+                DuplicateList::iterator ditr = duplicateList.begin();
+                osg::Geometry& lhs = **ditr++;
+                for(;
+                    ditr != duplicateList.end();
+                    ++ditr)
+                {
+                    mergeGeometry(lhs, **ditr);
+                }
+            };
+
+            if (_taskScheduler && mergeList.size() > 1)
+                _taskScheduler->parallelFor(mergeList.size(), mergeDuplicateList);
+            else
+                for (std::size_t i = 0; i < mergeList.size(); ++i)
+                    mergeDuplicateList(i);
+
             for(MergeList::iterator mitr = mergeList.begin();
                 mitr != mergeList.end();
                 ++mitr)
             {
-                DuplicateList& duplicateList = *mitr;
-                if (!duplicateList.empty())
-                {
-                    if (_alphaBlendingActive)
-                    {
-                        LessGeometryViewPoint lgvp;
-                        lgvp._viewPoint = _viewPoint;
-                        std::sort(duplicateList.begin(), duplicateList.end(), lgvp);
-                    }
-                    DuplicateList::iterator ditr = duplicateList.begin();
-                    osg::ref_ptr<osg::Geometry> lhs = *ditr++;
-                    group.addChild(lhs.get());
-                    for(;
-                        ditr != duplicateList.end();
-                        ++ditr)
-                    {
-                        mergeGeometry(*lhs, **ditr);
-                    }
-                }
+                if (!mitr->empty())
+                    group.addChild(mitr->front().get());
             }
         }
 
@@ -24,6 +24,7 @@
 
 //#include <osgUtil/Export>
 
+#include <map>
 #include <set>
 #include <mutex>
 
@@ -32,6 +33,11 @@ namespace osgDB
     class SharedStateManager;
 }
 
+namespace Misc
+{
+    class TaskScheduler;
+}
+
 //namespace osgUtil {
 namespace SceneUtil {
 
@@ -71,7 +77,7 @@ class Optimizer
 
     public:
 
-        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr) {}
+        Optimizer() : _mergeAlphaBlending(false), _sharedStateManager(nullptr), _sharedStateMutex(nullptr), _taskScheduler(nullptr) {}
         virtual ~Optimizer() {}
 
         enum OptimizationOptions
@@ -129,6 +135,14 @@ class Optimizer
 
         void setSharedStateManager(osgDB::SharedStateManager* sharedStateManager, std::mutex* sharedStateMutex) { _sharedStateMutex = sharedStateMutex; _sharedStateManager = sharedStateManager; }
 
+        /** Independent parts of the passes (e.g. merging of separate geometry lists) run on this scheduler when set.*/
+        void setTaskScheduler(Misc::TaskScheduler* taskScheduler) { _taskScheduler = taskScheduler; }
+
+        typedef std::map<unsigned int, double> PassTimes;
+
+        /** Time in seconds spent by every pass in the last call of optimize(), keyed by OptimizationOptions.*/
+        const PassTimes& getPassTimes() const { return _passTimes; }
+
         /** Reset internal data to initial state - the getPermissibleOptionsMap is cleared.*/
         void reset();
 
@@ -269,6 +283,9 @@ class Optimizer
         osgDB::SharedStateManager* _sharedStateManager;
         mutable std::mutex* _sharedStateMutex;
 
+        Misc::TaskScheduler* _taskScheduler;
+        PassTimes _passTimes;
+
     public:
 
         /** Flatten Static Transform nodes by applying their transform to the
@@ -394,7 +411,8 @@ class Optimizer
                 /// default to traversing all children.
                 MergeGeometryVisitor(Optimizer* optimizer=0) :
                     BaseOptimizerVisitor(optimizer, MERGE_GEOMETRY),
-                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false) {}
+                    _targetMaximumNumberOfVertices(10000), _alphaBlendingActive(false), _mergeAlphaBlending(false),
+                    _taskScheduler(nullptr) {}
 
                 void setMergeAlphaBlending(bool merge)
                 {
@@ -404,6 +422,10 @@ class Optimizer
                 {
                     _viewPoint = viewPoint;
                 }
+                void setTaskScheduler(Misc::TaskScheduler* taskScheduler)
+                {
+                    _taskScheduler = taskScheduler;
+                }
 
                 void setTargetMaximumNumberOfVertices(unsigned int num)
                 {
@@ -439,6 +461,7 @@ class Optimizer
                 bool _alphaBlendingActive;
                 bool _mergeAlphaBlending;
                 osg::Vec3f _viewPoint;
+                Misc::TaskScheduler* _taskScheduler;
         };
 
 };
@@ -6,31 +6,57 @@
 #include <components/resource/scenemanager.hpp>
 #include <osg/MatrixTransform>
 
+#include <map>
+
 #include "skeleton.hpp"
 #include "util.hpp"
 
 namespace
 {
-    inline void accumulateMatrix(const osg::Matrixf& invBindMatrix, const osg::Matrixf& matrix, const float weight, osg::Matrixf& result)
+    Misc::TaskScheduler* sTaskScheduler = nullptr;
+
+    // Skinning matrices keep the rows of the 3x3 part followed by the translation, the same order as osg::Matrixf
+    // without the projective column. Loops over the contiguous floats are vectorized by the compiler.
+    inline std::array<float, 12> toSkinningMatrix(const osg::Matrixf& matrix)
+    {
+        const float* ptr = matrix.ptr();
+        return {
+            ptr[0], ptr[1], ptr[2],
+            ptr[4], ptr[5], ptr[6],
+            ptr[8], ptr[9], ptr[10],
+            ptr[12], ptr[13], ptr[14],
+        };
+    }
+
+    inline void accumulateMatrix(const std::array<float, 12>& matrix, const float weight, std::array<float, 12>& result)
     {
-        osg::Matrixf m = invBindMatrix * matrix;
-        float* ptr = m.ptr();
-        float* ptrresult = result.ptr();
-        ptrresult[0] += ptr[0] * weight;
-        ptrresult[1] += ptr[1] * weight;
-        ptrresult[2] += ptr[2] * weight;
-
-        ptrresult[4] += ptr[4] * weight;
-        ptrresult[5] += ptr[5] * weight;
-        ptrresult[6] += ptr[6] * weight;
-
-        ptrresult[8] += ptr[8] * weight;
-        ptrresult[9] += ptr[9] * weight;
-        ptrresult[10] += ptr[10] * weight;
-
-        ptrresult[12] += ptr[12] * weight;
-        ptrresult[13] += ptr[13] * weight;
-        ptrresult[14] += ptr[14] * weight;
+        for (std::size_t i = 0; i < 12; ++i)
+            result[i] += matrix[i] * weight;
+    }
+
+    // Same as a * b for osg::Matrixf with affine transforms.
+    inline std::array<float, 12> multiply(const std::array<float, 12>& a, const std::array<float, 12>& b)
+    {
+        std::array<float, 12> result;
+        for (std::size_t row = 0; row < 4; ++row)
+            for (std::size_t column = 0; column < 3; ++column)
+                result[row * 3 + column] = a[row * 3] * b[column] + a[row * 3 + 1] * b[3 + column]
+                    + a[row * 3 + 2] * b[6 + column] + (row == 3 ? b[9 + column] : 0.f);
+        return result;
+    }
+
+    inline osg::Vec3f transformPoint(const osg::Vec3f& v, const std::array<float, 12>& m)
+    {
+        return osg::Vec3f(v.x() * m[0] + v.y() * m[3] + v.z() * m[6] + m[9],
+                          v.x() * m[1] + v.y() * m[4] + v.z() * m[7] + m[10],
+                          v.x() * m[2] + v.y() * m[5] + v.z() * m[8] + m[11]);
+    }
+
+    inline osg::Vec3f transformVector(const osg::Vec3f& v, const std::array<float, 12>& m)
+    {
+        return osg::Vec3f(v.x() * m[0] + v.y() * m[3] + v.z() * m[6],
+                          v.x() * m[1] + v.y() * m[4] + v.z() * m[7],
+                          v.x() * m[2] + v.y() * m[5] + v.z() * m[8]);
     }
 }
 
@@ -39,6 +65,8 @@ namespace SceneUtil
 
 RigGeometry::RigGeometry()
     : mSkeleton(nullptr)
+    , mHasGeomToSkel(false)
+    , mTaskScheduler(sTaskScheduler)
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
 {
@@ -50,8 +78,9 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     : Drawable(copy, copyop)
     , mSkeleton(nullptr)
     , mInfluenceMap(copy.mInfluenceMap)
-    , mBone2VertexVector(copy.mBone2VertexVector)
-    , mBoneSphereVector(copy.mBoneSphereVector)
+    , mSkinningData(copy.mSkinningData)
+    , mHasGeomToSkel(false)
+    , mTaskScheduler(sTaskScheduler)
     , mLastFrameNumber(0)
     , mBoundsFirstFrame(true)
 {
@@ -59,6 +88,24 @@ RigGeometry::RigGeometry(const RigGeometry &copy, const osg::CopyOp &copyop)
     setNumChildrenRequiringUpdateTraversal(1);
 }
 
+RigGeometry::~RigGeometry()
+{
+    // the skinning task refers to this object
+    waitForSkinning();
+}
+
+void RigGeometry::setTaskScheduler(Misc::TaskScheduler* scheduler)
+{
+    sTaskScheduler = scheduler;
+}
+
+void RigGeometry::SkinningDrawCallback::drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const
+{
+    if (mTask)
+        mTask->runOrWait();
+    drawable->drawImplementation(renderInfo);
+}
+
 void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
 {
     for (unsigned int i=0; i<2; ++i)
@@ -83,6 +130,8 @@ void RigGeometry::setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeometry)
         to.setCullingActive(false); // make sure to disable culling since that's handled by this class
         to.setComputeBoundingBoxCallback(new CopyBoundingBoxCallback());
         to.setComputeBoundingSphereCallback(new CopyBoundingSphereCallback());
+        if (mTaskScheduler)
+            to.setDrawCallback(new SkinningDrawCallback);
 
         // vertices and normals are modified every frame, so we need to deep copy them.
         // assign a dedicated VBO to make sure that modifications don't interfere with source geometry's VBO.
@@ -151,37 +200,15 @@ bool RigGeometry::initFromParentSkeleton(osg::NodeVisitor* nv)
     }
 
     mBoneNodesVector.clear();
-    for (auto& bonePair : mBoneSphereVector->mData)
+    mBoneNodesVector.reserve(mSkinningData->mBoneNames.size());
+    for (const std::string& boneName : mSkinningData->mBoneNames)
     {
-        const std::string& boneName = bonePair.first;
         Bone* bone = mSkeleton->getBone(boneName);
         if (!bone)
-        {
-            mBoneNodesVector.push_back(nullptr);
             Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-            continue;
-        }
-
         mBoneNodesVector.push_back(bone);
     }
 
-    for (auto& pair : mBone2VertexVector->mData)
-    {
-        for (auto &weight : pair.first)
-        {
-            const std::string& boneName = weight.first.first;
-            Bone* bone = mSkeleton->getBone(boneName);
-            if (!bone)
-            {
-                mBoneNodesVector.push_back(nullptr);
-                Log(Debug::Error) << "Error: RigGeometry did not find bone " << boneName;
-                continue;
-            }
-
-            mBoneNodesVector.push_back(bone);
-        }
-    }
-
     return true;
 }
 
@@ -196,7 +223,8 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     }
 
     unsigned int traversalNumber = nv->getTraversalNumber();
-    if (mLastFrameNumber == traversalNumber || (mLastFrameNumber != 0 && !mSkeleton->getActive()))
+    if (mLastFrameNumber == traversalNumber
+        || (mLastFrameNumber != 0 && (!mSkeleton->getActive() || !mSkeleton->getBonesChangedSince(mLastFrameNumber))))
     {
         osg::Geometry& geom = *getGeometry(mLastFrameNumber);
         nv->pushOntoNodePath(&geom);
@@ -209,7 +237,43 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
 
     mSkeleton->updateBoneMatrices(traversalNumber);
 
-    // skinning
+    // the previous skinning task may still read the matrices
+    waitForSkinning();
+    updateSkinningMatrices();
+
+    if (mTaskScheduler)
+    {
+        mSkinningTask = mTaskScheduler->submit([this, target = &geom] { skin(*target); }, Misc::TaskPriority::High);
+        static_cast<SkinningDrawCallback*>(geom.getDrawCallback())->mTask = mSkinningTask;
+    }
+    else
+        skin(geom);
+
+    nv->pushOntoNodePath(&geom);
+    nv->apply(geom);
+    nv->popFromNodePath();
+}
+
+void RigGeometry::updateSkinningMatrices()
+{
+    const SkinningData& data = *mSkinningData;
+    mSkinningMatrices.resize(data.mBoneNames.size());
+    for (std::size_t i = 0; i < mSkinningMatrices.size(); ++i)
+    {
+        // missing bones don't affect vertices
+        if (Bone* bone = mBoneNodesVector[i])
+            mSkinningMatrices[i] = toSkinningMatrix(data.mInvBindMatrices[i] * bone->mMatrixInSkeletonSpace);
+        else
+            mSkinningMatrices[i].fill(0.f);
+    }
+
+    mHasGeomToSkel = mGeomToSkelMatrix != nullptr;
+    if (mHasGeomToSkel)
+        mGeomToSkel = toSkinningMatrix(*mGeomToSkelMatrix);
+}
+
+void RigGeometry::skin(osg::Geometry& geom) const
+{
     const osg::Vec3Array* positionSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getVertexArray());
     const osg::Vec3Array* normalSrc = static_cast<osg::Vec3Array*>(mSourceGeometry->getNormalArray());
     const osg::Vec4Array* tangentSrc = mSourceTangents;
@@ -218,38 +282,30 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
     osg::Vec3Array* normalDst = static_cast<osg::Vec3Array*>(geom.getNormalArray());
     osg::Vec4Array* tangentDst = static_cast<osg::Vec4Array*>(geom.getTexCoordArray(7));
 
-    int index = mBoneSphereVector->mData.size();
-    for (auto &pair : mBone2VertexVector->mData)
+    const SkinningData& data = *mSkinningData;
+    std::size_t weight = 0;
+    std::size_t vertex = 0;
+    for (const InfluenceGroup& group : data.mGroups)
     {
-        osg::Matrixf resultMat (0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 0,
-                                0, 0, 0, 1);
+        SkinningMatrix resultMat {};
+        for (; weight < group.mWeightsEnd; ++weight)
+            accumulateMatrix(mSkinningMatrices[data.mWeights[weight].mBone], data.mWeights[weight].mWeight, resultMat);
 
-        for (auto &weight : pair.first)
-        {
-            Bone* bone = mBoneNodesVector[index];
-            if (bone == nullptr)
-                continue;
-
-            accumulateMatrix(weight.first.second, bone->mMatrixInSkeletonSpace, weight.second, resultMat);
-            index++;
-        }
+        if (mHasGeomToSkel)
+            resultMat = multiply(resultMat, mGeomToSkel);
 
-        if (mGeomToSkelMatrix)
-            resultMat *= (*mGeomToSkelMatrix);
-
-        for (auto &vertex : pair.second)
+        for (; vertex < group.mVerticesEnd; ++vertex)
         {
-            (*positionDst)[vertex] = resultMat.preMult((*positionSrc)[vertex]);
+            const unsigned short index = data.mVertices[vertex];
+            (*positionDst)[index] = transformPoint((*positionSrc)[index], resultMat);
             if (normalDst)
-                (*normalDst)[vertex] = osg::Matrixf::transform3x3((*normalSrc)[vertex], resultMat);
+                (*normalDst)[index] = transformVector((*normalSrc)[index], resultMat);
 
             if (tangentDst)
             {
-                const osg::Vec4f& srcTangent = (*tangentSrc)[vertex];
-                osg::Vec3f transformedTangent = osg::Matrixf::transform3x3(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
-                (*tangentDst)[vertex] = osg::Vec4f(transformedTangent, srcTangent.w());
+                const osg::Vec4f& srcTangent = (*tangentSrc)[index];
+                osg::Vec3f transformedTangent = transformVector(osg::Vec3f(srcTangent.x(), srcTangent.y(), srcTangent.z()), resultMat);
+                (*tangentDst)[index] = osg::Vec4f(transformedTangent, srcTangent.w());
             }
         }
     }
@@ -263,10 +319,12 @@ void RigGeometry::cull(osg::NodeVisitor* nv)
 #if OSG_MIN_VERSION_REQUIRED(3, 5, 10)
     geom.osg::Drawable::dirtyGLObjects();
 #endif
+}
 
-    nv->pushOntoNodePath(&geom);
-    nv->apply(geom);
-    nv->popFromNodePath();
+void RigGeometry::waitForSkinning() const
+{
+    if (mSkinningTask)
+        mSkinningTask->runOrWait();
 }
 
 void RigGeometry::updateBounds(osg::NodeVisitor *nv)
@@ -287,15 +345,13 @@ void RigGeometry::updateBounds(osg::NodeVisitor *nv)
 
     osg::BoundingBox box;
 
-    int index = 0;
-    for (auto& boundPair : mBoneSphereVector->mData)
+    for (std::size_t i = 0; i < mBoneNodesVector.size(); ++i)
     {
-        Bone* bone = mBoneNodesVector[index];
+        Bone* bone = mBoneNodesVector[i];
         if (bone == nullptr)
             continue;
 
-        index++;
-        osg::BoundingSpheref bs = boundPair.second;
+        osg::BoundingSpheref bs = mSkinningData->mBoundSpheres[i];
         if (mGeomToSkelMatrix)
             transformBoundingSphere(bone->mMatrixInSkeletonSpace * (*mGeomToSkelMatrix), bs);
         else
@@ -354,33 +410,42 @@ void RigGeometry::setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap)
 {
     mInfluenceMap = influenceMap;
 
-    typedef std::map<unsigned short, std::vector<BoneWeight> > Vertex2BoneMap;
+    typedef std::vector<std::pair<std::size_t, float>> BoneWeights;
+    typedef std::map<unsigned short, BoneWeights> Vertex2BoneMap;
     Vertex2BoneMap vertex2BoneMap;
-    mBoneSphereVector = new BoneSphereVector;
-    mBoneSphereVector->mData.reserve(mInfluenceMap->mData.size());
-    mBone2VertexVector = new Bone2VertexVector;
+    mSkinningData = new SkinningData;
+    SkinningData& data = *mSkinningData;
+    data.mBoneNames.reserve(mInfluenceMap->mData.size());
+    data.mInvBindMatrices.reserve(mInfluenceMap->mData.size());
+    data.mBoundSpheres.reserve(mInfluenceMap->mData.size());
     for (auto& influencePair : mInfluenceMap->mData)
     {
-        const std::string& boneName = influencePair.first;
+        const std::size_t boneIndex = data.mBoneNames.size();
         const BoneInfluence& bi = influencePair.second;
-        mBoneSphereVector->mData.emplace_back(boneName, bi.mBoundSphere);
+        data.mBoneNames.push_back(influencePair.first);
+        data.mInvBindMatrices.push_back(bi.mInvBindMatrix);
+        data.mBoundSpheres.push_back(bi.mBoundSphere);
 
         for (auto& weightPair: bi.mWeights)
-        {
-            std::vector<BoneWeight>& vec = vertex2BoneMap[weightPair.first];
-
-            vec.emplace_back(std::make_pair(boneName, bi.mInvBindMatrix), weightPair.second);
-        }
+            vertex2BoneMap[weightPair.first].emplace_back(boneIndex, weightPair.second);
     }
 
+    typedef std::map<BoneWeights, std::vector<unsigned short>> Bone2VertexMap;
     Bone2VertexMap bone2VertexMap;
     for (auto& vertexPair : vertex2BoneMap)
     {
         bone2VertexMap[vertexPair.second].emplace_back(vertexPair.first);
     }
 
-    mBone2VertexVector->mData.reserve(bone2VertexMap.size());
-    mBone2VertexVector->mData.assign(bone2VertexMap.begin(), bone2VertexMap.end());
+    data.mGroups.reserve(bone2VertexMap.size());
+    data.mVertices.reserve(vertex2BoneMap.size());
+    for (auto& groupPair : bone2VertexMap)
+    {
+        for (auto& weight : groupPair.first)
+            data.mWeights.push_back(BoneWeight {weight.first, weight.second});
+        data.mVertices.insert(data.mVertices.end(), groupPair.second.begin(), groupPair.second.end());
+        data.mGroups.push_back(InfluenceGroup {data.mWeights.size(), data.mVertices.size()});
+    }
 }
 
 void RigGeometry::accept(osg::NodeVisitor &nv)
@@ -402,6 +467,7 @@ void RigGeometry::accept(osg::NodeVisitor &nv)
 
 void RigGeometry::accept(osg::PrimitiveFunctor& func) const
 {
+    waitForSkinning();
     getGeometry(mLastFrameNumber)->accept(func);
 }
 
@@ -4,6 +4,10 @@
 #include <osg/Geometry>
 #include <osg/Matrixf>
 
+#include <components/misc/taskscheduler.hpp>
+
+#include <array>
+
 namespace SceneUtil
 {
     class Skeleton;
@@ -21,6 +25,9 @@ namespace SceneUtil
     /// Note though that the RigGeometry ignores any transforms below the Skeleton, so the attachment point is not that important.
     /// @note The internal Geometry used for rendering is double buffered, this allows updates to be done in a thread safe way while
     /// not compromising rendering performance. This is crucial when using osg's default threading model of DrawThreadPerContext.
+    /// @note When a task scheduler is set, skinning is done by the scheduler threads. The cull traversal only collects bone
+    /// matrices and starts the task. The draw of the internal Geometry waits for it or skins itself if the task has not
+    /// started yet, so rendering doesn't wait for scheduler threads busy with other work.
     class RigGeometry : public osg::Drawable
     {
     public:
@@ -47,6 +54,11 @@ namespace SceneUtil
 
         void setInfluenceMap(osg::ref_ptr<InfluenceMap> influenceMap);
 
+        /// Skin RigGeometries created after this call on the given scheduler instead of the cull thread.
+        /// Pass nullptr to skin on the cull thread. RigGeometries don't own the scheduler: it has to be stopped
+        /// before they are destroyed and it has to outlive them.
+        static void setTaskScheduler(Misc::TaskScheduler* scheduler);
+
         /// Initialize this geometry from the source geometry.
         /// @note The source geometry will not be modified.
         void setSourceGeometry(osg::ref_ptr<osg::Geometry> sourceGeom);
@@ -71,10 +83,53 @@ namespace SceneUtil
             osg::BoundingSphere computeBound(const osg::Node&) const override { return boundingSphere; }
         };
 
+    protected:
+        ~RigGeometry() override;
+
     private:
+        // Affine transform with rows of 3x3 part followed by translation, the layout of osg::Matrixf without the
+        // projective column.
+        using SkinningMatrix = std::array<float, 12>;
+
+        struct BoneWeight
+        {
+            // Index of the bone in the InfluenceMap.
+            std::size_t mBone;
+            float mWeight;
+        };
+
+        // Vertices influenced by the same set of bones with the same weights.
+        struct InfluenceGroup
+        {
+            std::size_t mWeightsEnd;
+            std::size_t mVerticesEnd;
+        };
+
+        // Influences flattened into contiguous arrays, shared between clones.
+        struct SkinningData : public osg::Referenced
+        {
+            std::vector<std::string> mBoneNames;
+            std::vector<osg::Matrixf> mInvBindMatrices;
+            std::vector<osg::BoundingSpheref> mBoundSpheres;
+            std::vector<BoneWeight> mWeights;
+            std::vector<unsigned short> mVertices;
+            std::vector<InfluenceGroup> mGroups;
+        };
+
+        struct SkinningDrawCallback : public osg::Drawable::DrawCallback
+        {
+            Misc::TaskScheduler::TaskPtr mTask;
+
+            void drawImplementation(osg::RenderInfo& renderInfo, const osg::Drawable* drawable) const override;
+        };
+
         void cull(osg::NodeVisitor* nv);
         void updateBounds(osg::NodeVisitor* nv);
 
+        void updateSkinningMatrices();
+        void skin(osg::Geometry& geom) const;
+        void waitForSkinning() const;
+
         osg::ref_ptr<osg::Geometry> mGeometry[2];
         osg::Geometry* getGeometry(unsigned int frame) const;
 
@@ -86,26 +141,16 @@ namespace SceneUtil
 
         osg::ref_ptr<InfluenceMap> mInfluenceMap;
 
-        typedef std::pair<std::string, osg::Matrixf> BoneBindMatrixPair;
-
-        typedef std::pair<BoneBindMatrixPair, float> BoneWeight;
-
-        typedef std::vector<unsigned short> VertexList;
-
-        typedef std::map<std::vector<BoneWeight>, VertexList> Bone2VertexMap;
+        osg::ref_ptr<SkinningData> mSkinningData;
+        std::vector<Bone*> mBoneNodesVector;
 
-        struct Bone2VertexVector : public osg::Referenced
-        {
-            std::vector<std::pair<std::vector<BoneWeight>, VertexList>> mData;
-        };
-        osg::ref_ptr<Bone2VertexVector> mBone2VertexVector;
+        // Per bone inverse bind matrix multiplied by the bone matrix, updated in the cull traversal.
+        std::vector<SkinningMatrix> mSkinningMatrices;
+        SkinningMatrix mGeomToSkel;
+        bool mHasGeomToSkel;
 
-        struct BoneSphereVector : public osg::Referenced
-        {
-            std::vector<std::pair<std::string, osg::BoundingSpheref>> mData;
-        };
-        osg::ref_ptr<BoneSphereVector> mBoneSphereVector;
-        std::vector<Bone*> mBoneNodesVector;
+        Misc::TaskScheduler* mTaskScheduler;
+        Misc::TaskScheduler::TaskPtr mSkinningTask;
 
         unsigned int mLastFrameNumber;
         bool mBoundsFirstFrame;
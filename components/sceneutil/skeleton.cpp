@@ -5,6 +5,8 @@
 #include <components/debug/debuglog.hpp>
 #include <components/misc/stringops.hpp>
 
+#include <algorithm>
+
 namespace SceneUtil
 {
 
@@ -37,6 +39,8 @@ Skeleton::Skeleton()
     , mActive(Active)
     , mLastFrameNumber(0)
     , mLastCullFrameNumber(0)
+    , mUpdateInterval(1)
+    , mLastUpdateFrameNumber(0)
 {
 
 }
@@ -48,6 +52,8 @@ Skeleton::Skeleton(const Skeleton &copy, const osg::CopyOp &copyop)
     , mActive(copy.mActive)
     , mLastFrameNumber(0)
     , mLastCullFrameNumber(0)
+    , mUpdateInterval(1)
+    , mLastUpdateFrameNumber(0)
 {
 
 }
@@ -128,6 +134,16 @@ bool Skeleton::getActive() const
     return mActive != Inactive;
 }
 
+void Skeleton::setUpdateInterval(unsigned int interval)
+{
+    mUpdateInterval = std::max(interval, 1u);
+}
+
+bool Skeleton::getBonesChangedSince(unsigned int traversalNumber) const
+{
+    return mUpdateInterval == 1 || mLastUpdateFrameNumber > traversalNumber;
+}
+
 void Skeleton::markDirty()
 {
     mLastFrameNumber = 0;
@@ -143,6 +159,9 @@ void Skeleton::traverse(osg::NodeVisitor& nv)
             return;
         if (mActive == SemiActive && mLastFrameNumber != 0 && mLastCullFrameNumber+3 <= nv.getTraversalNumber())
             return;
+        if (mUpdateInterval > 1 && mLastFrameNumber != 0 && nv.getTraversalNumber() < mLastUpdateFrameNumber + mUpdateInterval)
+            return;
+        mLastUpdateFrameNumber = nv.getTraversalNumber();
     }
     else if (nv.getVisitorType() == osg::NodeVisitor::CULL_VISITOR)
         mLastCullFrameNumber = nv.getTraversalNumber();
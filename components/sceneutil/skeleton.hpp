@@ -61,6 +61,14 @@ namespace SceneUtil
 
         bool getActive() const;
 
+        /// Update bones only every \a interval frames, so distant actors animate at a reduced rate.
+        /// Bones keep the last updated pose between updates.
+        void setUpdateInterval(unsigned int interval);
+
+        /// Returns false if bones were not updated after the frame \a traversalNumber because of the update interval,
+        /// so skinning results of that frame can be reused.
+        bool getBonesChangedSince(unsigned int traversalNumber) const;
+
         void traverse(osg::NodeVisitor& nv) override;
 
         void markDirty();
@@ -83,6 +91,9 @@ namespace SceneUtil
 
         unsigned int mLastFrameNumber;
         unsigned int mLastCullFrameNumber;
+
+        unsigned int mUpdateInterval;
+        unsigned int mLastUpdateFrameNumber;
     };
 
 }
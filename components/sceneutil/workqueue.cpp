@@ -1,6 +1,8 @@
 #include "workqueue.hpp"
 
 #include <components/debug/debuglog.hpp>
+#include <components/debug/tracerecorder.hpp>
+#include <components/misc/taskscheduler.hpp>
 
 #include <numeric>
 
@@ -39,6 +41,12 @@ WorkQueue::WorkQueue(std::size_t workerThreads)
     start(workerThreads);
 }
 
+WorkQueue::WorkQueue(std::shared_ptr<Misc::TaskScheduler> scheduler)
+    : mIsReleased(false)
+    , mScheduler(std::move(scheduler))
+{
+}
+
 WorkQueue::~WorkQueue()
 {
     stop();
@@ -50,6 +58,8 @@ void WorkQueue::start(std::size_t workerThreads)
         const std::lock_guard lock(mMutex);
         mIsReleased = false;
     }
+    if (mScheduler != nullptr)
+        return;
     while (mThreads.size() < workerThreads)
         mThreads.emplace_back(std::make_unique<WorkThread>(*this));
 }
@@ -65,6 +75,9 @@ void WorkQueue::stop()
     }
 
     mThreads.clear();
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mCondition.wait(lock, [&] { return mActiveItems == 0; });
 }
 
 void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
@@ -75,12 +88,44 @@ void WorkQueue::addWorkItem(osg::ref_ptr<WorkItem> item, bool front)
         return;
     }
 
-    std::unique_lock<std::mutex> lock(mMutex);
-    if (front)
-        mQueue.push_front(std::move(item));
-    else
-        mQueue.push_back(std::move(item));
-    mCondition.notify_one();
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (front)
+            mQueue.push_front(std::move(item));
+        else
+            mQueue.push_back(std::move(item));
+        mCondition.notify_one();
+    }
+
+    if (mScheduler != nullptr)
+    {
+        // The task takes the first item of the queue rather than this one to keep the order of items.
+        mScheduler->submit([queue = osg::ref_ptr<WorkQueue>(this)] { queue->processNextItem(); },
+            front ? Misc::TaskPriority::High : Misc::TaskPriority::Normal);
+    }
+}
+
+void WorkQueue::processNextItem()
+{
+    osg::ref_ptr<WorkItem> item;
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        if (mQueue.empty())
+            return;
+        item = std::move(mQueue.front());
+        mQueue.pop_front();
+        ++mActiveItems;
+    }
+    {
+        const Debug::TraceZone zone("WorkQueue", "WorkItem");
+        item->doWork();
+    }
+    item->signalDone();
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        --mActiveItems;
+    }
+    mCondition.notify_all();
 }
 
 osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
@@ -107,6 +152,8 @@ unsigned int WorkQueue::getNumItems() const
 
 unsigned int WorkQueue::getNumActiveThreads() const
 {
+    if (mScheduler != nullptr)
+        return mActiveItems;
     return std::accumulate(mThreads.begin(), mThreads.end(), 0u,
         [] (auto r, const auto& t) { return r + t->isActive(); });
 }
@@ -125,13 +172,17 @@ WorkThread::~WorkThread()
 
 void WorkThread::run()
 {
+    Debug::TraceRecorder::instance().setThreadName("WorkQueue");
     while (true)
     {
         osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
         if (!item)
             return;
         mActive = true;
-        item->doWork();
+        {
+            const Debug::TraceZone zone("WorkQueue", "WorkItem");
+            item->doWork();
+        }
         item->signalDone();
         mActive = false;
     }
@@ -5,11 +5,17 @@
 #include <osg/ref_ptr>
 
 #include <atomic>
+#include <memory>
 #include <queue>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 
+namespace Misc
+{
+    class TaskScheduler;
+}
+
 namespace SceneUtil
 {
 
@@ -45,6 +51,11 @@ namespace SceneUtil
     {
     public:
         WorkQueue(std::size_t workerThreads);
+
+        /// Doesn't create own threads, every work item is processed by a task of the shared scheduler.
+        /// Items added to the front of the queue use high priority tasks.
+        WorkQueue(std::shared_ptr<Misc::TaskScheduler> scheduler);
+
         ~WorkQueue();
 
         void start(std::size_t workerThreads);
@@ -65,7 +76,12 @@ namespace SceneUtil
 
         unsigned int getNumActiveThreads() const;
 
+        /// The shared scheduler used to process work items, nullptr if the queue has own threads.
+        const std::shared_ptr<Misc::TaskScheduler>& getTaskScheduler() const { return mScheduler; }
+
     private:
+        void processNextItem();
+
         bool mIsReleased;
         std::deque<osg::ref_ptr<WorkItem> > mQueue;
 
@@ -73,6 +89,9 @@ namespace SceneUtil
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        std::shared_ptr<Misc::TaskScheduler> mScheduler;
+        std::atomic<unsigned int> mActiveItems {0};
     };
 
     /// Internally used by WorkQueue.